@@ -0,0 +1,51 @@
+###############################################################################
+# Benchmark
+###############################################################################
+# custom targets to run the benchmark matrix in tools/benchmark and compare
+# the timings against a stored baseline to detect performance regressions
+find_package(Python3 COMPONENTS Interpreter)
+
+if(Python3_EXECUTABLE)
+  if(Python3_VERSION VERSION_GREATER_EQUAL 3.6)
+    set(BENCHMARK_RANKS "" CACHE STRING "List of MPI rank counts for benchmarks (default: from benchmarks.yaml)")
+    set(BENCHMARK_THREADS "" CACHE STRING "List of OpenMP thread counts for benchmarks (default: from benchmarks.yaml)")
+    set(BENCHMARK_REPEAT 1 CACHE STRING "Number of times each benchmark is run, the fastest run is kept")
+    set(BENCHMARK_THRESHOLD 0.10 CACHE STRING "Max allowed relative increase of the loop time of a benchmark")
+    set(BENCHMARK_BASELINE ${CMAKE_BINARY_DIR}/benchmark-baseline.json CACHE FILEPATH "JSON file with benchmark baseline")
+    set(BENCHMARK_MPIEXEC_FLAGS "" CACHE STRING "Extra flags for the MPI launcher when running benchmarks")
+    mark_as_advanced(BENCHMARK_RANKS BENCHMARK_THREADS BENCHMARK_REPEAT BENCHMARK_THRESHOLD
+      BENCHMARK_BASELINE BENCHMARK_MPIEXEC_FLAGS)
+
+    set(BENCHMARK_ARGS --lmp $<TARGET_FILE:lmp> --workdir ${CMAKE_BINARY_DIR}/benchmark
+      --repeat ${BENCHMARK_REPEAT} --threshold ${BENCHMARK_THRESHOLD} --baseline ${BENCHMARK_BASELINE})
+    if(BENCHMARK_RANKS)
+      list(APPEND BENCHMARK_ARGS --ranks ${BENCHMARK_RANKS})
+    endif()
+    if(BENCHMARK_THREADS)
+      list(APPEND BENCHMARK_ARGS --threads ${BENCHMARK_THREADS})
+    endif()
+    if(BUILD_MPI AND MPIEXEC_EXECUTABLE)
+      list(APPEND BENCHMARK_ARGS --mpiexec ${MPIEXEC_EXECUTABLE} --mpiexec-numproc-flag=${MPIEXEC_NUMPROC_FLAG})
+      if(BENCHMARK_MPIEXEC_FLAGS OR MPIEXEC_PREFLAGS)
+        list(APPEND BENCHMARK_ARGS "--mpiexec-flags=${MPIEXEC_PREFLAGS} ${BENCHMARK_MPIEXEC_FLAGS}")
+      endif()
+    elseif(NOT BENCHMARK_RANKS)
+      list(APPEND BENCHMARK_ARGS --ranks 1)
+    endif()
+
+    add_custom_target(
+      benchmark
+      ${Python3_EXECUTABLE} ${LAMMPS_TOOLS_DIR}/benchmark/benchmark.py ${BENCHMARK_ARGS}
+      WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+      DEPENDS lmp
+      COMMENT "Running benchmarks and comparing against baseline"
+      USES_TERMINAL)
+    add_custom_target(
+      benchmark-baseline
+      ${Python3_EXECUTABLE} ${LAMMPS_TOOLS_DIR}/benchmark/benchmark.py ${BENCHMARK_ARGS} --save-baseline
+      WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+      DEPENDS lmp
+      COMMENT "Running benchmarks and storing results as baseline"
+      USES_TERMINAL)
+  endif()
+endif()
@@ -60,6 +60,8 @@ DumpAtomADIOS::DumpAtomADIOS(LAMMPS *lmp, int narg, char **arg) : DumpAtom(lmp,
   }
   if (cfgfp) fclose(cfgfp);
 
+  async_allow = 0;
+
   internal = new DumpAtomADIOSInternal();
   try {
 #if defined(MPI_STUBS)
@@ -68,6 +68,8 @@ DumpCustomADIOS::DumpCustomADIOS(LAMMPS *lmp, int narg, char **arg) : DumpCustom
   }
   if (cfgfp) fclose(cfgfp);
 
+  async_allow = 0;
+
   internal = new DumpCustomADIOSInternal();
   try {
 #if defined(MPI_STUBS)
@@ -25,6 +25,7 @@ using namespace LAMMPS_NS;
 DumpAtomGZ::DumpAtomGZ(LAMMPS *lmp, int narg, char **arg) : DumpAtom(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump atom/gz only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -31,6 +31,7 @@ using namespace LAMMPS_NS;
 DumpAtomZstd::DumpAtomZstd(LAMMPS *lmp, int narg, char **arg) : DumpAtom(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump atom/zstd only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
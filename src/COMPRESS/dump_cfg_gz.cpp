@@ -27,6 +27,7 @@ static constexpr double UNWRAPEXPAND = 10.0;
 DumpCFGGZ::DumpCFGGZ(LAMMPS *lmp, int narg, char **arg) : DumpCFG(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump cfg/gz only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -33,6 +33,7 @@ static constexpr double UNWRAPEXPAND = 10.0;
 DumpCFGZstd::DumpCFGZstd(LAMMPS *lmp, int narg, char **arg) : DumpCFG(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump cfg/zstd only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -35,6 +35,7 @@ DumpCustomZstd::DumpCustomZstd(LAMMPS *lmp, int narg, char **arg) :
 {
   if (!compressed)
     error->all(FLERR,"Dump custom/zstd only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
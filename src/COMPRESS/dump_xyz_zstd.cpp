@@ -30,6 +30,7 @@ using namespace LAMMPS_NS;
 DumpXYZZstd::DumpXYZZstd(LAMMPS *lmp, int narg, char **arg) : DumpXYZ(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump xyz/zstd only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
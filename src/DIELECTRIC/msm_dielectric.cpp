@@ -35,6 +35,7 @@ enum{FORWARD_RHO,FORWARD_AD,FORWARD_AD_PERATOM};
 
 MSMDielectric::MSMDielectric(LAMMPS *_lmp) : MSM(_lmp)
 {
+  every_allow = 0;
   efield = nullptr;
   phi = nullptr;
 }
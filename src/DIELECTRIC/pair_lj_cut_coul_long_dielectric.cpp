@@ -41,6 +41,9 @@ static constexpr double EPSILON = 1.0e-6;
 PairLJCutCoulLongDielectric::PairLJCutCoulLongDielectric(LAMMPS *_lmp) : PairLJCutCoulLong(_lmp)
 {
   respa_enable = 0;
+  cluster_enable = 0;
+  overlap_enable = 0;
+  precision_enable = 0;
   cut_respa = nullptr;
   efield = nullptr;
   epot = nullptr;
@@ -47,6 +47,7 @@ static constexpr FFT_SCALAR ZEROF = 0.0;
 PPPMDielectric::PPPMDielectric(LAMMPS *_lmp) : PPPM(_lmp)
 {
   group_group_enable = 0;
+  every_allow = 0;
 
   efield = nullptr;
   phi = nullptr;
@@ -53,6 +53,7 @@ PPPMDispDielectric::PPPMDispDielectric(LAMMPS *_lmp) : PPPMDisp(_lmp)
 {
   dipoleflag = 0; // turned off for now, until dipole works
   group_group_enable = 0;
+  every_allow = 0;
 
   mu_flag = 0;
   use_qscaled = true;
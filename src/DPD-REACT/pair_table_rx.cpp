@@ -46,6 +46,7 @@ enum{NONE,RLINEAR,RSQ,BMP};
 
 PairTableRX::PairTableRX(LAMMPS *lmp) : PairTable(lmp)
 {
+  precision_enable = 0;
   fractionalWeighting = true;
   site1 = nullptr;
   site2 = nullptr;
@@ -55,6 +55,8 @@ double buck_gpu_bytes();
 PairBuckGPU::PairBuckGPU(LAMMPS *lmp) : PairBuck(lmp), gpu_mode(GPU_FORCE)
 {
   respa_enable = 0;
+  cluster_enable = 0;
+  overlap_enable = 0;
   cpu_time = 0.0;
   suffix_flag |= Suffix::GPU;
   GPU_EXTRA::gpu_ready(lmp->modify, lmp->error);
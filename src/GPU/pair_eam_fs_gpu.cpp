@@ -65,6 +65,7 @@ PairEAMFSGPU::PairEAMFSGPU(LAMMPS *lmp) : PairEAM(lmp), gpu_mode(GPU_FORCE)
 {
   one_coeff = 1;
   respa_enable = 0;
+  precision_enable = 0;
   reinitflag = 0;
   cpu_time = 0.0;
   suffix_flag |= Suffix::GPU;
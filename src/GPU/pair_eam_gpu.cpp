@@ -59,6 +59,7 @@ double eam_gpu_bytes();
 PairEAMGPU::PairEAMGPU(LAMMPS *lmp) : PairEAM(lmp), gpu_mode(GPU_FORCE)
 {
   respa_enable = 0;
+  precision_enable = 0;
   reinitflag = 0;
   cpu_time = 0.0;
   suffix_flag |= Suffix::GPU;
@@ -57,6 +57,9 @@ double ljl_gpu_bytes();
 PairLJCutGPU::PairLJCutGPU(LAMMPS *lmp) : PairLJCut(lmp), gpu_mode(GPU_FORCE)
 {
   respa_enable = 0;
+  cluster_enable = 0;
+  overlap_enable = 0;
+  precision_enable = 0;
   cpu_time = 0.0;
   suffix_flag |= Suffix::GPU;
   GPU_EXTRA::gpu_ready(lmp->modify, lmp->error);
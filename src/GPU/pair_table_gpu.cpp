@@ -54,6 +54,7 @@ double table_gpu_bytes();
 PairTableGPU::PairTableGPU(LAMMPS *lmp) : PairTable(lmp), gpu_mode(GPU_FORCE)
 {
   respa_enable = 0;
+  precision_enable = 0;
   reinitflag = 0;
   cpu_time = 0.0;
   suffix_flag |= Suffix::GPU;
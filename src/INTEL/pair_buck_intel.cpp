@@ -41,6 +41,8 @@ using namespace MathConst;
 
 PairBuckIntel::PairBuckIntel(LAMMPS *lmp) : PairBuck(lmp)
 {
+  cluster_enable = 0;
+  overlap_enable = 0;
   suffix_flag |= Suffix::INTEL;
 }
 
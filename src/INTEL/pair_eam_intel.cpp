@@ -42,6 +42,7 @@ using namespace LAMMPS_NS;
 PairEAMIntel::PairEAMIntel(LAMMPS *lmp) : PairEAM(lmp)
 {
   suffix_flag |= Suffix::INTEL;
+  precision_enable = 0;
   fp_float = nullptr;
 }
 
@@ -43,6 +43,9 @@ PairLJCutCoulLongIntel::PairLJCutCoulLongIntel(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::INTEL;
   respa_enable = 0;
+  cluster_enable = 0;
+  overlap_enable = 0;
+  precision_enable = 0;
   cut_respa = nullptr;
 }
 
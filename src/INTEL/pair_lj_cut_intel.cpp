@@ -40,6 +40,9 @@ PairLJCutIntel::PairLJCutIntel(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::INTEL;
   respa_enable = 0;
+  cluster_enable = 0;
+  overlap_enable = 0;
+  precision_enable = 0;
   cut_respa = nullptr;
 }
 
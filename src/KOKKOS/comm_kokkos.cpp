@@ -160,6 +160,7 @@ void CommKokkos::init()
 
 void CommKokkos::forward_comm(int dummy)
 {
+  atom->soa_current = 0;
   if (!forward_comm_classic) {
     if (forward_comm_on_host) forward_comm_device<LMPHostType>();
     else forward_comm_device<LMPDeviceType>();
@@ -1052,6 +1053,7 @@ void CommKokkos::exchange_device()
 
 void CommKokkos::borders()
 {
+  atom->soa_current = 0;
   if (!exchange_comm_classic) {
 
     if (atom->nextra_border || mode != Comm::SINGLE || bordergroup ||
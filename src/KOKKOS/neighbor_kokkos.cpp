@@ -310,6 +310,7 @@ void NeighborKokkos::build_kokkos(int topoflag)
       lists[m]->grow(nlocal,nall);
     neigh_pair[m]->build_setup();
     neigh_pair[m]->build(lists[m]);
+    lists[m]->stamp = ++nstamp;
   }
 
   // build topology lists for bonds/angles/etc
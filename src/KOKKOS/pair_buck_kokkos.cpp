@@ -39,6 +39,8 @@ template<class DeviceType>
 PairBuckKokkos<DeviceType>::PairBuckKokkos(LAMMPS *lmp) : PairBuck(lmp)
 {
   respa_enable = 0;
+  cluster_enable = 0;
+  overlap_enable = 0;
 
   kokkosable = 1;
   atomKK = (AtomKokkos *) atom;
@@ -42,6 +42,7 @@ PairEAMKokkos<DeviceType>::PairEAMKokkos(LAMMPS *lmp) : PairEAM(lmp)
 {
   respa_enable = 0;
   single_enable = 0;
+  precision_enable = 0;
 
   kokkosable = 1;
   atomKK = (AtomKokkos *) atom;
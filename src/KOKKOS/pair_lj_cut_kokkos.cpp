@@ -33,6 +33,9 @@ template<class DeviceType>
 PairLJCutKokkos<DeviceType>::PairLJCutKokkos(LAMMPS *lmp) : PairLJCut(lmp)
 {
   respa_enable = 0;
+  cluster_enable = 0;
+  overlap_enable = 0;
+  precision_enable = 0;
 
   kokkosable = 1;
   atomKK = (AtomKokkos *) atom;
@@ -43,6 +43,7 @@ EwaldDipoleSpin::EwaldDipoleSpin(LAMMPS *lmp) :
 {
   dipoleflag = 0;
   spinflag = 1;
+  every_allow = 0;
 
   hbar = force->hplanck/MY_2PI;                 // eV/(rad.THz)
   mub = 9.274e-4;                               // in A.Ang^2
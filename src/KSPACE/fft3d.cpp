@@ -58,6 +58,84 @@
      with a fast-varying, mid-varying, and slow-varying index
 ------------------------------------------------------------------------- */
 
+/* ----------------------------------------------------------------------
+   Perform 1d FFTs along one axis of the data layout of a 3d FFT
+
+   Arguments:
+   data         starting address of data on this proc, transformed in place
+   axis         0 = fast axis, 1 = mid axis, 2 = slow axis
+   flag         1 for forward FFT, -1 for backward FFT
+   plan         plan returned by previous call to fft_3d_create_plan
+------------------------------------------------------------------------- */
+
+static void fft_1d_axis(FFT_DATA *data, int axis, int flag, struct fft_plan_3d *plan)
+{
+#if defined(FFT_MKL)
+  DFTI_DESCRIPTOR *handle;
+  if (axis == 0) handle = plan->handle_fast;
+  else if (axis == 1) handle = plan->handle_mid;
+  else handle = plan->handle_slow;
+
+  if (flag == 1)
+    DftiComputeForward(handle,data);
+  else
+    DftiComputeBackward(handle,data);
+#elif defined(FFT_FFTW3)
+  FFTW_API(plan) theplan;
+  if (axis == 0)
+    theplan = (flag == 1) ? plan->plan_fast_forward : plan->plan_fast_backward;
+  else if (axis == 1)
+    theplan = (flag == 1) ? plan->plan_mid_forward : plan->plan_mid_backward;
+  else
+    theplan = (flag == 1) ? plan->plan_slow_forward : plan->plan_slow_backward;
+  FFTW_API(execute_dft)(theplan,data,data);
+#else
+  int total,length;
+  kiss_fft_cfg cfg;
+  if (axis == 0) {
+    total = plan->total1;
+    length = plan->length1;
+    cfg = (flag == 1) ? plan->cfg_fast_forward : plan->cfg_fast_backward;
+  } else if (axis == 1) {
+    total = plan->total2;
+    length = plan->length2;
+    cfg = (flag == 1) ? plan->cfg_mid_forward : plan->cfg_mid_backward;
+  } else {
+    total = plan->total3;
+    length = plan->length3;
+    cfg = (flag == 1) ? plan->cfg_slow_forward : plan->cfg_slow_backward;
+  }
+
+  for (int offset = 0; offset < total; offset += length)
+    kiss_fft(cfg,&data[offset],&data[offset]);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   scale result of backward FFT
+------------------------------------------------------------------------- */
+
+static void fft_3d_scale(FFT_DATA *out, struct fft_plan_3d *plan)
+{
+  FFT_SCALAR norm = plan->norm;
+  const int num = plan->normnum;
+#if defined(FFT_FFTW3)
+  FFT_SCALAR *out_ptr = (FFT_SCALAR *)out;
+#endif
+  for (int i = 0; i < num; i++) {
+#if defined(FFT_FFTW3)
+    *(out_ptr++) *= norm;
+    *(out_ptr++) *= norm;
+#elif defined(FFT_MKL)
+    out[i].real *= norm;
+    out[i].imag *= norm;
+#else  /* FFT_KISS */
+    out[i].re *= norm;
+    out[i].im *= norm;
+#endif
+  }
+}
+
 /* ----------------------------------------------------------------------
    Perform 3d FFT
 
@@ -71,20 +149,8 @@
 
 void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 {
-  FFT_SCALAR norm;
-#if defined(FFT_FFTW3)
-  FFT_SCALAR *out_ptr;
-#endif
   FFT_DATA *data,*copy;
 
-  // system specific constants
-
-#if defined(FFT_FFTW3)
-  FFTW_API(plan) theplan;
-#else
-  // nothing to do for other FFTs
-#endif
-
   // pre-remap to prepare for 1st FFTs if needed
   // copy = loc for remap result
 
@@ -100,28 +166,7 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // 1d FFTs along fast axis
 
-#if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_fast,data);
-  else
-    DftiComputeBackward(plan->handle_fast,data);
-#elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_fast_forward;
-  else
-    theplan=plan->plan_fast_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-#else
-  int total = plan->total1;
-  int length = plan->length1;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_fast_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_fast_backward,&data[offset],&data[offset]);
-#endif
+  fft_1d_axis(data,0,flag,plan);
 
   // 1st mid-remap to prepare for 2nd FFTs
   // copy = loc for remap result
@@ -134,28 +179,7 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // 1d FFTs along mid axis
 
-#if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_mid,data);
-  else
-    DftiComputeBackward(plan->handle_mid,data);
-#elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_mid_forward;
-  else
-    theplan=plan->plan_mid_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-#else
-  total = plan->total2;
-  length = plan->length2;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_mid_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_mid_backward,&data[offset],&data[offset]);
-#endif
+  fft_1d_axis(data,1,flag,plan);
 
   // 2nd mid-remap to prepare for 3rd FFTs
   // copy = loc for remap result
@@ -168,28 +192,7 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // 1d FFTs along slow axis
 
-#if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_slow,data);
-  else
-    DftiComputeBackward(plan->handle_slow,data);
-#elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_slow_forward;
-  else
-    theplan=plan->plan_slow_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-#else
-  total = plan->total3;
-  length = plan->length3;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_slow_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_slow_backward,&data[offset],&data[offset]);
-#endif
+  fft_1d_axis(data,2,flag,plan);
 
   // post-remap to put data in output format if needed
   // destination is always out
@@ -200,25 +203,128 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // scaling if required
 
-  if (flag == -1 && plan->scaled) {
-    norm = plan->norm;
-    const int num = plan->normnum;
-#if defined(FFT_FFTW3)
-    out_ptr = (FFT_SCALAR *)out;
-#endif
-    for (int i = 0; i < num; i++) {
-#if defined(FFT_FFTW3)
-      *(out_ptr++) *= norm;
-      *(out_ptr++) *= norm;
-#elif defined(FFT_MKL)
-      out[i].real *= norm;
-      out[i].imag *= norm;
-#else  /* FFT_KISS */
-      out[i].re *= norm;
-      out[i].im *= norm;
-#endif
+  if (flag == -1 && plan->scaled) fft_3d_scale(out,plan);
+}
+
+/* ----------------------------------------------------------------------
+   allocate per field buffers for pipelined FFTs of nfield fields
+   return 0 if successful, 1 if out of memory
+------------------------------------------------------------------------- */
+
+static int fft_3d_batch_setup(struct fft_plan_3d *plan, int nfield)
+{
+  if (nfield <= plan->nbatch) return 0;
+
+  free(plan->batch_copy);
+  free(plan->batch_scratch);
+  free(plan->batch_send);
+  free(plan->batch_data);
+  free(plan->batch_request);
+
+  plan->batch_copy = (FFT_DATA *) malloc((size_t) nfield*plan->copy_size*sizeof(FFT_DATA));
+  plan->batch_scratch = (FFT_DATA *) malloc((size_t) nfield*plan->scratch_size*sizeof(FFT_DATA));
+  plan->batch_send = (FFT_DATA *) malloc((size_t) nfield*plan->send_size*sizeof(FFT_DATA));
+  plan->batch_data = (FFT_DATA **) malloc(nfield*sizeof(FFT_DATA *));
+  plan->batch_request = (MPI_Request *) malloc((size_t) nfield*plan->nrequest*sizeof(MPI_Request));
+  plan->nbatch = nfield;
+
+  if ((plan->copy_size && !plan->batch_copy) || (plan->scratch_size && !plan->batch_scratch) ||
+      (plan->send_size && !plan->batch_send) || !plan->batch_data ||
+      (plan->nrequest && !plan->batch_request)) {
+    plan->nbatch = 0;
+    return 1;
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   start remap of one field of pipelined FFTs
+   fields are told apart by the MPI tag
+------------------------------------------------------------------------- */
+
+static void fft_3d_batch_start(struct fft_plan_3d *plan, struct remap_plan_3d *rplan,
+                               int ifield)
+{
+  remap_3d_start((FFT_SCALAR *) plan->batch_data[ifield],
+                 (FFT_SCALAR *) &plan->batch_scratch[(size_t) ifield*plan->scratch_size],
+                 (FFT_SCALAR *) &plan->batch_send[(size_t) ifield*plan->send_size],
+                 &plan->batch_request[(size_t) ifield*plan->nrequest],ifield,rplan);
+}
+
+/* ----------------------------------------------------------------------
+   Perform 3d FFTs of several fields with the same plan
+
+   the remaps of one field are done with non-blocking communication
+   while the 1d FFTs of the previous field are computed, so that
+   communication and computation overlap. results are the same as
+   for calling fft_3d() for each field.
+
+   Arguments:
+   in           list of starting addresses of input data of each field
+   out          list of starting addresses of output data of each field
+                  (out[i] can be same as in[i], but must differ from
+                   in[j] and out[j] for all other fields j)
+   nfield       # of fields
+   flag         1 for forward FFT, -1 for backward FFT
+   plan         plan returned by previous call to fft_3d_create_plan
+------------------------------------------------------------------------- */
+
+void fft_3d_many(FFT_DATA **in, FFT_DATA **out, int nfield, int flag,
+                 struct fft_plan_3d *plan)
+{
+  // collective remaps cannot be split into start and finish
+
+  if (nfield < 2 || plan->mid1_plan->usecollective || plan->mid2_plan->usecollective ||
+      fft_3d_batch_setup(plan,nfield)) {
+    for (int ifield = 0; ifield < nfield; ifield++)
+      fft_3d(in[ifield],out[ifield],flag,plan);
+    return;
+  }
+
+  struct remap_plan_3d *remap[4] =
+    {plan->pre_plan, plan->mid1_plan, plan->mid2_plan, plan->post_plan};
+  const int target[4] = {plan->pre_target, plan->mid1_target, plan->mid2_target, 0};
+
+  FFT_DATA **data = plan->batch_data;
+  for (int ifield = 0; ifield < nfield; ifield++) data[ifield] = in[ifield];
+
+  // each stage is a remap, if needed, followed by 1d FFTs along one axis
+  // except for the last stage, which is only the post-remap
+
+  for (int stage = 0; stage < 4; stage++) {
+    struct remap_plan_3d *rplan = remap[stage];
+
+    if (rplan == nullptr) {
+      if (stage < 3)
+        for (int ifield = 0; ifield < nfield; ifield++)
+          fft_1d_axis(data[ifield],stage,flag,plan);
+      continue;
+    }
+
+    for (int ifield = 0; ifield < nfield; ifield++) {
+
+      // start remap of next field before working on this one
+
+      if (ifield == 0) fft_3d_batch_start(plan,rplan,0);
+      if (ifield+1 < nfield) fft_3d_batch_start(plan,rplan,ifield+1);
+
+      FFT_DATA *copy;
+      if (target[stage] == 0) copy = out[ifield];
+      else copy = &plan->batch_copy[(size_t) ifield*plan->copy_size];
+      remap_3d_finish((FFT_SCALAR *) copy,
+                      (FFT_SCALAR *) &plan->batch_scratch[(size_t) ifield*plan->scratch_size],
+                      &plan->batch_request[(size_t) ifield*plan->nrequest],rplan);
+      data[ifield] = copy;
+
+      if (stage < 3) fft_1d_axis(data[ifield],stage,flag,plan);
     }
   }
+
+  // post-remap, if any, put data into out, otherwise data is in out already
+  // scaling if required
+
+  if (flag == -1 && plan->scaled)
+    for (int ifield = 0; ifield < nfield; ifield++) fft_3d_scale(out[ifield],plan);
 }
 
 /* ----------------------------------------------------------------------
@@ -283,6 +389,11 @@ struct fft_plan_3d *fft_3d_create_plan(
   plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
   if (plan == nullptr) return nullptr;
 
+  plan->nbatch = 0;
+  plan->batch_copy = plan->batch_scratch = plan->batch_send = nullptr;
+  plan->batch_data = nullptr;
+  plan->batch_request = nullptr;
+
   // remap from initial distribution to layout needed for 1st set of 1d FFTs
   // not needed if all procs own entire fast axis initially
   // first indices = distribution after 1st set of FFTs
@@ -463,6 +574,23 @@ struct fft_plan_3d *fft_3d_create_plan(
 
   *nbuf = copy_size + scratch_size;
 
+  // sizes of per field buffers for pipelined FFTs of several fields
+  // packed data of all sends of a remap is kept until the remap completes
+
+  plan->copy_size = copy_size;
+  plan->scratch_size = scratch_size;
+  plan->send_size = 0;
+  plan->nrequest = 0;
+  struct remap_plan_3d *remap[4] =
+    {plan->pre_plan, plan->mid1_plan, plan->mid2_plan, plan->post_plan};
+  for (auto &rplan : remap) {
+    if (rplan == nullptr) continue;
+    int size = 0;
+    for (int i = 0; i < rplan->nsend; i++) size += rplan->send_size[i];
+    plan->send_size = MAX(plan->send_size,size/2);
+    plan->nrequest = MAX(plan->nrequest,rplan->nrecv + rplan->nsend);
+  }
+
   if (copy_size) {
     plan->copy = (FFT_DATA *) malloc(copy_size*sizeof(FFT_DATA));
     if (plan->copy == nullptr) return nullptr;
@@ -609,6 +737,12 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
   if (plan->copy) free(plan->copy);
   if (plan->scratch) free(plan->scratch);
 
+  free(plan->batch_copy);
+  free(plan->batch_scratch);
+  free(plan->batch_send);
+  free(plan->batch_data);
+  free(plan->batch_request);
+
 #if defined(FFT_MKL)
   DftiFreeDescriptor(&(plan->handle_fast));
   DftiFreeDescriptor(&(plan->handle_mid));
@@ -103,6 +103,17 @@ struct fft_plan_3d {
   int normnum;    // # of values to rescale
   double norm;    // normalization factor for rescaling
 
+  // buffers for pipelined FFTs of several fields, allocated on first use
+  int copy_size, scratch_size;    // size of copy and scratch buffer per field
+  int send_size;                  // size of send buffer per field
+  int nrequest;                   // # of MPI requests per field
+  int nbatch;                     // # of fields the buffers are allocated for
+  FFT_DATA *batch_copy;
+  FFT_DATA *batch_scratch;
+  FFT_DATA *batch_send;
+  FFT_DATA **batch_data;
+  MPI_Request *batch_request;
+
   // system specific 1d FFT info
 #if defined(FFT_MKL)
   DFTI_DESCRIPTOR *handle_fast;
@@ -129,6 +140,7 @@ struct fft_plan_3d {
 
 extern "C" {
 void fft_3d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
+void fft_3d_many(FFT_DATA **, FFT_DATA **, int, int, struct fft_plan_3d *);
 struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int, int,
                                        int, int, int, int, int, int, int, int *, int);
 void fft_3d_destroy_plan(struct fft_plan_3d *);
@@ -82,6 +82,19 @@ void FFT3d::compute(FFT_SCALAR *in, FFT_SCALAR *out, int flag)
   #endif
 }
 
+/* ----------------------------------------------------------------------
+   FFTs of several fields, overlapping remaps of one with FFTs of another
+------------------------------------------------------------------------- */
+
+void FFT3d::compute_many(FFT_SCALAR **in, FFT_SCALAR **out, int nfield, int flag)
+{
+  #ifndef FFT_HEFFTE
+  fft_3d_many((FFT_DATA **) in,(FFT_DATA **) out,nfield,flag,plan);
+  #else
+  for (int i = 0; i < nfield; i++) compute(in[i],out[i],flag);
+  #endif
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FFT3d::timing1d(FFT_SCALAR *in, int nsize, int flag)
@@ -40,6 +40,7 @@ class FFT3d : protected Pointers {
         int, int, int, int, int *, int);
   ~FFT3d() override;
   void compute(FFT_SCALAR *, FFT_SCALAR *, int);
+  void compute_many(FFT_SCALAR **, FFT_SCALAR **, int, int);
   void timing1d(FFT_SCALAR *, int, int);
 
  private:
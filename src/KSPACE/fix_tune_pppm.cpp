@@ -0,0 +1,233 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_tune_pppm.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "kspace.h"
+#include "neigh_request.h"
+#include "neighbor.h"
+#include "pair.h"
+#include "timer.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+static constexpr double MAXCHANGE = 1.1;   // max relative change of cutoff per adjustment
+static constexpr double TOLERANCE = 0.01;  // min relative change of cutoff or volume
+static constexpr double BIG = 1.0e20;
+
+/* ---------------------------------------------------------------------- */
+
+FixTunePPPM::FixTunePPPM(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg), p_cutoff(nullptr)
+{
+  if (narg < 4) utils::missing_cmd_args(FLERR,"fix tune/pppm",error);
+
+  nevery = utils::inumeric(FLERR,arg[3],false,lmp);
+  if (nevery <= 0) error->all(FLERR,"Illegal fix tune/pppm every value: {}",nevery);
+
+  ratio = 1.0;
+  cutflag = 0;
+  cutlo = cuthi = 0.0;
+
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"ratio") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"fix tune/pppm ratio",error);
+      ratio = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      if (ratio <= 0.0) error->all(FLERR,"Illegal fix tune/pppm ratio value: {}",ratio);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"cutoff") == 0) {
+      if (iarg+3 > narg) utils::missing_cmd_args(FLERR,"fix tune/pppm cutoff",error);
+      cutlo = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      cuthi = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      if ((cutlo <= 0.0) || (cuthi < cutlo))
+        error->all(FLERR,"Illegal fix tune/pppm cutoff values: {} {}",cutlo,cuthi);
+      cutflag = 1;
+      iarg += 3;
+    } else error->all(FLERR,"Unknown fix tune/pppm keyword: {}",arg[iarg]);
+  }
+
+  vector_flag = 1;
+  size_vector = 3;
+  global_freq = 1;
+  extvector = 0;
+
+  force_reneighbor = 1;
+  next_reneighbor = -1;
+
+  last_real = last_kspace = 0.0;
+  last_volume = 0.0;
+  time_ratio = 0.0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixTunePPPM::setmask()
+{
+  int mask = 0;
+  mask |= PRE_EXCHANGE;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixTunePPPM::init()
+{
+  if (!force->kspace)
+    error->all(FLERR,"Cannot use fix tune/pppm without a kspace style");
+  if (!force->kspace->pppmflag || force->kspace->dispersionflag)
+    error->all(FLERR,"Fix tune/pppm requires a PPPM kspace style for Coulombics");
+  if (!force->kspace->auto_params())
+    error->all(FLERR,"Cannot use fix tune/pppm with kspace_modify gewald or mesh");
+  if (utils::strmatch(force->kspace_style,"/kk"))
+    error->all(FLERR,"Cannot use fix tune/pppm with KOKKOS kspace styles");
+  if (!force->pair)
+    error->all(FLERR,"Cannot use fix tune/pppm without a pair style");
+  if (!timer->has_normal())
+    error->all(FLERR,"Fix tune/pppm requires timer level normal or full");
+
+  int itmp;
+  p_cutoff = (double *) force->pair->extract("cut_coul",itmp);
+  if (!p_cutoff || itmp)
+    error->all(FLERR,"Pair style {} is not compatible with fix tune/pppm",force->pair_style);
+
+  // default bounds are set from the cutoff of the first run
+  // the upper bound is tight, since neighbor lists grow with its cube
+
+  if (!cutflag) {
+    cutlo = 0.5 * (*p_cutoff);
+    cuthi = 1.2 * (*p_cutoff);
+    cutflag = 1;
+  }
+
+  cutlist = list_cutoff();
+}
+
+/* ----------------------------------------------------------------------
+   timers are reset after setup, so start measuring from zero
+------------------------------------------------------------------------- */
+
+void FixTunePPPM::setup(int /*vflag*/)
+{
+  last_real = last_kspace = 0.0;
+  last_volume = domain->xprd * domain->yprd * domain->zprd;
+  next_reneighbor = update->ntimestep + nevery;
+}
+
+/* ----------------------------------------------------------------------
+   rebalance real space and kspace cost every N steps
+   the time ratio is assumed to scale as the 6th power of the cutoff,
+     since pair time grows as rc^3 and grid points shrink as rc^-3 at
+     fixed accuracy
+   PPPM re-derives g_ewald and the grid for the new cutoff and volume
+     from the requested accuracy, so the accuracy is preserved
+------------------------------------------------------------------------- */
+
+void FixTunePPPM::pre_exchange()
+{
+  if (next_reneighbor != update->ntimestep) return;
+  next_reneighbor = update->ntimestep + nevery;
+
+  double real = timer->get_wall(Timer::PAIR) + timer->get_wall(Timer::NEIGH);
+  double kspace = timer->get_wall(Timer::KSPACE);
+  double local[2] = {real - last_real, kspace - last_kspace};
+  double all[2];
+  MPI_Allreduce(local,all,2,MPI_DOUBLE,MPI_SUM,world);
+  last_real = real;
+  last_kspace = kspace;
+  if ((all[0] <= 0.0) || (all[1] <= 0.0)) return;
+  time_ratio = all[0] / all[1];
+
+  double factor = pow(ratio / time_ratio, 1.0/6.0);
+  factor = MAX(factor, 1.0/MAXCHANGE);
+  factor = MIN(factor, MAXCHANGE);
+
+  double cutoff = *p_cutoff;
+  double newcut = MIN(MAX(cutoff * factor, cutlo), cuthi);
+  double volume = domain->xprd * domain->yprd * domain->zprd;
+
+  if ((fabs(newcut - cutoff) < TOLERANCE * cutoff) &&
+      (fabs(volume - last_volume) < TOLERANCE * last_volume)) return;
+
+  if (comm->me == 0)
+    utils::logmesg(lmp,"Fix tune/pppm: step {} real/kspace time ratio {:.4g}, "
+                   "Coulomb cutoff {:.6g} -> {:.6g}\n",
+                   update->ntimestep,time_ratio,cutoff,newcut);
+
+  // re-initialize PPPM before the pair style so g_ewald is consistent
+  // the request the pair style issues in init_style() is discarded,
+  //   since requests are only processed by Neighbor::init() before a run
+
+  *p_cutoff = newcut;
+  last_volume = volume;
+
+  int nrequest = neighbor->nrequest;
+  force->kspace->init();
+  force->pair->init();
+  for (int i = nrequest; i < neighbor->nrequest; i++) {
+    delete neighbor->requests[i];
+    neighbor->requests[i] = nullptr;
+  }
+  neighbor->nrequest = nrequest;
+  force->kspace->setup();
+
+  // update list cutoffs, bins, and ghost cutoff if the pair cutoff changed,
+  //   so lists never hold pairs beyond it that would bias the timings
+  // re-issued requests are unchanged, so Neighbor::init() keeps all lists,
+  //   including those of other fixes and computes
+  // atoms are exchanged and lists are rebuilt right after pre_exchange()
+
+  if (list_cutoff() != cutlist) {
+    neighbor->reissue_requests();
+    neighbor->init();
+    comm->setup();
+    neighbor->setup_bins();
+    cutlist = list_cutoff();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   smallest pair cutoff of all type pairs
+   neighbor lists cover the Coulomb cutoff up to this value
+------------------------------------------------------------------------- */
+
+double FixTunePPPM::list_cutoff()
+{
+  double cutsqmin = BIG;
+  for (int i = 1; i <= atom->ntypes; i++)
+    for (int j = 1; j <= atom->ntypes; j++)
+      cutsqmin = MIN(cutsqmin,force->pair->cutsq[i][j]);
+  return sqrt(cutsqmin);
+}
+
+/* ----------------------------------------------------------------------
+   return current cutoff, g_ewald, and last measured time ratio
+------------------------------------------------------------------------- */
+
+double FixTunePPPM::compute_vector(int n)
+{
+  if (n == 0) return *p_cutoff;
+  if (n == 1) return force->kspace->g_ewald;
+  return time_ratio;
+}
@@ -0,0 +1,54 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(tune/pppm,FixTunePPPM);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_TUNE_PPPM_H
+#define LMP_FIX_TUNE_PPPM_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixTunePPPM : public Fix {
+ public:
+  FixTunePPPM(class LAMMPS *, int, char **);
+
+  int setmask() override;
+  void init() override;
+  void setup(int) override;
+  void pre_exchange() override;
+  double compute_vector(int) override;
+
+ private:
+  double list_cutoff();
+  int nevery;
+  double ratio;           // target ratio of real space to kspace time
+  double cutlo, cuthi;    // bounds for the Coulomb cutoff
+  int cutflag;            // 1 if bounds were set by the user
+
+  double *p_cutoff;                 // Coulomb cutoff of the pair style
+  double cutlist;                   // smallest pair cutoff of the neighbor lists
+  double last_real, last_kspace;    // accumulated timers at last adjustment
+  double last_volume;               // box volume at last re-initialization
+  double time_ratio;                // last measured real space to kspace time ratio
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
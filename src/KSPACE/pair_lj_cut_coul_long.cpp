@@ -44,8 +44,12 @@ PairLJCutCoulLong::PairLJCutCoulLong(LAMMPS *lmp) : Pair(lmp)
 {
   ewaldflag = pppmflag = 1;
   respa_enable = 1;
+  cluster_enable = 1;
+  overlap_enable = 1;
+  precision_enable = 1;
   writedata = 1;
   ftable = nullptr;
+  coeff_float = nullptr;
   qdist = 0.0;
   cut_respa = nullptr;
 }
@@ -56,6 +60,8 @@ PairLJCutCoulLong::~PairLJCutCoulLong()
 {
   if (copymode) return;
 
+  memory->destroy(coeff_float);
+
   if (allocated) {
     memory->destroy(setflag);
     memory->destroy(cutsq);
@@ -85,8 +91,26 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
   int *ilist,*jlist,*numneigh,**firstneigh;
   double rsq;
 
+  if (cluster_flag) {
+    ev_init(eflag,vflag);
+    if (evflag) {
+      if (eflag) compute_cluster<1,1>();
+      else compute_cluster<1,0>();
+    } else compute_cluster<0,0>();
+    if (vflag_fdotr) virial_fdotr_compute();
+    return;
+  }
+
+  if (precision != PREC_DOUBLE) {
+    ev_init(eflag,vflag);
+    if (precision == PREC_MIXED) compute_float<double>();
+    else compute_float<float>();
+    if (vflag_fdotr) virial_fdotr_compute();
+    return;
+  }
+
   evdwl = ecoul = 0.0;
-  ev_init(eflag,vflag);
+  if (!overlap_flag || overlap_first) ev_init(eflag,vflag);
 
   double **x = atom->x;
   double **f = atom->f;
@@ -98,8 +122,13 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
   int newton_pair = force->newton_pair;
   double qqrd2e = force->qqrd2e;
 
-  inum = list->inum;
-  ilist = list->ilist;
+  if (overlap_flag) {
+    inum = overlap_inum;
+    ilist = overlap_ilist;
+  } else {
+    inum = list->inum;
+    ilist = list->ilist;
+  }
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
@@ -196,7 +225,278 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
     }
   }
 
-  if (vflag_fdotr) virial_fdotr_compute();
+  if (vflag_fdotr && (!overlap_flag || overlap_last)) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   same as compute() but with pairwise terms in single precision
+   acc_t = float for single, double for mixed precision accumulation
+     of the forces on each atom i
+------------------------------------------------------------------------- */
+
+template <class acc_t>
+void PairLJCutCoulLong::compute_float()
+{
+  xfloat_pack();
+
+  if (evflag) {
+    if (eflag_either) {
+      if (force->newton_pair) eval_float<acc_t,1,1,1>();
+      else eval_float<acc_t,1,1,0>();
+    } else {
+      if (force->newton_pair) eval_float<acc_t,1,0,1>();
+      else eval_float<acc_t,1,0,0>();
+    }
+  } else {
+    if (force->newton_pair) eval_float<acc_t,0,0,1>();
+    else eval_float<acc_t,0,0,0>();
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class acc_t, int EVFLAG, int EFLAG, int NEWTON_PAIR>
+void PairLJCutCoulLong::eval_float()
+{
+  int i,j,ii,jj,jnum,jtype;
+  float qtmp,xtmp,ytmp,ztmp,delx,dely,delz,fpair;
+  float table;
+  float r,r2inv,r6inv,forcecoul,forcelj,factor_coul,factor_lj;
+  float grij,expm2,t;
+  int itable = 0;
+  float fraction = 0.0f;
+  float prefactor = 0.0f;
+  float erfc = 0.0f;
+  float rsq;
+  float evdwl = 0.0f;
+  float ecoul = 0.0f;
+  acc_t fxtmp,fytmp,fztmp;
+  int *jlist;
+
+  const float *const xf = xfloat;
+  double **f = atom->f;
+  const double *const q = atom->q;
+  const int *const type = atom->type;
+  const int nlocal = atom->nlocal;
+  const int ntypes1 = atom->ntypes + 1;
+  float special_coul[4],special_lj[4];
+  for (i = 0; i < 4; i++) {
+    special_coul[i] = force->special_coul[i];
+    special_lj[i] = force->special_lj[i];
+  }
+  const float qqrd2e = force->qqrd2e;
+  const float g_ewaldf = g_ewald;
+  const float cut_coulsqf = cut_coulsq;
+  const float tabinnersqf = tabinnersq;
+
+  const int inum = list->inum;
+  const int *const ilist = list->ilist;
+  const int *const numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  // loop over neighbors of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    qtmp = q[i];
+    xtmp = xf[4*i];
+    ytmp = xf[4*i+1];
+    ztmp = xf[4*i+2];
+    const float *const ci = &coeff_float[8*ntypes1*type[i]];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    fxtmp = fytmp = fztmp = 0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      factor_coul = special_coul[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - xf[4*j];
+      dely = ytmp - xf[4*j+1];
+      delz = ztmp - xf[4*j+2];
+      rsq = delx*delx + dely*dely + delz*delz;
+      jtype = type[j];
+      const float *const cij = &ci[8*jtype];
+
+      if (rsq < cij[0]) {
+        r2inv = 1.0f/rsq;
+
+        if (rsq < cut_coulsqf) {
+          if (!ncoultablebits || rsq <= tabinnersqf) {
+            r = sqrtf(rsq);
+            grij = g_ewaldf * r;
+            expm2 = expf(-grij*grij);
+            t = 1.0f / (1.0f + (float) EWALD_P*grij);
+            erfc = t * ((float) A1 + t*((float) A2 + t*((float) A3 + t*((float) A4 +
+                   t*(float) A5)))) * expm2;
+            prefactor = qqrd2e * qtmp*(float) q[j]/r;
+            forcecoul = prefactor * (erfc + (float) EWALD_F*grij*expm2);
+            if (factor_coul < 1.0f) forcecoul -= (1.0f-factor_coul)*prefactor;
+          } else {
+            union_int_float_t rsq_lookup;
+            rsq_lookup.f = rsq;
+            itable = rsq_lookup.i & ncoulmask;
+            itable >>= ncoulshiftbits;
+            fraction = (rsq_lookup.f - (float) rtable[itable]) * (float) drtable[itable];
+            table = (float) ftable[itable] + fraction*(float) dftable[itable];
+            forcecoul = qtmp*(float) q[j] * table;
+            if (factor_coul < 1.0f) {
+              table = (float) ctable[itable] + fraction*(float) dctable[itable];
+              prefactor = qtmp*(float) q[j] * table;
+              forcecoul -= (1.0f-factor_coul)*prefactor;
+            }
+          }
+        } else forcecoul = 0.0f;
+
+        if (rsq < cij[1]) {
+          r6inv = r2inv*r2inv*r2inv;
+          forcelj = r6inv * (cij[2]*r6inv - cij[3]);
+        } else forcelj = 0.0f;
+
+        fpair = (forcecoul + factor_lj*forcelj) * r2inv;
+
+        fxtmp += delx*fpair;
+        fytmp += dely*fpair;
+        fztmp += delz*fpair;
+        if (NEWTON_PAIR || j < nlocal) {
+          f[j][0] -= delx*fpair;
+          f[j][1] -= dely*fpair;
+          f[j][2] -= delz*fpair;
+        }
+
+        if (EFLAG) {
+          if (rsq < cut_coulsqf) {
+            if (!ncoultablebits || rsq <= tabinnersqf)
+              ecoul = prefactor*erfc;
+            else {
+              table = (float) etable[itable] + fraction*(float) detable[itable];
+              ecoul = qtmp*(float) q[j] * table;
+            }
+            if (factor_coul < 1.0f) ecoul -= (1.0f-factor_coul)*prefactor;
+          } else ecoul = 0.0f;
+
+          if (rsq < cij[1]) {
+            evdwl = r6inv*(cij[4]*r6inv-cij[5]) - cij[6];
+            evdwl *= factor_lj;
+          } else evdwl = 0.0f;
+        }
+
+        if (EVFLAG) ev_tally(i,j,nlocal,NEWTON_PAIR,
+                             evdwl,ecoul,fpair,delx,dely,delz);
+      }
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   same as compute() but loops over pairs of atom clusters
+   all CLUSTERSIZE x CLUSTERSIZE atom pairs of a cluster pair are computed
+     without branches and masked, so the compiler can vectorize the loop
+   always uses the analytic Coulomb term, since table lookups are gathers
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG>
+void PairLJCutCoulLong::compute_cluster()
+{
+  constexpr int CS = NeighList::CLUSTERSIZE;
+  int a,b,ci,cj,k;
+  double evdwl = 0.0;
+  double ecoul = 0.0;
+
+  cluster_pack();
+
+  const double *const q = atom->q;
+  const int nlocal = atom->nlocal;
+  const double qqrd2e = force->qqrd2e;
+  const int nicluster = list->nicluster;
+  const int *const clusteratom = list->clusteratom;
+  const int *const cfirst = list->cfirst;
+  const int *const cjlist = list->cjlist;
+  const unsigned int *const cjmask = list->cjmask;
+
+  for (ci = 0; ci < nicluster; ci++) {
+    const double *const xi = &xcluster[3*CS*ci];
+    const int *const ti = &tcluster[CS*ci];
+    const int *const iatoms = &clusteratom[CS*ci];
+    double *const fi = &fcluster[3*CS*ci];
+
+    // charges of empty slots are zero
+
+    double qi[CS];
+    for (a = 0; a < CS; a++) qi[a] = (iatoms[a] >= 0) ? q[iatoms[a]] : 0.0;
+
+    for (k = cfirst[ci]; k < cfirst[ci+1]; k++) {
+      cj = cjlist[k];
+      const unsigned int bits = cjmask[k];
+      const double *const xj = &xcluster[3*CS*cj];
+      const int *const tj = &tcluster[CS*cj];
+      const int *const jatoms = &clusteratom[CS*cj];
+      double *const fj = &fcluster[3*CS*cj];
+
+      double qj[CS];
+      for (b = 0; b < CS; b++) qj[b] = (jatoms[b] >= 0) ? q[jatoms[b]] : 0.0;
+
+      for (a = 0; a < CS; a++) {
+        const int itype = ti[a];
+        const double *const cutsqi = cutsq[itype];
+        const double *const cut_ljsqi = cut_ljsq[itype];
+        const double *const lj1i = lj1[itype];
+        const double *const lj2i = lj2[itype];
+        double fxtmp = 0.0, fytmp = 0.0, fztmp = 0.0;
+
+        for (b = 0; b < CS; b++) {
+          const int jtype = tj[b];
+          const double delx = xi[a] - xj[b];
+          const double dely = xi[CS+a] - xj[CS+b];
+          const double delz = xi[2*CS+a] - xj[2*CS+b];
+          const double rsq = delx*delx + dely*dely + delz*delz;
+          const bool inside = ((bits >> (a*CS+b)) & 1U) && (rsq < cutsqi[jtype]);
+          const bool coul = inside && (rsq < cut_coulsq);
+          const bool lj = inside && (rsq < cut_ljsqi[jtype]);
+          const double r2inv = inside ? 1.0/rsq : 0.0;
+
+          const double r = coul ? sqrt(rsq) : 1.0;
+          const double grij = g_ewald * r;
+          const double expm2 = exp(-grij*grij);
+          const double t = 1.0 / (1.0 + EWALD_P*grij);
+          const double erfc = t * (A1+t*(A2+t*(A3+t*(A4+t*A5)))) * expm2;
+          const double prefactor = coul ? qqrd2e * qi[a]*qj[b]/r : 0.0;
+          const double forcecoul = prefactor * (erfc + EWALD_F*grij*expm2);
+
+          const double r6inv = lj ? r2inv*r2inv*r2inv : 0.0;
+          const double forcelj = r6inv * (lj1i[jtype]*r6inv - lj2i[jtype]);
+          const double fpair = (forcecoul + forcelj) * r2inv;
+
+          fxtmp += delx*fpair;
+          fytmp += dely*fpair;
+          fztmp += delz*fpair;
+          fj[b] -= delx*fpair;
+          fj[CS+b] -= dely*fpair;
+          fj[2*CS+b] -= delz*fpair;
+
+          if (EVFLAG && inside) {
+            if (EFLAG) {
+              ecoul = prefactor*erfc;
+              if (lj)
+                evdwl = r6inv*(lj3[itype][jtype]*r6inv-lj4[itype][jtype]) - offset[itype][jtype];
+              else evdwl = 0.0;
+            }
+            ev_tally(iatoms[a],jatoms[b],nlocal,1,evdwl,ecoul,fpair,delx,dely,delz);
+          }
+        }
+        fi[a] += fxtmp;
+        fi[CS+a] += fytmp;
+        fi[2*CS+a] += fztmp;
+      }
+    }
+  }
+
+  cluster_unpack();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -656,6 +956,14 @@ void PairLJCutCoulLong::init_style()
     if (respa->level_inner >= 0) list_style = NeighConst::REQ_RESPA_INOUT;
     if (respa->level_middle >= 0) list_style = NeighConst::REQ_RESPA_ALL;
   }
+  if (cluster_flag) {
+    if (list_style != NeighConst::REQ_DEFAULT)
+      error->all(FLERR,"Pair_modify cluster cannot be used with rRESPA inner levels");
+    if (ncoultablebits)
+      error->all(FLERR,"Pair_modify cluster requires pair_modify table 0 with pair style {}",
+                 force->pair_style);
+    list_style = NeighConst::REQ_CLUSTER;
+  }
   neighbor->add_request(this, list_style);
 
   cut_coulsq = cut_coul * cut_coul;
@@ -676,6 +984,14 @@ void PairLJCutCoulLong::init_style()
   // setup force tables
 
   if (ncoultablebits) init_tables(cut_coul,cut_respa);
+
+  // single precision copy of the per-type coefficients, filled by init_one()
+
+  memory->destroy(coeff_float);
+  if (precision != PREC_DOUBLE) {
+    const int n = atom->ntypes + 1;
+    memory->create(coeff_float,8*n*n,"pair:coeff_float");
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -713,6 +1029,20 @@ double PairLJCutCoulLong::init_one(int i, int j)
   lj4[j][i] = lj4[i][j];
   offset[j][i] = offset[i][j];
 
+  if (coeff_float) {
+    const int n = atom->ntypes + 1;
+    for (float *c : {&coeff_float[8*(i*n+j)], &coeff_float[8*(j*n+i)]}) {
+      c[0] = cut*cut;
+      c[1] = cut_ljsq[i][j];
+      c[2] = lj1[i][j];
+      c[3] = lj2[i][j];
+      c[4] = lj3[i][j];
+      c[5] = lj4[i][j];
+      c[6] = offset[i][j];
+      c[7] = 0.0f;
+    }
+  }
+
   // check interior rRESPA cutoff
 
   if (cut_respa && MIN(cut_lj[i][j],cut_coul) < cut_respa[3])
@@ -56,8 +56,12 @@ class PairLJCutCoulLong : public Pair {
   double *cut_respa;
   double qdist;    // TIP4P distance from O site to negative charge
   double g_ewald;
+  float *coeff_float;    // cutsq,cut_ljsq,lj1-lj4,offset per type pair in single precision
 
   virtual void allocate();
+  template <int EVFLAG, int EFLAG> void compute_cluster();
+  template <class acc_t> void compute_float();
+  template <class acc_t, int EVFLAG, int EFLAG, int NEWTON_PAIR> void eval_float();
 };
 
 }    // namespace LAMMPS_NS
@@ -32,6 +32,9 @@ using namespace LAMMPS_NS;
 
 PairLJCutCoulMSM::PairLJCutCoulMSM(LAMMPS *lmp) : PairLJCutCoulLong(lmp)
 {
+  cluster_enable = 0;
+  overlap_enable = 0;
+  precision_enable = 0;
   ewaldflag = pppmflag = 0;
   msmflag = 1;
   nmax = 0;
@@ -59,7 +59,7 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   factors(nullptr), density_brick(nullptr), vdx_brick(nullptr), vdy_brick(nullptr), vdz_brick(nullptr),
   u_brick(nullptr), v0_brick(nullptr), v1_brick(nullptr), v2_brick(nullptr), v3_brick(nullptr),
   v4_brick(nullptr), v5_brick(nullptr), greensfn(nullptr), vg(nullptr), fkx(nullptr), fky(nullptr),
-  fkz(nullptr), density_fft(nullptr), work1(nullptr), work2(nullptr), gf_b(nullptr), rho1d(nullptr),
+  fkz(nullptr), density_fft(nullptr), work1(nullptr), work2(nullptr), work3(nullptr), work4(nullptr), gf_b(nullptr), rho1d(nullptr),
   rho_coeff(nullptr), drho1d(nullptr), drho_coeff(nullptr),
   sf_precoeff1(nullptr), sf_precoeff2(nullptr), sf_precoeff3(nullptr),
   sf_precoeff4(nullptr), sf_precoeff5(nullptr), sf_precoeff6(nullptr),
@@ -94,6 +94,7 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   v0_brick = v1_brick = v2_brick = v3_brick = v4_brick = v5_brick = nullptr;
   greensfn = nullptr;
   work1 = work2 = nullptr;
+  work3 = work4 = nullptr;
   vg = nullptr;
   fkx = fky = fkz = nullptr;
 
@@ -109,6 +110,11 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   fft1 = fft2 = nullptr;
   remap = nullptr;
   gc = nullptr;
+
+  fft_subset = fft_member = 0;
+  fftcomm = MPI_COMM_NULL;
+  remap_back = nullptr;
+  begin_flag = begun = 0;
   gc_buf1 = gc_buf2 = nullptr;
 
   nmax = 0;
@@ -281,6 +287,20 @@ void PPPM::init()
   if (peratom_allocate_flag) deallocate_peratom();
   if (group_allocate_flag) deallocate_groups();
 
+  // FFTs on a subset of procs require that all FFTs are done by this class
+  // only plain PPPM can start the solve before the pair forces are computed
+
+  fft_subset = 0;
+  begin_flag = 0;
+  if (fft_nranks > 0 && fft_nranks < nprocs) {
+    const std::string style = force->kspace_style;
+    if ((style != "pppm") && (style != "pppm/omp") && (style != "pppm/cg") &&
+        (style != "pppm/cg/omp") && (style != "pppm/tip4p") && (style != "pppm/tip4p/omp"))
+      error->all(FLERR,"Kspace style {} does not support kspace_modify fft/ranks",style);
+    fft_subset = 1;
+    if ((style == "pppm") && (differentiation_flag == 0)) begin_flag = 1;
+  }
+
   // setup FFT grid resolution and g_ewald
   // normally one iteration thru while loop is all that is required
   // if grid stencil does not extend beyond neighbor proc
@@ -360,6 +380,8 @@ void PPPM::init()
     mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
     mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                        ngrid_max,nfft_both_max);
+    if (fft_subset)
+      mesg += fmt::format("  FFTs performed on {} of {} procs\n",fft_nranks,nprocs);
     utils::logmesg(lmp,mesg);
   }
 }
@@ -591,10 +613,10 @@ void PPPM::compute(int eflag, int vflag)
 {
   int i,j;
 
-  // set energy/virial flags
+  // set energy/virial flags, unless compute_begin() already did
   // invoke allocate_peratom() if needed for first time
 
-  ev_init(eflag,vflag);
+  if (!begun) ev_init(eflag,vflag);
 
   if (evflag_atom && !peratom_allocate_flag) allocate_peratom();
 
@@ -625,26 +647,38 @@ void PPPM::compute(int eflag, int vflag)
     memory->create(part2grid,nmax,3,"pppm:part2grid");
   }
 
-  // find grid points for all my particles
-  // map my particle charge onto my local 3d density grid
+  // if compute_begin() started the solve, the FFTs are done
+  //   and only the remap of the gradients to 3d bricks is left
 
-  particle_map();
-  make_rho();
+  if (begun) {
+    begun = 0;
+    FFT_SCALAR *work[3] = {work2, work3, work4};
+    for (int m = 0; m < 3; m++) remap_back->perform(work[m],work[m],nullptr);
+    poisson_ik_brick();
 
-  // all procs communicate density values from their ghost cells
-  //   to fully sum contribution in their 3d bricks
-  // remap from 3d decomposition to FFT decomposition
+  } else {
 
-  gc->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
-                   gc_buf1,gc_buf2,MPI_FFT_SCALAR);
-  brick2fft();
+    // find grid points for all my particles
+    // map my particle charge onto my local 3d density grid
 
-  // compute potential gradient on my FFT grid and
-  //   portion of e_long on this proc's FFT grid
-  // return gradients (electric fields) in 3d brick decomposition
-  // also performs per-atom calculations via poisson_peratom()
+    particle_map();
+    make_rho();
 
-  poisson();
+    // all procs communicate density values from their ghost cells
+    //   to fully sum contribution in their 3d bricks
+    // remap from 3d decomposition to FFT decomposition
+
+    gc->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
+                     gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    brick2fft();
+
+    // compute potential gradient on my FFT grid and
+    //   portion of e_long on this proc's FFT grid
+    // return gradients (electric fields) in 3d brick decomposition
+    // also performs per-atom calculations via poisson_peratom()
+
+    poisson();
+  }
 
   // all procs communicate E-field values
   // to fill ghost cells surrounding their 3d bricks
@@ -733,6 +767,59 @@ void PPPM::compute(int eflag, int vflag)
   if (triclinic) domain->lamda2x(atom->nlocal);
 }
 
+/* ----------------------------------------------------------------------
+   start the PPPM solve before the pair forces are computed
+   with FFTs on a subset of procs, the subset performs the FFTs
+     while the other procs can already compute their pair forces
+   compute() completes the solve and computes the forces
+------------------------------------------------------------------------- */
+
+void PPPM::compute_begin(int eflag, int vflag)
+{
+  if (!begin_flag) return;
+
+  // per-atom energy/virial requires extra FFTs, leave all to compute()
+
+  ev_init(eflag,vflag);
+  if (evflag_atom) return;
+
+  if (atom->natoms != natoms_original) {
+    qsum_qsq();
+    natoms_original = atom->natoms;
+  }
+
+  if (qsqsum == 0.0) return;
+
+  if (triclinic == 0) boxlo = domain->boxlo;
+  else {
+    boxlo = domain->boxlo_lamda;
+    domain->x2lamda(atom->nlocal);
+  }
+
+  if (atom->nmax > nmax) {
+    memory->destroy(part2grid);
+    nmax = atom->nmax;
+    memory->create(part2grid,nmax,3,"pppm:part2grid");
+  }
+
+  // map charges onto the grid and remap them to the FFT decomposition
+  // then only procs of the subset have work left in poisson()
+
+  particle_map();
+  make_rho();
+
+  gc->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
+                   gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+  brick2fft();
+
+  begun = 1;
+  poisson();
+
+  // pair styles require atoms in box coords
+
+  if (triclinic) domain->lamda2x(atom->nlocal);
+}
+
 /* ----------------------------------------------------------------------
    allocate memory that depends on # of K-vectors and order
 ------------------------------------------------------------------------- */
@@ -787,6 +874,10 @@ void PPPM::allocate()
   memory->create(greensfn,nfft_both,"pppm:greensfn");
   memory->create(work1,2*nfft_both,"pppm:work1");
   memory->create(work2,2*nfft_both,"pppm:work2");
+  if ((fft_batch_flag || begin_flag) && differentiation_flag == 0) {
+    memory->create(work3,2*nfft_both,"pppm:work3");
+    memory->create(work4,2*nfft_both,"pppm:work4");
+  }
   memory->create(vg,nfft_both,6,"pppm:vg");
 
   if (triclinic == 0) {
@@ -834,17 +925,35 @@ void PPPM::allocate()
   // 2nd FFT returns data in 3d brick decomposition
   // remap takes data from 3d brick to FFT decomposition
 
+  // with FFTs on a subset of procs, only procs of the subset create
+  //   the 1st FFT and use it in both directions
+  // remap_back then takes data from FFT to 3d brick decomposition
+
   int tmp;
 
-  fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
+  if (fft_subset) {
+    MPI_Comm_split(world,fft_member,me,&fftcomm);
+    if (fft_member)
+      fft1 = new FFT3d(lmp,fftcomm,nx_pppm,ny_pppm,nz_pppm,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       0,0,&tmp,collective_flag);
+
+    remap_back = new Remap(lmp,world,
+                           nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                           nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                           2,0,1,FFT_PRECISION,collective_flag);
+  } else {
+    fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag);
 
-  fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+    fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                     0,0,&tmp,collective_flag);
+  }
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
@@ -882,6 +991,8 @@ void PPPM::deallocate()
   memory->destroy(greensfn);
   memory->destroy(work1);
   memory->destroy(work2);
+  memory->destroy(work3);
+  memory->destroy(work4);
   memory->destroy(vg);
 
   if (triclinic == 0) {
@@ -904,6 +1015,11 @@ void PPPM::deallocate()
   delete fft1;
   delete fft2;
   delete remap;
+  delete remap_back;
+  fft1 = fft2 = nullptr;
+  remap = remap_back = nullptr;
+  if (fftcomm != MPI_COMM_NULL) MPI_Comm_free(&fftcomm);
+  fftcomm = MPI_COMM_NULL;
 }
 
 /* ----------------------------------------------------------------------
@@ -1388,14 +1504,32 @@ void PPPM::set_grid_local()
   // nlo_fft,nhi_fft = lower/upper limit of the section
   //   of the global FFT mesh that I own in x-pencil decomposition
 
+  // with FFTs on a subset of procs, the subset is spread evenly across
+  //   all procs, procs outside the subset own none of the FFT mesh
+
+  int nprocs_fft = nprocs;
+  int me_fft = me;
+  fft_member = 1;
+
+  if (fft_subset) {
+    nprocs_fft = fft_nranks;
+    me_fft = (bigint) me * fft_nranks / nprocs;
+    if ((bigint) me * fft_nranks % nprocs >= fft_nranks) {
+      fft_member = 0;
+      nxlo_fft = nylo_fft = nzlo_fft = 0;
+      nxhi_fft = nyhi_fft = nzhi_fft = -1;
+      return;
+    }
+  }
+
   int npey_fft,npez_fft;
-  if (nz_pppm >= nprocs) {
+  if (nz_pppm >= nprocs_fft) {
     npey_fft = 1;
-    npez_fft = nprocs;
-  } else procs2grid2d(nprocs,ny_pppm,nz_pppm,&npey_fft,&npez_fft);
+    npez_fft = nprocs_fft;
+  } else procs2grid2d(nprocs_fft,ny_pppm,nz_pppm,&npey_fft,&npez_fft);
 
-  int me_y = me % npey_fft;
-  int me_z = me / npey_fft;
+  int me_y = me_fft % npey_fft;
+  int me_z = me_fft / npey_fft;
 
   nxlo_fft = 0;
   nxhi_fft = nx_pppm - 1;
@@ -1847,6 +1981,15 @@ void PPPM::make_rho()
   memset(&(density_brick[nzlo_out][nylo_out][nxlo_out]),0,
          ngrid*sizeof(FFT_SCALAR));
 
+  // use a kernel with fixed stencil size, if available
+
+  switch (order) {
+    case 4: make_rho_order<4>(); return;
+    case 5: make_rho_order<5>(); return;
+    case 6: make_rho_order<6>(); return;
+    case 7: make_rho_order<7>(); return;
+  }
+
   // loop over my charges, add their contribution to nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
   // (dx,dy,dz) = distance to "lower left" grid pt
@@ -1883,6 +2026,65 @@ void PPPM::make_rho()
   }
 }
 
+/* ----------------------------------------------------------------------
+   same as make_rho() for a stencil of ORDER points in each dimension
+   fixed loop counts allow the compiler to unroll and vectorize,
+     results are identical to those of make_rho()
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+void PPPM::make_rho_order()
+{
+  FFT_SCALAR coeff[ORDER*ORDER];
+  FFT_SCALAR rx[ORDER],ry[ORDER],rz[ORDER];
+  rho_coeff_order(coeff);
+
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (dx,dy,dz) = distance to "lower left" grid pt
+  // (mx,my,mz) = global coords of lowest stencil pt
+
+  double *q = atom->q;
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+
+  for (int i = 0; i < nlocal; i++) {
+    const int nx = part2grid[i][0];
+    const int ny = part2grid[i][1];
+    const int nz = part2grid[i][2];
+    const FFT_SCALAR dx = nx+shiftone - (x[i][0]-boxlo[0])*delxinv;
+    const FFT_SCALAR dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
+    const FFT_SCALAR dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
+
+    compute_rho1d_order<ORDER>(coeff,dx,rx);
+    compute_rho1d_order<ORDER>(coeff,dy,ry);
+    compute_rho1d_order<ORDER>(coeff,dz,rz);
+
+    const int mx = nx+nlower;
+    const int my = ny+nlower;
+    const int mz = nz+nlower;
+    const FFT_SCALAR z0 = delvolinv * q[i];
+
+    for (int n = 0; n < ORDER; n++) {
+      const FFT_SCALAR y0 = z0*rz[n];
+      for (int m = 0; m < ORDER; m++) {
+        const FFT_SCALAR x0 = y0*ry[m];
+        FFT_SCALAR *row = &density_brick[mz+n][my+m][mx];
+        for (int l = 0; l < ORDER; l++) row[l] += x0*rx[l];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   copy rho_coeff into coeff as contiguous order x order array
+------------------------------------------------------------------------- */
+
+void PPPM::rho_coeff_order(FFT_SCALAR *coeff)
+{
+  for (int l = 0; l < order; l++)
+    for (int k = 0; k < order; k++) coeff[l*order+k] = rho_coeff[l][k+nlower];
+}
+
 /* ----------------------------------------------------------------------
    remap density from 3d brick decomposition to FFT decomposition
 ------------------------------------------------------------------------- */
@@ -1904,6 +2106,29 @@ void PPPM::brick2fft()
   remap->perform(density_fft,density_fft,work1);
 }
 
+/* ----------------------------------------------------------------------
+   forward FFT of data in FFT decomposition
+   with FFTs on a subset of procs, procs outside the subset have no data
+------------------------------------------------------------------------- */
+
+void PPPM::fft_forward(FFT_SCALAR *data)
+{
+  if (fft1) fft1->compute(data,data,FFT3d::FORWARD);
+}
+
+/* ----------------------------------------------------------------------
+   backward FFT of data in FFT decomposition
+   returns data in 3d brick decomposition
+------------------------------------------------------------------------- */
+
+void PPPM::fft_backward(FFT_SCALAR *data)
+{
+  if (fft_subset) {
+    if (fft1) fft1->compute(data,data,FFT3d::BACKWARD);
+    remap_back->perform(data,data,nullptr);
+  } else fft2->compute(data,data,FFT3d::BACKWARD);
+}
+
 /* ----------------------------------------------------------------------
    FFT-based Poisson solver
 ------------------------------------------------------------------------- */
@@ -1931,7 +2156,7 @@ void PPPM::poisson_ik()
     work1[n++] = ZEROF;
   }
 
-  fft1->compute(work1,work1,FFT3d::FORWARD);
+  fft_forward(work1);
 
   // global energy and virial contribution
 
@@ -1971,6 +2196,13 @@ void PPPM::poisson_ik()
 
   if (evflag_atom) poisson_peratom();
 
+  // transform all 3 gradients together, if requested
+
+  if (work3) {
+    poisson_ik_batch();
+    return;
+  }
+
   // triclinic system
 
   if (triclinic) {
@@ -1993,7 +2225,7 @@ void PPPM::poisson_ik()
         n += 2;
       }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2014,7 +2246,7 @@ void PPPM::poisson_ik()
         n += 2;
       }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2035,7 +2267,7 @@ void PPPM::poisson_ik()
         n += 2;
       }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2067,7 +2299,7 @@ void PPPM::poisson_ik_triclinic()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2086,7 +2318,7 @@ void PPPM::poisson_ik_triclinic()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2105,7 +2337,7 @@ void PPPM::poisson_ik_triclinic()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2116,6 +2348,77 @@ void PPPM::poisson_ik_triclinic()
       }
 }
 
+/* ----------------------------------------------------------------------
+   FFT-based Poisson solver for ik with the 3 gradients transformed
+   together, so that their remaps overlap with each other's 1d FFTs
+------------------------------------------------------------------------- */
+
+void PPPM::poisson_ik_batch()
+{
+  int i,j,k,n;
+
+  // compute gradients of V(r) in each of 3 dims by transforming ik*V(k)
+  // FFT leaves data in 3d brick decomposition
+  // copy it into inner portion of vdx,vdy,vdz arrays
+
+  n = 0;
+  if (triclinic) {
+    for (i = 0; i < nfft; i++) {
+      work2[n] = -fkx[i]*work1[n+1];
+      work2[n+1] = fkx[i]*work1[n];
+      work3[n] = -fky[i]*work1[n+1];
+      work3[n+1] = fky[i]*work1[n];
+      work4[n] = -fkz[i]*work1[n+1];
+      work4[n+1] = fkz[i]*work1[n];
+      n += 2;
+    }
+  } else {
+    for (k = nzlo_fft; k <= nzhi_fft; k++)
+      for (j = nylo_fft; j <= nyhi_fft; j++)
+        for (i = nxlo_fft; i <= nxhi_fft; i++) {
+          work2[n] = -fkx[i]*work1[n+1];
+          work2[n+1] = fkx[i]*work1[n];
+          work3[n] = -fky[j]*work1[n+1];
+          work3[n+1] = fky[j]*work1[n];
+          work4[n] = -fkz[k]*work1[n+1];
+          work4[n+1] = fkz[k]*work1[n];
+          n += 2;
+        }
+  }
+
+  // with FFTs on a subset of procs, the remap back to 3d bricks
+  //   is left to compute() if the solve was started by compute_begin()
+
+  FFT_SCALAR *work[3] = {work2, work3, work4};
+  if (fft_subset) {
+    if (fft1) fft1->compute_many(work,work,3,FFT3d::BACKWARD);
+    if (begun) return;
+    for (int m = 0; m < 3; m++) remap_back->perform(work[m],work[m],nullptr);
+  } else fft2->compute_many(work,work,3,FFT3d::BACKWARD);
+
+  poisson_ik_brick();
+}
+
+/* ----------------------------------------------------------------------
+   copy the 3 gradients of the pipelined FFTs into inner portion
+   of vdx,vdy,vdz arrays
+------------------------------------------------------------------------- */
+
+void PPPM::poisson_ik_brick()
+{
+  int i,j,k,n;
+
+  n = 0;
+  for (k = nzlo_in; k <= nzhi_in; k++)
+    for (j = nylo_in; j <= nyhi_in; j++)
+      for (i = nxlo_in; i <= nxhi_in; i++) {
+        vdx_brick[k][j][i] = work2[n];
+        vdy_brick[k][j][i] = work3[n];
+        vdz_brick[k][j][i] = work4[n];
+        n += 2;
+      }
+}
+
 /* ----------------------------------------------------------------------
    FFT-based Poisson solver for ad
 ------------------------------------------------------------------------- */
@@ -2133,7 +2436,7 @@ void PPPM::poisson_ad()
     work1[n++] = ZEROF;
   }
 
-  fft1->compute(work1,work1,FFT3d::FORWARD);
+  fft_forward(work1);
 
   // global energy and virial contribution
 
@@ -2180,7 +2483,7 @@ void PPPM::poisson_ad()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2209,7 +2512,7 @@ void PPPM::poisson_peratom()
       n += 2;
     }
 
-    fft2->compute(work2,work2,FFT3d::BACKWARD);
+    fft_backward(work2);
 
     n = 0;
     for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2231,7 +2534,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2248,7 +2551,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2265,7 +2568,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2282,7 +2585,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2299,7 +2602,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2316,7 +2619,7 @@ void PPPM::poisson_peratom()
     n += 2;
   }
 
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
+  fft_backward(work2);
 
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
@@ -2353,6 +2656,15 @@ void PPPM::fieldforce_ik()
   // (mx,my,mz) = global coords of moving stencil pt
   // ek = 3 components of E-field on particle
 
+  // use a kernel with fixed stencil size, if available
+
+  switch (order) {
+    case 4: fieldforce_ik_order<4>(); return;
+    case 5: fieldforce_ik_order<5>(); return;
+    case 6: fieldforce_ik_order<6>(); return;
+    case 7: fieldforce_ik_order<7>(); return;
+  }
+
   double *q = atom->q;
   double **x = atom->x;
   double **f = atom->f;
@@ -2395,6 +2707,69 @@ void PPPM::fieldforce_ik()
   }
 }
 
+/* ----------------------------------------------------------------------
+   same as fieldforce_ik() for a stencil of ORDER points in each dimension
+   fixed loop counts allow the compiler to unroll and vectorize,
+     results are identical to those of fieldforce_ik()
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+void PPPM::fieldforce_ik_order()
+{
+  FFT_SCALAR coeff[ORDER*ORDER];
+  FFT_SCALAR rx[ORDER],ry[ORDER],rz[ORDER];
+  rho_coeff_order(coeff);
+
+  double *q = atom->q;
+  double **x = atom->x;
+  double **f = atom->f;
+
+  int nlocal = atom->nlocal;
+
+  for (int i = 0; i < nlocal; i++) {
+    const int nx = part2grid[i][0];
+    const int ny = part2grid[i][1];
+    const int nz = part2grid[i][2];
+    const FFT_SCALAR dx = nx+shiftone - (x[i][0]-boxlo[0])*delxinv;
+    const FFT_SCALAR dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
+    const FFT_SCALAR dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
+
+    compute_rho1d_order<ORDER>(coeff,dx,rx);
+    compute_rho1d_order<ORDER>(coeff,dy,ry);
+    compute_rho1d_order<ORDER>(coeff,dz,rz);
+
+    const int mx = nx+nlower;
+    const int my = ny+nlower;
+    const int mz = nz+nlower;
+    FFT_SCALAR ekx = ZEROF;
+    FFT_SCALAR eky = ZEROF;
+    FFT_SCALAR ekz = ZEROF;
+
+    for (int n = 0; n < ORDER; n++) {
+      const FFT_SCALAR z0 = rz[n];
+      for (int m = 0; m < ORDER; m++) {
+        const FFT_SCALAR y0 = z0*ry[m];
+        const FFT_SCALAR *xrow = &vdx_brick[mz+n][my+m][mx];
+        const FFT_SCALAR *yrow = &vdy_brick[mz+n][my+m][mx];
+        const FFT_SCALAR *zrow = &vdz_brick[mz+n][my+m][mx];
+        for (int l = 0; l < ORDER; l++) {
+          const FFT_SCALAR x0 = y0*rx[l];
+          ekx -= x0*xrow[l];
+          eky -= x0*yrow[l];
+          ekz -= x0*zrow[l];
+        }
+      }
+    }
+
+    // convert E-field to force
+
+    const double qfactor = qqrd2e * scale * q[i];
+    f[i][0] += qfactor*ekx;
+    f[i][1] += qfactor*eky;
+    if (slabflag != 2) f[i][2] += qfactor*ekz;
+  }
+}
+
 /* ----------------------------------------------------------------------
    interpolate from grid to get electric field & force on my particles for ad
 ------------------------------------------------------------------------- */
@@ -2924,12 +3299,18 @@ int PPPM::timing_1d(int n, double &time1d)
   MPI_Barrier(world);
   time1 = platform::walltime();
 
+  // with FFTs on a subset of procs, the 1st FFT does both directions
+  //   and procs outside the subset have no FFTs
+
+  FFT3d *fftb = fft_subset ? fft1 : fft2;
+
   for (int i = 0; i < n; i++) {
+    if (!fftb) break;
     fft1->timing1d(work1,nfft_both,FFT3d::FORWARD);
-    fft2->timing1d(work1,nfft_both,FFT3d::BACKWARD);
+    fftb->timing1d(work1,nfft_both,FFT3d::BACKWARD);
     if (differentiation_flag != 1) {
-      fft2->timing1d(work1,nfft_both,FFT3d::BACKWARD);
-      fft2->timing1d(work1,nfft_both,FFT3d::BACKWARD);
+      fftb->timing1d(work1,nfft_both,FFT3d::BACKWARD);
+      fftb->timing1d(work1,nfft_both,FFT3d::BACKWARD);
     }
   }
 
@@ -2955,11 +3336,11 @@ int PPPM::timing_3d(int n, double &time3d)
   time1 = platform::walltime();
 
   for (int i = 0; i < n; i++) {
-    fft1->compute(work1,work1,FFT3d::FORWARD);
-    fft2->compute(work1,work1,FFT3d::BACKWARD);
+    fft_forward(work1);
+    fft_backward(work1);
     if (differentiation_flag != 1) {
-      fft2->compute(work1,work1,FFT3d::BACKWARD);
-      fft2->compute(work1,work1,FFT3d::BACKWARD);
+      fft_backward(work1);
+      fft_backward(work1);
     }
   }
 
@@ -2991,6 +3372,7 @@ double PPPM::memory_usage()
   bytes += (double)6 * nfft_both * sizeof(double);
   bytes += (double)nfft_both * sizeof(double);
   bytes += (double)nfft_both*5 * sizeof(FFT_SCALAR);
+  if (work3) bytes += (double)nfft_both*4 * sizeof(FFT_SCALAR);
 
   if (peratom_allocate_flag)
     bytes += (double)6 * nbrick * sizeof(FFT_SCALAR);
@@ -3236,7 +3618,7 @@ void PPPM::poisson_groups(int AA_flag)
     work_A[n++] = ZEROF;
   }
 
-  fft1->compute(work_A,work_A,FFT3d::FORWARD);
+  fft_forward(work_A);
 
   // group B
 
@@ -3246,7 +3628,7 @@ void PPPM::poisson_groups(int AA_flag)
     work_B[n++] = ZEROF;
   }
 
-  fft1->compute(work_B,work_B,FFT3d::FORWARD);
+  fft_forward(work_B);
 
   // group-group energy and force contribution,
   //  keep everything in reciprocal space so
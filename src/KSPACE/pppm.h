@@ -34,6 +34,7 @@ class PPPM : public KSpace {
   void setup() override;
   void reset_grid() override;
   void compute(int, int) override;
+  void compute_begin(int, int) override;
   int timing_1d(int, double &) override;
   int timing_3d(int, double &) override;
   double memory_usage() override;
@@ -68,6 +69,7 @@ class PPPM : public KSpace {
   double *fkx, *fky, *fkz;
   FFT_SCALAR *density_fft;
   FFT_SCALAR *work1, *work2;
+  FFT_SCALAR *work3, *work4;    // extra work arrays for pipelined FFTs
 
   double *gf_b;
   FFT_SCALAR **rho1d, **rho_coeff, **drho1d, **drho_coeff;
@@ -82,6 +84,15 @@ class PPPM : public KSpace {
   class Remap *remap;
   class Grid3d *gc;
 
+  // FFTs on a subset of procs
+
+  int fft_subset;             // 1 if only a subset of procs performs the FFTs
+  int fft_member;             // 1 if this proc is part of the subset
+  MPI_Comm fftcomm;           // communicator of the subset
+  class Remap *remap_back;    // FFT decomposition to 3d bricks, on all procs
+  int begin_flag;             // 1 if compute_begin() can start the solve
+  int begun;                  // 1 if compute_begin() started the solve
+
   FFT_SCALAR *gc_buf1, *gc_buf2;
   int ngc_buf1, ngc_buf2, npergrid;
 
@@ -124,9 +135,31 @@ class PPPM : public KSpace {
   virtual void make_rho();
   virtual void brick2fft();
 
+  // kernels with the stencil size fixed at compile time for orders 4 to 7
+
+  template <int ORDER> void make_rho_order();
+  template <int ORDER> void fieldforce_ik_order();
+  void rho_coeff_order(FFT_SCALAR *);
+
+  // weights of the ORDER stencil points in one dimension
+  // coeff = rho_coeff as ORDER x ORDER array, see rho_coeff_order()
+
+  template <int ORDER>
+  static inline void compute_rho1d_order(const FFT_SCALAR *coeff, const FFT_SCALAR d,
+                                         FFT_SCALAR *r1d)
+  {
+    for (int k = 0; k < ORDER; k++) {
+      FFT_SCALAR r = 0.0;
+      for (int l = ORDER - 1; l >= 0; l--) r = coeff[l * ORDER + k] + r * d;
+      r1d[k] = r;
+    }
+  }
+
   virtual void poisson();
   virtual void poisson_ik();
   virtual void poisson_ad();
+  void fft_forward(FFT_SCALAR *);
+  void fft_backward(FFT_SCALAR *);
 
   virtual void fieldforce();
   virtual void fieldforce_ik();
@@ -153,6 +186,8 @@ class PPPM : public KSpace {
   void setup_triclinic();
   void compute_gf_ik_triclinic();
   void poisson_ik_triclinic();
+  void poisson_ik_batch();
+  void poisson_ik_brick();
   void poisson_groups_triclinic();
 
   // group-group interactions
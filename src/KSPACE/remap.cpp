@@ -202,6 +202,106 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
   }
 }
 
+/* ----------------------------------------------------------------------
+   Start a 3d remap with non-blocking point-to-point communication,
+   so that computation can overlap with it until remap_3d_finish()
+
+   Arguments:
+   in           starting address of input data on this proc
+                  all input data is read, so it can be modified afterwards
+   buf          extra memory for received data, same size as for remap_3d()
+   sendbuf      memory for packed data of all sends of this remap,
+                  must stay untouched until remap_3d_finish()
+   request      nrecv + nsend MPI requests
+   tag          MPI tag to tell apart several remaps in progress with same plan
+   plan         plan returned by previous call to remap_3d_create_plan
+                  with usecollective = 0
+------------------------------------------------------------------------- */
+
+void remap_3d_start(FFT_SCALAR *in, FFT_SCALAR *buf, FFT_SCALAR *sendbuf,
+                    MPI_Request *request, int tag, struct remap_plan_3d *plan)
+{
+  int isend,irecv;
+  FFT_SCALAR *scratch;
+
+  if (plan->memory == 0)
+    scratch = buf;
+  else
+    scratch = plan->scratch;
+
+  // post all recvs into scratch space
+
+  for (irecv = 0; irecv < plan->nrecv; irecv++)
+    MPI_Irecv(&scratch[plan->recv_bufloc[irecv]],plan->recv_size[irecv],
+              MPI_FFT_SCALAR,plan->recv_proc[irecv],tag,
+              plan->comm,&request[irecv]);
+
+  // pack and send all messages to other procs
+
+  int offset = 0;
+  for (isend = 0; isend < plan->nsend; isend++) {
+    plan->pack(&in[plan->send_offset[isend]],&sendbuf[offset],
+               &plan->packplan[isend]);
+    MPI_Isend(&sendbuf[offset],plan->send_size[isend],MPI_FFT_SCALAR,
+              plan->send_proc[isend],tag,plan->comm,&request[plan->nrecv+isend]);
+    offset += plan->send_size[isend];
+  }
+
+  // copy in -> scratch for self data
+
+  if (plan->self) {
+    isend = plan->nsend;
+    irecv = plan->nrecv;
+    plan->pack(&in[plan->send_offset[isend]],
+               &scratch[plan->recv_bufloc[irecv]],
+               &plan->packplan[isend]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Complete a 3d remap started with remap_3d_start()
+
+   Arguments:
+   out          starting address of where output data for this proc
+                  will be placed (can be same as input of remap_3d_start)
+   buf          same as for remap_3d_start()
+   request      same as for remap_3d_start()
+   plan         same as for remap_3d_start()
+------------------------------------------------------------------------- */
+
+void remap_3d_finish(FFT_SCALAR *out, FFT_SCALAR *buf, MPI_Request *request,
+                     struct remap_plan_3d *plan)
+{
+  int i,irecv;
+  FFT_SCALAR *scratch;
+
+  if (plan->memory == 0)
+    scratch = buf;
+  else
+    scratch = plan->scratch;
+
+  // copy scratch -> out for self data
+
+  if (plan->self) {
+    irecv = plan->nrecv;
+    plan->unpack(&scratch[plan->recv_bufloc[irecv]],
+                 &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+  }
+
+  // unpack all messages from scratch -> out as they arrive
+
+  for (i = 0; i < plan->nrecv; i++) {
+    MPI_Waitany(plan->nrecv,request,&irecv,MPI_STATUS_IGNORE);
+    plan->unpack(&scratch[plan->recv_bufloc[irecv]],
+                 &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+  }
+
+  // send buffer may be reused after all sends are complete
+
+  if (plan->nsend)
+    MPI_Waitall(plan->nsend,&request[plan->nrecv],MPI_STATUSES_IGNORE);
+}
+
 /* ----------------------------------------------------------------------
    Create plan for performing a 3d remap
 
@@ -55,6 +55,9 @@ struct extent_3d {
 // function prototypes
 
 void remap_3d(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR *, struct remap_plan_3d *);
+void remap_3d_start(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR *, MPI_Request *, int,
+                    struct remap_plan_3d *);
+void remap_3d_finish(FFT_SCALAR *, FFT_SCALAR *, MPI_Request *, struct remap_plan_3d *);
 struct remap_plan_3d *remap_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int,
                                            int, int, int, int, int, int, int, int);
 void remap_3d_destroy_plan(struct remap_plan_3d *);
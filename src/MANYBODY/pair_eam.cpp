@@ -39,6 +39,7 @@ PairEAM::PairEAM(LAMMPS *lmp) : Pair(lmp)
 {
   restartinfo = 0;
   manybody_flag = 1;
+  precision_enable = 1;
   embedstep = -1;
   unit_convert_flag = utils::get_supported_conversions(utils::ENERGY);
 
@@ -183,37 +184,48 @@ void PairEAM::compute(int eflag, int vflag)
 
   // rho = density at each atom
   // loop over neighbors of my atoms
-
-  for (ii = 0; ii < inum; ii++) {
-    i = ilist[ii];
-    xtmp = x[i][0];
-    ytmp = x[i][1];
-    ztmp = x[i][2];
-    itype = type[i];
-    jlist = firstneigh[i];
-    jnum = numneigh[i];
-
-    for (jj = 0; jj < jnum; jj++) {
-      j = jlist[jj];
-      j &= NEIGHMASK;
-
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
-      rsq = delx*delx + dely*dely + delz*delz;
-
-      if (rsq < cutforcesq) {
-        jtype = type[j];
-        p = sqrt(rsq)*rdr + 1.0;
-        m = static_cast<int> (p);
-        m = MIN(m,nr-1);
-        p -= m;
-        p = MIN(p,1.0);
-        coeff = rhor_spline[type2rhor[jtype][itype]][m];
-        rho[i] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
-        if (newton_pair || j < nlocal) {
-          coeff = rhor_spline[type2rhor[itype][jtype]][m];
-          rho[j] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+  // use single precision pairwise terms if enabled via pair_modify precision
+  // use contiguous coordinate streams if enabled via atom_modify soa
+
+  if (precision != PREC_DOUBLE) {
+    xfloat_pack();
+    if (precision == PREC_MIXED) density_kernel<float,double>(PosFloat(xfloat));
+    else density_kernel<float,float>(PosFloat(xfloat));
+  } else if (atom->soa_flag) {
+    atom->soa_pack();
+    density_kernel<double,double>(PosSoA(atom->x_soa));
+  } else {
+    for (ii = 0; ii < inum; ii++) {
+      i = ilist[ii];
+      xtmp = x[i][0];
+      ytmp = x[i][1];
+      ztmp = x[i][2];
+      itype = type[i];
+      jlist = firstneigh[i];
+      jnum = numneigh[i];
+
+      for (jj = 0; jj < jnum; jj++) {
+        j = jlist[jj];
+        j &= NEIGHMASK;
+
+        delx = xtmp - x[j][0];
+        dely = ytmp - x[j][1];
+        delz = ztmp - x[j][2];
+        rsq = delx*delx + dely*dely + delz*delz;
+
+        if (rsq < cutforcesq) {
+          jtype = type[j];
+          p = sqrt(rsq)*rdr + 1.0;
+          m = static_cast<int> (p);
+          m = MIN(m,nr-1);
+          p -= m;
+          p = MIN(p,1.0);
+          coeff = rhor_spline[type2rhor[jtype][itype]][m];
+          rho[i] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+          if (newton_pair || j < nlocal) {
+            coeff = rhor_spline[type2rhor[itype][jtype]][m];
+            rho[j] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+          }
         }
       }
     }
@@ -257,12 +269,217 @@ void PairEAM::compute(int eflag, int vflag)
   // compute forces on each atom
   // loop over neighbors of my atoms
 
+  if (precision != PREC_DOUBLE) {
+    if (precision == PREC_MIXED) force_kernel<float,double>(PosFloat(xfloat));
+    else force_kernel<float,float>(PosFloat(xfloat));
+  } else if (atom->soa_flag) {
+    force_kernel<double,double>(PosSoA(atom->x_soa));
+  } else {
+    for (ii = 0; ii < inum; ii++) {
+      i = ilist[ii];
+      xtmp = x[i][0];
+      ytmp = x[i][1];
+      ztmp = x[i][2];
+      itype = type[i];
+
+      jlist = firstneigh[i];
+      jnum = numneigh[i];
+      numforce[i] = 0;
+
+      for (jj = 0; jj < jnum; jj++) {
+        j = jlist[jj];
+        j &= NEIGHMASK;
+
+        delx = xtmp - x[j][0];
+        dely = ytmp - x[j][1];
+        delz = ztmp - x[j][2];
+        rsq = delx*delx + dely*dely + delz*delz;
+
+        if (rsq < cutforcesq) {
+          ++numforce[i];
+          jtype = type[j];
+          r = sqrt(rsq);
+          p = r*rdr + 1.0;
+          m = static_cast<int> (p);
+          m = MIN(m,nr-1);
+          p -= m;
+          p = MIN(p,1.0);
+
+          // rhoip = derivative of (density at atom j due to atom i)
+          // rhojp = derivative of (density at atom i due to atom j)
+          // phi = pair potential energy
+          // phip = phi'
+          // z2 = phi * r
+          // z2p = (phi * r)' = (phi' r) + phi
+          // psip needs both fp[i] and fp[j] terms since r_ij appears in two
+          //   terms of embed eng: Fi(sum rho_ij) and Fj(sum rho_ji)
+          //   hence embed' = Fi(sum rho_ij) rhojp + Fj(sum rho_ji) rhoip
+          // scale factor can be applied by thermodynamic integration
+
+          coeff = rhor_spline[type2rhor[itype][jtype]][m];
+          rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
+          coeff = rhor_spline[type2rhor[jtype][itype]][m];
+          rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
+          coeff = z2r_spline[type2z2r[itype][jtype]][m];
+          z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
+          z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+
+          recip = 1.0/r;
+          phi = z2*recip;
+          phip = z2p*recip - phi*recip;
+          psip = fp[i]*rhojp + fp[j]*rhoip + phip;
+          fpair = -scale[itype][jtype]*psip*recip;
+
+          f[i][0] += delx*fpair;
+          f[i][1] += dely*fpair;
+          f[i][2] += delz*fpair;
+          if (newton_pair || j < nlocal) {
+            f[j][0] -= delx*fpair;
+            f[j][1] -= dely*fpair;
+            f[j][2] -= delz*fpair;
+          }
+
+          if (eflag) evdwl = scale[itype][jtype]*phi;
+          if (evflag) ev_tally(i,j,nlocal,newton_pair,evdwl,0.0,fpair,delx,dely,delz);
+        }
+      }
+    }
+  }
+
+  if (eflag && (!exceeded_rhomax)) {
+    MPI_Allreduce(&beyond_rhomax, &exceeded_rhomax, 1, MPI_INT, MPI_SUM, world);
+    if (exceeded_rhomax) {
+      if (comm->me == 0)
+        error->warning(FLERR,
+                       "A per-atom density exceeded rhomax of EAM potential table - "
+                       "a linear extrapolation to the energy was made");
+    }
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   accumulate densities at each atom
+   flt_t = precision of the pairwise terms
+   acc_t = precision of the accumulated density at each atom i
+   pos_t = accessor of the atom coordinates, see PosSoA and PosFloat
+------------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t, class pos_t>
+void PairEAM::density_kernel(const pos_t &pos)
+{
+  int i,j,ii,jj,m,jnum,itype,jtype;
+  flt_t xtmp,ytmp,ztmp,delx,dely,delz,rsq,p;
+  double *coeff;
+  acc_t rhotmp;
+  int *jlist;
+
+  const int *const type = atom->type;
+  const int nlocal = atom->nlocal;
+  const int newton_pair = force->newton_pair;
+  const flt_t cutforcesqf = cutforcesq;
+  const flt_t rdrf = rdr;
+
+  const int inum = list->inum;
+  const int *const ilist = list->ilist;
+  const int *const numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = pos.x(i);
+    ytmp = pos.y(i);
+    ztmp = pos.z(i);
+    itype = type[i];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    rhotmp = 0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+
+      delx = xtmp - pos.x(j);
+      dely = ytmp - pos.y(j);
+      delz = ztmp - pos.z(j);
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq < cutforcesqf) {
+        jtype = type[j];
+        p = std::sqrt(rsq)*rdrf + (flt_t) 1.0;
+        m = static_cast<int> (p);
+        m = MIN(m,nr-1);
+        p -= m;
+        p = MIN(p,(flt_t) 1.0);
+        coeff = rhor_spline[type2rhor[jtype][itype]][m];
+        rhotmp += (((flt_t) coeff[3]*p + (flt_t) coeff[4])*p + (flt_t) coeff[5])*p +
+          (flt_t) coeff[6];
+        if (newton_pair || j < nlocal) {
+          coeff = rhor_spline[type2rhor[itype][jtype]][m];
+          rho[j] += (((flt_t) coeff[3]*p + (flt_t) coeff[4])*p + (flt_t) coeff[5])*p +
+            (flt_t) coeff[6];
+        }
+      }
+    }
+    rho[i] += rhotmp;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t, class pos_t>
+void PairEAM::force_kernel(const pos_t &pos)
+{
+  if (evflag) {
+    if (eflag_either) {
+      if (force->newton_pair) eval_force_kernel<flt_t,acc_t,pos_t,1,1,1>(pos);
+      else eval_force_kernel<flt_t,acc_t,pos_t,1,1,0>(pos);
+    } else {
+      if (force->newton_pair) eval_force_kernel<flt_t,acc_t,pos_t,1,0,1>(pos);
+      else eval_force_kernel<flt_t,acc_t,pos_t,1,0,0>(pos);
+    }
+  } else {
+    if (force->newton_pair) eval_force_kernel<flt_t,acc_t,pos_t,0,0,1>(pos);
+    else eval_force_kernel<flt_t,acc_t,pos_t,0,0,0>(pos);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compute pairwise and embedding forces
+   coordinates were packed before density_kernel() and have not changed
+------------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t, class pos_t, int EVFLAG, int EFLAG, int NEWTON_PAIR>
+void PairEAM::eval_force_kernel(const pos_t &pos)
+{
+  int i,j,ii,jj,m,jnum,itype,jtype;
+  flt_t xtmp,ytmp,ztmp,delx,dely,delz,fpair;
+  flt_t rsq,r,p,rhoip,rhojp,z2,z2p,recip,phip,psip,phi,fpi;
+  flt_t evdwl = 0.0;
+  acc_t fxtmp,fytmp,fztmp;
+  double *coeff;
+  int *jlist;
+
+  double **f = atom->f;
+  const int *const type = atom->type;
+  const int nlocal = atom->nlocal;
+  const flt_t cutforcesqf = cutforcesq;
+  const flt_t rdrf = rdr;
+
+  const int inum = list->inum;
+  const int *const ilist = list->ilist;
+  const int *const numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
   for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
-    xtmp = x[i][0];
-    ytmp = x[i][1];
-    ztmp = x[i][2];
+    xtmp = pos.x(i);
+    ytmp = pos.y(i);
+    ztmp = pos.z(i);
     itype = type[i];
+    fpi = fp[i];
+    fxtmp = fytmp = fztmp = 0.0;
 
     jlist = firstneigh[i];
     jnum = numneigh[i];
@@ -272,72 +489,53 @@ void PairEAM::compute(int eflag, int vflag)
       j = jlist[jj];
       j &= NEIGHMASK;
 
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
+      delx = xtmp - pos.x(j);
+      dely = ytmp - pos.y(j);
+      delz = ztmp - pos.z(j);
       rsq = delx*delx + dely*dely + delz*delz;
 
-      if (rsq < cutforcesq) {
+      if (rsq < cutforcesqf) {
         ++numforce[i];
         jtype = type[j];
-        r = sqrt(rsq);
-        p = r*rdr + 1.0;
+        r = std::sqrt(rsq);
+        p = r*rdrf + (flt_t) 1.0;
         m = static_cast<int> (p);
         m = MIN(m,nr-1);
         p -= m;
-        p = MIN(p,1.0);
-
-        // rhoip = derivative of (density at atom j due to atom i)
-        // rhojp = derivative of (density at atom i due to atom j)
-        // phi = pair potential energy
-        // phip = phi'
-        // z2 = phi * r
-        // z2p = (phi * r)' = (phi' r) + phi
-        // psip needs both fp[i] and fp[j] terms since r_ij appears in two
-        //   terms of embed eng: Fi(sum rho_ij) and Fj(sum rho_ji)
-        //   hence embed' = Fi(sum rho_ij) rhojp + Fj(sum rho_ji) rhoip
-        // scale factor can be applied by thermodynamic integration
+        p = MIN(p,(flt_t) 1.0);
 
         coeff = rhor_spline[type2rhor[itype][jtype]][m];
-        rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
+        rhoip = ((flt_t) coeff[0]*p + (flt_t) coeff[1])*p + (flt_t) coeff[2];
         coeff = rhor_spline[type2rhor[jtype][itype]][m];
-        rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
+        rhojp = ((flt_t) coeff[0]*p + (flt_t) coeff[1])*p + (flt_t) coeff[2];
         coeff = z2r_spline[type2z2r[itype][jtype]][m];
-        z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
-        z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+        z2p = ((flt_t) coeff[0]*p + (flt_t) coeff[1])*p + (flt_t) coeff[2];
+        z2 = (((flt_t) coeff[3]*p + (flt_t) coeff[4])*p + (flt_t) coeff[5])*p +
+          (flt_t) coeff[6];
 
-        recip = 1.0/r;
+        recip = (flt_t) 1.0/r;
         phi = z2*recip;
         phip = z2p*recip - phi*recip;
-        psip = fp[i]*rhojp + fp[j]*rhoip + phip;
-        fpair = -scale[itype][jtype]*psip*recip;
+        psip = fpi*rhojp + (flt_t) fp[j]*rhoip + phip;
+        fpair = -(flt_t) scale[itype][jtype]*psip*recip;
 
-        f[i][0] += delx*fpair;
-        f[i][1] += dely*fpair;
-        f[i][2] += delz*fpair;
-        if (newton_pair || j < nlocal) {
+        fxtmp += delx*fpair;
+        fytmp += dely*fpair;
+        fztmp += delz*fpair;
+        if (NEWTON_PAIR || j < nlocal) {
           f[j][0] -= delx*fpair;
           f[j][1] -= dely*fpair;
           f[j][2] -= delz*fpair;
         }
 
-        if (eflag) evdwl = scale[itype][jtype]*phi;
-        if (evflag) ev_tally(i,j,nlocal,newton_pair,evdwl,0.0,fpair,delx,dely,delz);
+        if (EFLAG) evdwl = (flt_t) scale[itype][jtype]*phi;
+        if (EVFLAG) ev_tally(i,j,nlocal,NEWTON_PAIR,evdwl,0.0,fpair,delx,dely,delz);
       }
     }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
   }
-
-  if (eflag && (!exceeded_rhomax)) {
-    MPI_Allreduce(&beyond_rhomax, &exceeded_rhomax, 1, MPI_INT, MPI_SUM, world);
-    if (exceeded_rhomax) {
-      if (comm->me == 0)
-        error->warning(FLERR,
-                       "A per-atom density exceeded rhomax of EAM potential table - "
-                       "a linear extrapolation to the energy was made");
-    }
-  }
-
-  if (vflag_fdotr) virial_fdotr_compute();
 }
 
 /* ----------------------------------------------------------------------
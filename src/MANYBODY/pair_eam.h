@@ -105,7 +105,28 @@ class PairEAM : public Pair {
   };
   Fs *fs;
 
+  // coordinate accessors of the templated density and force kernels
+
+  struct PosSoA {
+    const double *xs, *ys, *zs;
+    explicit PosSoA(double **x_soa) : xs(x_soa[0]), ys(x_soa[1]), zs(x_soa[2]) {}
+    double x(int i) const { return xs[i]; }
+    double y(int i) const { return ys[i]; }
+    double z(int i) const { return zs[i]; }
+  };
+  struct PosFloat {
+    const float *xf;
+    explicit PosFloat(const float *_xf) : xf(_xf) {}
+    float x(int i) const { return xf[4 * i]; }
+    float y(int i) const { return xf[4 * i + 1]; }
+    float z(int i) const { return xf[4 * i + 2]; }
+  };
+
   virtual void allocate();
+  template <class flt_t, class acc_t, class pos_t> void density_kernel(const pos_t &);
+  template <class flt_t, class acc_t, class pos_t> void force_kernel(const pos_t &);
+  template <class flt_t, class acc_t, class pos_t, int EVFLAG, int EFLAG, int NEWTON_PAIR>
+  void eval_force_kernel(const pos_t &);
   virtual void array2spline();
   void interpolate(int, double, double *, double **);
 
@@ -39,6 +39,7 @@ PairEAMCD::PairEAMCD(LAMMPS *lmp, int _cdeamVersion)
 {
   single_enable = 0;
   restartinfo = 0;
+  precision_enable = 0;
   unit_convert_flag = utils::get_supported_conversions(utils::ENERGY);
 
   rhoB = nullptr;
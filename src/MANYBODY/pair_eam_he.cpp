@@ -33,6 +33,7 @@ using namespace LAMMPS_NS;
 PairEAMHE::PairEAMHE(LAMMPS *lmp) : PairEAM(lmp), PairEAMFS(lmp)
 {
   he_flag = 1;
+  precision_enable = 0;
 }
 
 void PairEAMHE::compute(int eflag, int vflag)
@@ -62,7 +62,7 @@ static int get_tid()
 FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
   :  Fix(lmp, narg, arg),
      thr(nullptr), last_omp_style(nullptr), last_pair_hybrid(nullptr),
-     _nthr(-1), _neighbor(true), _mixed(false), _reduced(true),
+     _nthr(-1), _neighbor(true), _mixed(false), _reduced(true), _dynamic(false),
      _pair_compute_flag(false), _kspace_compute_flag(false)
 {
   if (narg < 4) error->all(FLERR,"Illegal package omp command");
@@ -100,6 +100,12 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
       _neighbor = utils::logical(FLERR,arg[iarg+1],false,lmp) != 0;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"schedule") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
+      if (strcmp(arg[iarg+1],"static") == 0) _dynamic = false;
+      else if (strcmp(arg[iarg+1],"dynamic") == 0) _dynamic = true;
+      else error->all(FLERR,"Illegal package omp schedule value: {}", arg[iarg+1]);
+      iarg += 2;
     } else error->all(FLERR,"Illegal package omp command");
   }
 
@@ -112,6 +118,8 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
     if (reset_thr)
       utils::logmesg(lmp, "set {} OpenMP thread(s) per MPI task\n", nthreads);
     utils::logmesg(lmp, "using {} neighbor list subroutines\n", nmode);
+    if (_dynamic)
+      utils::logmesg(lmp, "using dynamic cost-weighted scheduling of pair loops\n");
 #else
     error->warning(FLERR,"OpenMP support not enabled during compilation; "
                          "using 1 thread only.");
@@ -32,6 +32,8 @@ PairBuckOMP::PairBuckOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  cluster_enable = 0;
+  overlap_enable = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -35,6 +35,7 @@ PairEAMOMP::PairEAMOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  precision_enable = 0;
 }
 
 /* ---------------------------------------------------------------------- */
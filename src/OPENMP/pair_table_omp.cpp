@@ -31,6 +31,7 @@ PairTableOMP::PairTableOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  precision_enable = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -345,6 +345,15 @@ void PPPMOMP::make_rho()
   const int nlocal = atom->nlocal;
   if (nlocal == 0) return;
 
+  // use a kernel with fixed stencil size, if available
+
+  switch (order) {
+    case 4: make_rho_thr<4>(); return;
+    case 5: make_rho_thr<5>(); return;
+    case 6: make_rho_thr<6>(); return;
+    case 7: make_rho_thr<7>(); return;
+  }
+
   const int ix = nxhi_out - nxlo_out + 1;
   const int iy = nyhi_out - nylo_out + 1;
 
@@ -417,6 +426,90 @@ void PPPMOMP::make_rho()
   }
 }
 
+/* ----------------------------------------------------------------------
+   same as make_rho() for a stencil of ORDER points in each dimension
+   rows of the stencil that are entirely in the part of the grid
+     of a thread are done with a fixed loop count
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+void PPPMOMP::make_rho_thr()
+{
+  FFT_SCALAR * _noalias const d = &(density_brick[nzlo_out][nylo_out][nxlo_out]);
+  const int nlocal = atom->nlocal;
+  const int ix = nxhi_out - nxlo_out + 1;
+  const int iy = nyhi_out - nylo_out + 1;
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE
+#endif
+  {
+    const double * _noalias const q = atom->q;
+    const auto * _noalias const x = (dbl3_t *) atom->x[0];
+    const auto * _noalias const p2g = (int3_t *) part2grid[0];
+
+    const double boxlox = boxlo[0];
+    const double boxloy = boxlo[1];
+    const double boxloz = boxlo[2];
+
+    // determine range of grid points handled by this thread
+    int i,jfrom,jto,tid;
+    loop_setup_thr(jfrom,jto,tid,ngrid,comm->nthreads);
+
+    // get per thread data
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+
+    FFT_SCALAR coeff[ORDER*ORDER];
+    FFT_SCALAR rx[ORDER],ry[ORDER],rz[ORDER];
+    rho_coeff_order(coeff);
+
+    for (i = 0; i < nlocal; i++) {
+
+      const int nx = p2g[i].a;
+      const int ny = p2g[i].b;
+      const int nz = p2g[i].t;
+
+      // pre-screen whether this atom will ever come within
+      // reach of the data segement this thread is updating.
+      if ( ((nz+nlower-nzlo_out)*ix*iy >= jto)
+           || ((nz+nupper-nzlo_out+1)*ix*iy < jfrom) ) continue;
+
+      const FFT_SCALAR dx = nx+shiftone - (x[i].x-boxlox)*delxinv;
+      const FFT_SCALAR dy = ny+shiftone - (x[i].y-boxloy)*delyinv;
+      const FFT_SCALAR dz = nz+shiftone - (x[i].z-boxloz)*delzinv;
+
+      compute_rho1d_order<ORDER>(coeff,dx,rx);
+      compute_rho1d_order<ORDER>(coeff,dy,ry);
+      compute_rho1d_order<ORDER>(coeff,dz,rz);
+
+      const FFT_SCALAR z0 = delvolinv * q[i];
+
+      for (int n = 0; n < ORDER; ++n) {
+        const int jn = (nz+nlower+n-nzlo_out)*ix*iy;
+        const FFT_SCALAR y0 = z0*rz[n];
+
+        for (int m = 0; m < ORDER; ++m) {
+          const int jm = jn+(ny+nlower+m-nylo_out)*ix+nx+nlower-nxlo_out;
+          const FFT_SCALAR x0 = y0*ry[m];
+
+          if ((jm >= jfrom) && (jm+ORDER <= jto)) {
+            for (int l = 0; l < ORDER; ++l) d[jm+l] += x0*rx[l];
+          } else {
+            for (int l = 0; l < ORDER; ++l) {
+              const int jl = jm+l;
+              if (jl >= jto) break;
+              if (jl < jfrom) continue;
+              d[jl] += x0*rx[l];
+            }
+          }
+        }
+      }
+    }
+    thr->timer(Timer::KSPACE);
+  }
+}
+
 /* ----------------------------------------------------------------------
    interpolate from grid to get electric field & force on my particles for ik
 ------------------------------------------------------------------------- */
@@ -436,6 +529,15 @@ void PPPMOMP::fieldforce_ik()
 
   if (nlocal == 0) return;
 
+  // use a kernel with fixed stencil size, if available
+
+  switch (order) {
+    case 4: fieldforce_ik_thr<4>(); return;
+    case 5: fieldforce_ik_thr<5>(); return;
+    case 6: fieldforce_ik_thr<6>(); return;
+    case 7: fieldforce_ik_thr<7>(); return;
+  }
+
   const auto * _noalias const x = (dbl3_t *) atom->x[0];
   const double * _noalias const q = atom->q;
   const auto * _noalias const p2g = (int3_t *) part2grid[0];
@@ -498,6 +600,88 @@ void PPPMOMP::fieldforce_ik()
   } // end of parallel region
 }
 
+/* ----------------------------------------------------------------------
+   same as fieldforce_ik() for a stencil of ORDER points in each dimension
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+void PPPMOMP::fieldforce_ik_thr()
+{
+  const int nthreads = comm->nthreads;
+  const int nlocal = atom->nlocal;
+
+  const auto * _noalias const x = (dbl3_t *) atom->x[0];
+  const double * _noalias const q = atom->q;
+  const auto * _noalias const p2g = (int3_t *) part2grid[0];
+
+  const double qqrd2e = force->qqrd2e;
+  const double boxlox = boxlo[0];
+  const double boxloy = boxlo[1];
+  const double boxloz = boxlo[2];
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE
+#endif
+  {
+    int i,ifrom,ito,tid;
+
+    loop_setup_thr(ifrom,ito,tid,nlocal,nthreads);
+
+    // get per thread data
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+    auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
+
+    FFT_SCALAR coeff[ORDER*ORDER];
+    FFT_SCALAR rx[ORDER],ry[ORDER],rz[ORDER];
+    rho_coeff_order(coeff);
+
+    for (i = ifrom; i < ito; ++i) {
+      const int nx = p2g[i].a;
+      const int ny = p2g[i].b;
+      const int nz = p2g[i].t;
+      const FFT_SCALAR dx = nx+shiftone - (x[i].x-boxlox)*delxinv;
+      const FFT_SCALAR dy = ny+shiftone - (x[i].y-boxloy)*delyinv;
+      const FFT_SCALAR dz = nz+shiftone - (x[i].z-boxloz)*delzinv;
+
+      compute_rho1d_order<ORDER>(coeff,dx,rx);
+      compute_rho1d_order<ORDER>(coeff,dy,ry);
+      compute_rho1d_order<ORDER>(coeff,dz,rz);
+
+      const int mx = nx+nlower;
+      const int my = ny+nlower;
+      const int mz = nz+nlower;
+      FFT_SCALAR ekx = ZEROF;
+      FFT_SCALAR eky = ZEROF;
+      FFT_SCALAR ekz = ZEROF;
+
+      for (int n = 0; n < ORDER; n++) {
+        const FFT_SCALAR z0 = rz[n];
+        for (int m = 0; m < ORDER; m++) {
+          const FFT_SCALAR y0 = z0*ry[m];
+          const FFT_SCALAR * _noalias const xrow = &vdx_brick[mz+n][my+m][mx];
+          const FFT_SCALAR * _noalias const yrow = &vdy_brick[mz+n][my+m][mx];
+          const FFT_SCALAR * _noalias const zrow = &vdz_brick[mz+n][my+m][mx];
+          for (int l = 0; l < ORDER; l++) {
+            const FFT_SCALAR x0 = y0*rx[l];
+            ekx -= x0*xrow[l];
+            eky -= x0*yrow[l];
+            ekz -= x0*zrow[l];
+          }
+        }
+      }
+
+      // convert E-field to force
+
+      const double qfactor = qqrd2e * scale * q[i];
+      f[i].x += qfactor*ekx;
+      f[i].y += qfactor*eky;
+      if (slabflag != 2) f[i].z += qfactor*ekz;
+    }
+    thr->timer(Timer::KSPACE);
+  } // end of parallel region
+}
+
 /* ----------------------------------------------------------------------
    interpolate from grid to get electric field & force on my particles for ad
 ------------------------------------------------------------------------- */
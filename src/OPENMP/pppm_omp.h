@@ -43,6 +43,8 @@ class PPPMOMP : public PPPM, public ThrOMP {
   void fieldforce_peratom() override;
 
  private:
+  template <int ORDER> void make_rho_thr();
+  template <int ORDER> void fieldforce_ik_thr();
   void compute_rho1d_thr(FFT_SCALAR *const *const, const FFT_SCALAR &, const FFT_SCALAR &,
                          const FFT_SCALAR &);
   void compute_drho1d_thr(FFT_SCALAR *const *const, const FFT_SCALAR &, const FFT_SCALAR &,
@@ -29,6 +29,7 @@
 #include "improper.h"
 #include "math_const.h"
 #include "modify.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "pair.h"
 
@@ -41,9 +42,22 @@
 using namespace LAMMPS_NS;
 using MathConst::THIRD;
 
+// chunks per thread for the dynamic schedule, and the cost of an atom
+// in the neighbor list relative to that of one of its neighbors
+
+static constexpr int SCHED_CHUNKS = 8;
+static constexpr int SCHED_OVERHEAD = 4;
+
+// forces written by a thread are tracked in blocks of 2^SCHED_SHIFT atoms
+
+static constexpr int SCHED_SHIFT = 6;
+static constexpr int SCHED_BLOCK = 1 << SCHED_SHIFT;
+
 /* ---------------------------------------------------------------------- */
 
-ThrOMP::ThrOMP(LAMMPS *ptr, int style) : lmp(ptr), fix(nullptr), thr_style(style), thr_error(0)
+ThrOMP::ThrOMP(LAMMPS *ptr, int style) :
+    lmp(ptr), fix(nullptr), thr_style(style), thr_error(0), sched_active(0), sched_next(0),
+    sched_nall(-1), sched_nblock(0), sched_stamp(-1), sched_list(nullptr)
 {
   // register fix omp with this class
   fix = static_cast<FixOMP *>(lmp->modify->get_fix_by_id("package_omp"));
@@ -444,7 +458,14 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
 
   if (style == fix->last_omp_style) {
     if (need_force_reduce) {
-      data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
+
+      // with the dynamic schedule a plain pair style knows which atoms each
+      // thread has written to, provided no other style used the per thread forces
+
+      if (sched_active && (thr_style == THR_PAIR) && (fix->last_pair_hybrid == nullptr))
+        sparse_reduce_thr(&(f[0][0]), nall, nthreads, tid);
+      else
+        data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
       fix->did_reduce();
     }
 
@@ -454,6 +475,157 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
   thr->timer(Timer::COMM);
 }
 
+/* ----------------------------------------------------------------------
+   set up dynamic scheduling of the loop over a neighbor list
+   the list is split into chunks of about equal cost, estimated from the
+   number of neighbors, and threads claim chunks until none are left.
+   chunks and the blocks of atoms each chunk writes forces to are only
+   recomputed after a full or partial build of the neighbor list.
+   must be called outside of the threaded region.
+   ---------------------------------------------------------------------- */
+
+void ThrOMP::loop_schedule_thr(NeighList *const list)
+{
+  const int nthreads = lmp->comm->nthreads;
+  const int nall = lmp->atom->nlocal + lmp->atom->nghost;
+
+  sched_active = 0;
+  if (!fix->get_dynamic() || (nthreads < 2) || !list) return;
+
+  if ((list != sched_list) || (list->stamp != sched_stamp) || (nall != sched_nall)) {
+    sched_list = list;
+    sched_stamp = list->stamp;
+    sched_nall = nall;
+    sched_nblock = (nall >> SCHED_SHIFT) + 1;
+
+    const int inum = list->inum;
+    const int * const ilist = list->ilist;
+    const int * const numneigh = list->numneigh;
+    int ** const firstneigh = list->firstneigh;
+
+    double cost = 0.0;
+    for (int ii = 0; ii < inum; ++ii) cost += numneigh[ilist[ii]] + SCHED_OVERHEAD;
+    const double target = cost / (nthreads * SCHED_CHUNKS);
+
+    sched_chunk.assign(1, 0);
+    cost = 0.0;
+    for (int ii = 0; ii < inum; ++ii) {
+      cost += numneigh[ilist[ii]] + SCHED_OVERHEAD;
+      if ((cost >= target * sched_chunk.size()) && (ii + 1 < inum)) sched_chunk.push_back(ii + 1);
+    }
+    sched_chunk.push_back(inum);
+
+    // collect the blocks of atoms each chunk can write forces to
+
+    const int nchunk = sched_chunk.size() - 1;
+    const int nblock = sched_nblock;
+    sched_blocks.resize(nchunk);
+
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+    {
+      std::vector<int> mark(nblock, -1);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+      for (int c = 0; c < nchunk; ++c) {
+        auto &blocks = sched_blocks[c];
+        blocks.clear();
+        for (int ii = sched_chunk[c]; ii < sched_chunk[c + 1]; ++ii) {
+          const int i = ilist[ii];
+          const int * const jlist = firstneigh[i];
+          const int jnum = numneigh[i];
+          int b = i >> SCHED_SHIFT;
+          if (mark[b] != c) {
+            mark[b] = c;
+            blocks.push_back(b);
+          }
+          for (int jj = 0; jj < jnum; ++jj) {
+            b = (jlist[jj] & NEIGHMASK) >> SCHED_SHIFT;
+            if (mark[b] != c) {
+              mark[b] = c;
+              blocks.push_back(b);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  sched_touched.assign((size_t) nthreads * sched_nblock, 0);
+  sched_next = 0;
+  sched_active = 1;
+}
+
+/* ----------------------------------------------------------------------
+   hand out the next range of the neighbor list loop to a thread
+   ichunk must be initialized to -1 before the first call of a thread
+   returns false when there is no work left
+   ---------------------------------------------------------------------- */
+
+bool ThrOMP::loop_next_thr(int &ifrom, int &ito, int &ichunk, ThrData *const thr)
+{
+  // static schedule: the range set by loop_setup_thr() is the only chunk
+
+  if (!sched_active) return (ichunk++ < 0);
+
+  int c;
+#if defined(_OPENMP)
+#pragma omp atomic capture
+#endif
+  c = sched_next++;
+
+  if (c >= (int) sched_blocks.size()) return false;
+
+  ichunk = c;
+  ifrom = sched_chunk[c];
+  ito = sched_chunk[c + 1];
+
+  char *touched = sched_touched.data() + (size_t) thr->get_tid() * sched_nblock;
+  for (const int b : sched_blocks[c]) touched[b] = 1;
+  return true;
+}
+
+/* ----------------------------------------------------------------------
+   reduce per thread forces into the forces of thread 0, but only for
+   the blocks of atoms that the other threads have written to.
+   the remaining per thread forces are still zero from init_force().
+   ---------------------------------------------------------------------- */
+
+void ThrOMP::sparse_reduce_thr(double *dall, int nall, int nthreads, int tid)
+{
+#if defined(_OPENMP)
+  // NOOP in single-threaded execution.
+  if (nthreads == 1) return;
+#pragma omp barrier
+  {
+    const int nvals = 3 * nall;
+    const int nblock = sched_nblock;
+    const int idelta = nblock / nthreads + 1;
+    const int bfrom = tid * idelta;
+    const int bto = ((bfrom + idelta) > nblock) ? nblock : (bfrom + idelta);
+
+    for (int n = 1; n < nthreads; ++n) {
+      const char * const touched = sched_touched.data() + (size_t) n * nblock;
+      double * const dthr = dall + (size_t) n * nvals;
+      for (int b = bfrom; b < bto; ++b) {
+        if (!touched[b]) continue;
+        const int mfrom = 3 * b * SCHED_BLOCK;
+        const int mto = ((mfrom + 3 * SCHED_BLOCK) > nvals) ? nvals : (mfrom + 3 * SCHED_BLOCK);
+        for (int m = mfrom; m < mto; ++m) {
+          dall[m] += dthr[m];
+          dthr[m] = 0.0;
+        }
+      }
+    }
+  }
+#else
+  // NOOP in non-threaded execution.
+  return;
+#endif
+}
+
 /* ----------------------------------------------------------------------
    tally eng_vdwl and eng_coul into per thread global and per-atom accumulators
 ------------------------------------------------------------------------- */
@@ -1623,5 +1795,9 @@ double ThrOMP::memory_usage_thr()
 {
   double bytes=0.0;
 
+  bytes += (double)sched_chunk.capacity() * sizeof(int);
+  for (const auto &blocks : sched_blocks) bytes += (double)blocks.capacity() * sizeof(int);
+  bytes += (double)sched_touched.capacity();
+
   return bytes;
 }
@@ -26,6 +26,8 @@
 #include "pointers.h"
 #include "thr_data.h"    // IWYU pragma: export
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 // forward declarations
@@ -34,6 +36,7 @@ class Bond;
 class Angle;
 class Dihedral;
 class Improper;
+class NeighList;
 
 class ThrOMP {
 
@@ -84,6 +87,13 @@ class ThrOMP {
   // reduce per thread data as needed
   void reduce_thr(void *const style, const int eflag, const int vflag, ThrData *const thr);
 
+  // dynamic scheduling of the loop over a neighbor list, if enabled.
+  // loop_schedule_thr() must be called outside the parallel region,
+  // loop_next_thr() hands out chunks to the calling thread until done.
+  // with the static schedule it returns the range from loop_setup_thr() once.
+  void loop_schedule_thr(NeighList *const list);
+  bool loop_next_thr(int &ifrom, int &ito, int &ichunk, ThrData *const thr);
+
   // thread safe variant error abort support.
   // signals an error condition in any thread by making
   // thr_error > 0, if condition "cond" is true.
@@ -182,6 +192,20 @@ class ThrOMP {
   // style independent versions
   void ev_tally_list_thr(Pair *const, const int, const int *const, const double *const,
                          const double, const double, ThrData *const);
+
+ private:
+  // force reduction restricted to the blocks of atoms written by each thread
+  void sparse_reduce_thr(double *, int, int, int);
+
+  int sched_active;                            // 1 if dynamic schedule is used in this call
+  int sched_next;                              // next chunk to be handed out
+  int sched_nall;                              // # of local+ghost atoms for the chunks
+  int sched_nblock;                            // # of blocks of atoms
+  bigint sched_stamp;                          // list->stamp of the build the chunks belong to
+  NeighList *sched_list;                       // neighbor list the chunks belong to
+  std::vector<int> sched_chunk;                // first ilist index of each chunk + end
+  std::vector<std::vector<int>> sched_blocks;  // blocks of atoms written by each chunk
+  std::vector<char> sched_touched;             // per thread flags of blocks written to
 };
 
 // set loop range thread id, and force array offset for threaded runs.
@@ -35,7 +35,10 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-PairEAMOpt::PairEAMOpt(LAMMPS *lmp) : PairEAM(lmp) {}
+PairEAMOpt::PairEAMOpt(LAMMPS *lmp) : PairEAM(lmp)
+{
+  precision_enable = 0;
+}
 
 /* ---------------------------------------------------------------------- */
 
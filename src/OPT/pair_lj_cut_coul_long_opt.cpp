@@ -29,6 +29,9 @@ using namespace EwaldConst;
 PairLJCutCoulLongOpt::PairLJCutCoulLongOpt(LAMMPS *lmp) : PairLJCutCoulLong(lmp)
 {
   respa_enable = 0;
+  cluster_enable = 0;
+  overlap_enable = 0;
+  precision_enable = 0;
 }
 
 /* ---------------------------------------------------------------------- */
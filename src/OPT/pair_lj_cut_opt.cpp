@@ -29,7 +29,12 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-PairLJCutOpt::PairLJCutOpt(LAMMPS *lmp) : PairLJCut(lmp) {}
+PairLJCutOpt::PairLJCutOpt(LAMMPS *lmp) : PairLJCut(lmp)
+{
+  cluster_enable = 0;
+  overlap_enable = 0;
+  precision_enable = 0;
+}
 
 /* ---------------------------------------------------------------------- */
 
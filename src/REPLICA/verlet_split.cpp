@@ -228,6 +228,8 @@ void VerletSplit::init()
   // see Axel email on this, also other TIP4P notes below
 
   if (tip4p_flag) error->all(FLERR,"Verlet/split does not yet support TIP4P");
+  if (force->kspace && (force->kspace->nevery > 1))
+    error->all(FLERR,"Verlet/split does not support kspace_modify every");
 
   Verlet::init();
 }
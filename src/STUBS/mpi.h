@@ -56,6 +56,8 @@
 
 #define MPI_ANY_SOURCE -1
 #define MPI_STATUS_IGNORE NULL
+#define MPI_STATUSES_IGNORE NULL
+#define MPI_REQUEST_NULL 0
 
 #define MPI_Comm int
 #define MPI_Request int
@@ -64,8 +66,11 @@
 #define MPI_Fint int
 #define MPI_Group int
 #define MPI_Offset long
+#define MPI_Info int
 
 #define MPI_IN_PLACE NULL
+#define MPI_UNWEIGHTED NULL
+#define MPI_INFO_NULL -1
 
 #define MPI_MAX_PROCESSOR_NAME 128
 #define MPI_MAX_LIBRARY_VERSION_STRING 128
@@ -105,8 +110,14 @@ int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, M
              MPI_Status *status);
 int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
               MPI_Request *request);
+int MPI_Send_init(const void *buf, int count, MPI_Datatype datatype, int dest, int tag,
+                  MPI_Comm comm, MPI_Request *request);
+int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+                  MPI_Request *request);
+int MPI_Startall(int n, MPI_Request *request);
 int MPI_Wait(MPI_Request *request, MPI_Status *status);
 int MPI_Waitall(int n, MPI_Request *request, MPI_Status *status);
+int MPI_Testall(int n, MPI_Request *request, int *flag, MPI_Status *status);
 int MPI_Waitany(int count, MPI_Request *request, int *index, MPI_Status *status);
 int MPI_Sendrecv(const void *sbuf, int scount, MPI_Datatype sdatatype, int dest, int stag,
                  void *rbuf, int rcount, MPI_Datatype rdatatype, int source, int rtag,
@@ -163,6 +174,16 @@ int MPI_Alltoall(void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recv
 int MPI_Alltoallv(void *sendbuf, int *sendcounts, int *sdispls, MPI_Datatype sendtype,
                   void *recvbuf, int *recvcounts, int *rdispls, MPI_Datatype recvtype,
                   MPI_Comm comm);
+
+int MPI_Dist_graph_create_adjacent(MPI_Comm comm_old, int indegree, const int *sources,
+                                   const int *sourceweights, int outdegree,
+                                   const int *destinations, const int *destweights,
+                                   MPI_Info info, int reorder, MPI_Comm *comm_dist_graph);
+int MPI_Neighbor_alltoall(void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf,
+                          int recvcount, MPI_Datatype recvtype, MPI_Comm comm);
+int MPI_Neighbor_alltoallv(void *sendbuf, int *sendcounts, int *sdispls, MPI_Datatype sendtype,
+                           void *recvbuf, int *recvcounts, int *rdispls, MPI_Datatype recvtype,
+                           MPI_Comm comm);
 /* ---------------------------------------------------------------------- */
 
 #endif
@@ -115,6 +115,7 @@ DumpVTK::DumpVTK(LAMMPS *lmp, int narg, char **arg) :
 
   myarrays.clear();
   n_calls_ = 0;
+  async_allow = 0;
 
   // process attributes
   // ioptional = start of additional optional args
@@ -38,7 +38,9 @@
 #include "library.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <vector>
 
 #ifdef LMP_GPU
 #include "fix_gpu.h"
@@ -103,9 +105,20 @@ Atom::Atom(LAMMPS *_lmp) : Pointers(_lmp), atom_style(nullptr), avec(nullptr), a
   sortfreq = 1000;
   nextsort = 0;
   userbinsize = 0.0;
+  sortorder = SORT_BINNED;
   maxbin = maxnext = 0;
   binhead = nullptr;
   next = permute = nullptr;
+  binrank = nullptr;
+  curvebits = 0;
+  ncurvex = ncurvey = ncurvez = 0;
+  maxsortkey = 0;
+  sortkey = nullptr;
+
+  soa_flag = 0;
+  nmax_soa = 0;
+  x_soa = nullptr;
+  soa_current = 0;
 
   // --------------------------------------------------------------------
   // 1st customization section: customize by adding new per-atom variables
@@ -296,6 +309,9 @@ Atom::~Atom()
   memory->destroy(binhead);
   memory->destroy(next);
   memory->destroy(permute);
+  memory->destroy(binrank);
+  memory->destroy(sortkey);
+  memory->destroy(x_soa);
 
   memory->destroy(tag);
   memory->destroy(type);
@@ -379,6 +395,8 @@ void Atom::settings(Atom *old)
   map_style = old->map_style;
   sortfreq = old->sortfreq;
   userbinsize = old->userbinsize;
+  sortorder = old->sortorder;
+  soa_flag = old->soa_flag;
   if (old->firstgroupname)
     firstgroupname = utils::strdup(old->firstgroupname);
 }
@@ -851,6 +869,22 @@ void Atom::modify_params(int narg, char **arg)
       if ((sortfreq >= 0) && firstgroupname)
         error->all(FLERR,"Atom_modify sort and first options cannot be used together");
       iarg += 3;
+    } else if (strcmp(arg[iarg],"sort/order") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "atom_modify sort/order", error);
+      if (strcmp(arg[iarg+1],"binned") == 0) sortorder = SORT_BINNED;
+      else if (strcmp(arg[iarg+1],"morton") == 0) sortorder = SORT_MORTON;
+      else if (strcmp(arg[iarg+1],"hilbert") == 0) sortorder = SORT_HILBERT;
+      else error->all(FLERR,"Illegal atom_modify sort/order argument {}", arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"soa") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "atom_modify soa", error);
+      soa_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (!soa_flag) {
+        memory->destroy(x_soa);
+        nmax_soa = 0;
+      }
+      soa_current = 0;
+      iarg += 2;
     } else error->all(FLERR,"Illegal atom_modify command argument: {}", arg[iarg]);
   }
 }
@@ -1042,11 +1076,15 @@ void Atom::deallocate_topology()
    unpack N lines from Atom section of data file
    call atom-style specific method to parse each line
    triclinic_general = 1 if data file defines a general triclinic box
+   distributed = 1 if each proc parses a different set of lines,
+     then keep all atoms inside the global box, caller migrates them
+     and errors are not collective
 ------------------------------------------------------------------------- */
 
 void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
                       int type_offset, int shiftflag, double *shift,
-                      int labelflag, int *ilabel, int triclinic_general)
+                      int labelflag, int *ilabel, int triclinic_general,
+                      int distributed)
 {
   int xptr,iptr;
   imageint imagedata;
@@ -1056,10 +1094,17 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   std::string typestr;
   auto location = "Atoms section of data file";
 
+  // errors cannot be collective if each proc parses different lines
+
+  auto fatal = [&](const std::string &mesg) {
+    if (distributed) error->one(FLERR, mesg);
+    error->all(FLERR, mesg);
+  };
+
   // use the first line to detect and validate the number of words/tokens per line
 
   next = strchr(buf,'\n');
-  if (!next) error->all(FLERR, "Missing data in {}", location);
+  if (!next) fatal(fmt::format("Missing data in {}", location));
   *next = '\0';
   auto values = Tokenizer(buf).as_vector();
   int nwords = values.size();
@@ -1071,8 +1116,8 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   }
 
   if ((nwords != avec->size_data_atom) && (nwords != avec->size_data_atom + 3))
-    error->all(FLERR,"Incorrect format in {}: {}{}", location,
-               utils::trim(buf), utils::errorurl(2));
+    fatal(fmt::format("Incorrect format in {}: {}{}", location,
+                      utils::trim(buf), utils::errorurl(2)));
 
   *next = '\n';
 
@@ -1102,7 +1147,22 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
   }
 
-  if (comm->layout != Comm::LAYOUT_TILED) {
+  // with distributed lines, bounds are the global box
+
+  if (distributed) {
+    if (triclinic == 0) {
+      sublo[0] = domain->boxlo[0]; subhi[0] = domain->boxhi[0];
+      sublo[1] = domain->boxlo[1]; subhi[1] = domain->boxhi[1];
+      sublo[2] = domain->boxlo[2]; subhi[2] = domain->boxhi[2];
+    } else {
+      sublo[0] = sublo[1] = sublo[2] = 0.0;
+      subhi[0] = subhi[1] = subhi[2] = 1.0;
+    }
+    if (domain->xperiodic) { sublo[0] -= epsilon[0]; subhi[0] += epsilon[0]; }
+    if (domain->yperiodic) { sublo[1] -= epsilon[1]; subhi[1] += epsilon[1]; }
+    if (domain->zperiodic) { sublo[2] -= epsilon[2]; subhi[2] += epsilon[2]; }
+
+  } else if (comm->layout != Comm::LAYOUT_TILED) {
     if (domain->xperiodic) {
       if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
       if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
@@ -1147,7 +1207,7 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
 
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
-    if (!next) error->all(FLERR, "Missing data in {}", location);
+    if (!next) fatal(fmt::format("Missing data in {}", location));
     *next = '\0';
     auto values = Tokenizer(buf).as_vector();
     int nvalues = values.size();
@@ -1160,19 +1220,19 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
 
     } else if ((nvalues < nwords) ||
                ((nvalues > nwords) && (!utils::strmatch(values[nwords],"^#")))) {
-      error->all(FLERR, "Incorrect format in {}: {}{}", location,
-                 utils::trim(buf), utils::errorurl(2));
+      fatal(fmt::format("Incorrect format in {}: {}{}", location,
+                        utils::trim(buf), utils::errorurl(2)));
 
     // extract the atom coords and image flags (if they exist)
 
     } else {
       int imx = 0, imy = 0, imz = 0;
       if (imageflag) {
-        imx = utils::inumeric(FLERR,values[iptr],false,lmp);
-        imy = utils::inumeric(FLERR,values[iptr+1],false,lmp);
-        imz = utils::inumeric(FLERR,values[iptr+2],false,lmp);
+        imx = utils::inumeric(FLERR,values[iptr],distributed,lmp);
+        imy = utils::inumeric(FLERR,values[iptr+1],distributed,lmp);
+        imz = utils::inumeric(FLERR,values[iptr+2],distributed,lmp);
         if ((dimension == 2) && (imz != 0))
-          error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+          fatal("Z-direction image flag must be 0 for 2d-systems");
         if ((!domain->xperiodic) && (imx != 0)) { reset_image_flag[0] = true; imx = 0; }
         if ((!domain->yperiodic) && (imy != 0)) { reset_image_flag[1] = true; imy = 0; }
         if ((!domain->zperiodic) && (imz != 0)) { reset_image_flag[2] = true; imz = 0; }
@@ -1181,16 +1241,16 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
         (((imageint) (imy + IMGMAX) & IMGMASK) << IMGBITS) |
         (((imageint) (imz + IMGMAX) & IMGMASK) << IMG2BITS);
 
-      xdata[0] = utils::numeric(FLERR,values[xptr],false,lmp);
-      xdata[1] = utils::numeric(FLERR,values[xptr+1],false,lmp);
-      xdata[2] = utils::numeric(FLERR,values[xptr+2],false,lmp);
+      xdata[0] = utils::numeric(FLERR,values[xptr],distributed,lmp);
+      xdata[1] = utils::numeric(FLERR,values[xptr+1],distributed,lmp);
+      xdata[2] = utils::numeric(FLERR,values[xptr+2],distributed,lmp);
 
       // for 2d simulation:
       // check if z coord is within EPS_ZCOORD of zero and set to zero
 
       if (dimension == 2) {
         if (fabs(xdata[2]) > EPS_ZCOORD)
-          error->all(FLERR,"Read_data atom z coord is non-zero for 2d simulation");
+          fatal("Read_data atom z coord is non-zero for 2d simulation");
         xdata[2] = 0.0;
       }
 
@@ -2350,6 +2410,7 @@ void Atom::sort()
     iy = MIN(iy,nbiny-1);
     iz = MIN(iz,nbinz-1);
     ibin = iz*nbiny*nbinx + iy*nbinx + ix;
+    if (sortorder != SORT_BINNED) ibin = binrank[ibin];
     next[i] = binhead[ibin];
     binhead[ibin] = i;
   }
@@ -2405,6 +2466,41 @@ void Atom::sort()
   //if (flagall) error->all(FLERR,"Atom sort did not operate correctly");
 }
 
+/* ----------------------------------------------------------------------
+   copy coordinates of owned and ghost atoms into per-component streams
+   x_soa[0], x_soa[1], x_soa[2] are contiguous so that pair kernels
+     converted to use them can load neighbor coordinates with unit stride
+   type and q are already stored as 1d vectors and need no copy
+   must be called after the forward communication of the current step
+   only copies once after each comm of coords, so that multiple pair styles
+     or repeated force computations without moving atoms share the copy
+------------------------------------------------------------------------- */
+
+void Atom::soa_pack()
+{
+  if (soa_current && (nmax <= nmax_soa)) return;
+  const int nall = nlocal + nghost;
+  if (nall == 0) return;
+
+  if (nmax > nmax_soa) {
+    memory->destroy(x_soa);
+    nmax_soa = nmax;
+    memory->create(x_soa,3,nmax_soa,"atom:x_soa");
+  }
+
+  const double * _noalias const xx = x[0];
+  double * _noalias const xs = x_soa[0];
+  double * _noalias const ys = x_soa[1];
+  double * _noalias const zs = x_soa[2];
+
+  for (int i = 0; i < nall; i++) {
+    xs[i] = xx[3*i];
+    ys[i] = xx[3*i+1];
+    zs[i] = xx[3*i+2];
+  }
+  soa_current = 1;
+}
+
 /* ----------------------------------------------------------------------
    setup bins for spatial sorting of atoms
 ------------------------------------------------------------------------- */
@@ -2546,9 +2642,127 @@ void Atom::setup_sort_bins()
 
   if (nbins > maxbin) {
     memory->destroy(binhead);
+    memory->destroy(binrank);
     maxbin = nbins;
     memory->create(binhead,maxbin,"atom:binhead");
+    if (sortorder != SORT_BINNED) memory->create(binrank,maxbin,"atom:binrank");
+  } else if ((sortorder != SORT_BINNED) && !binrank)
+    memory->create(binrank,maxbin,"atom:binrank");
+
+  if (sortorder == SORT_BINNED) return;
+
+  // curve grid = sort bins extended by neighbor cutoff on each side
+  //   so ghost atoms sorted by curve_sort() get keys consistent with owned atoms
+  // binrank = position of each row-major bin along the curve
+
+  ncurvex = static_cast<int> (ceil(neighbor->cutneighmax * bininvx));
+  ncurvey = static_cast<int> (ceil(neighbor->cutneighmax * bininvy));
+  ncurvez = static_cast<int> (ceil(neighbor->cutneighmax * bininvz));
+  if (domain->dimension == 2) ncurvez = 0;
+
+  int nmaxdim = MAX(nbinx + 2*ncurvex, nbiny + 2*ncurvey);
+  nmaxdim = MAX(nmaxdim, nbinz + 2*ncurvez);
+  curvebits = 1;
+  while ((1 << curvebits) < nmaxdim) curvebits++;
+  if (curvebits * domain->dimension > 63) error->one(FLERR,"Too many atom sorting bins for curve");
+
+  std::vector<bigint> binkey(nbins);
+  int ix,iy,iz;
+  for (iz = 0; iz < nbinz; iz++)
+    for (iy = 0; iy < nbiny; iy++)
+      for (ix = 0; ix < nbinx; ix++)
+        binkey[iz*nbiny*nbinx + iy*nbinx + ix] = curve_index(ix+ncurvex,iy+ncurvey,iz+ncurvez);
+
+  std::vector<int> order(nbins);
+  for (int m = 0; m < nbins; m++) order[m] = m;
+  std::sort(order.begin(),order.end(),[&binkey](int a, int b) { return binkey[a] < binkey[b]; });
+  for (int m = 0; m < nbins; m++) binrank[order[m]] = m;
+}
+
+/* ----------------------------------------------------------------------
+   index of curve grid cell ix,iy,iz along a Morton or Hilbert curve
+   Hilbert index uses Skilling's transform, AIP Conf Proc 707, 381 (2004),
+     followed by the same bit interleave as the Morton index
+------------------------------------------------------------------------- */
+
+bigint Atom::curve_index(int ix, int iy, int iz)
+{
+  const int ndim = domain->dimension;
+  unsigned int xx[3] = {(unsigned int) ix, (unsigned int) iy, (unsigned int) iz};
+
+  if (sortorder == SORT_HILBERT) {
+    const unsigned int m = 1U << (curvebits-1);
+    unsigned int p,q,t;
+    int i;
+
+    for (q = m; q > 1; q >>= 1) {
+      p = q - 1;
+      for (i = 0; i < ndim; i++) {
+        if (xx[i] & q) xx[0] ^= p;
+        else {
+          t = (xx[0] ^ xx[i]) & p;
+          xx[0] ^= t;
+          xx[i] ^= t;
+        }
+      }
+    }
+
+    for (i = 1; i < ndim; i++) xx[i] ^= xx[i-1];
+    t = 0;
+    for (q = m; q > 1; q >>= 1)
+      if (xx[ndim-1] & q) t ^= q - 1;
+    for (i = 0; i < ndim; i++) xx[i] ^= t;
   }
+
+  bigint key = 0;
+  for (int b = curvebits-1; b >= 0; b--)
+    for (int i = 0; i < ndim; i++)
+      key = (key << 1) | ((xx[i] >> b) & 1U);
+  return key;
+}
+
+/* ----------------------------------------------------------------------
+   reorder list of N owned or ghost atom indices along the sort curve
+   called by CommBrick::borders() on each send list,
+     so that ghost atoms are created in the same order as sorted owned atoms
+   atoms in the same curve cell keep their relative order
+   for triclinic, atom coords are in lamda coords when this is called
+------------------------------------------------------------------------- */
+
+void Atom::curve_sort(int n, int *list)
+{
+  if (n < 2 || !binrank) return;
+
+  if (nmax > maxsortkey) {
+    memory->destroy(sortkey);
+    maxsortkey = nmax;
+    memory->create(sortkey,maxsortkey,"atom:sortkey");
+  }
+
+  const int triclinic = domain->triclinic;
+  const int nx = nbinx + 2*ncurvex;
+  const int ny = nbiny + 2*ncurvey;
+  const int nz = nbinz + 2*ncurvez;
+  double xbox[3];
+  const double *xi;
+  int i,ix,iy,iz;
+
+  for (int m = 0; m < n; m++) {
+    i = list[m];
+    if (triclinic) {
+      domain->lamda2x(x[i],xbox);
+      xi = xbox;
+    } else xi = x[i];
+    ix = static_cast<int> (floor((xi[0]-bboxlo[0])*bininvx)) + ncurvex;
+    iy = static_cast<int> (floor((xi[1]-bboxlo[1])*bininvy)) + ncurvey;
+    iz = static_cast<int> (floor((xi[2]-bboxlo[2])*bininvz)) + ncurvez;
+    ix = MIN(MAX(ix,0),nx-1);
+    iy = MIN(MAX(iy,0),ny-1);
+    iz = MIN(MAX(iz,0),nz-1);
+    sortkey[i] = curve_index(ix,iy,iz);
+  }
+
+  std::stable_sort(list,list+n,[this](int a, int b) { return sortkey[a] < sortkey[b]; });
 }
 
 /* ----------------------------------------------------------------------
@@ -3252,6 +3466,9 @@ double Atom::memory_usage()
     bytes += memory->usage(next,maxnext);
     bytes += memory->usage(permute,maxnext);
   }
+  if (binrank) bytes += memory->usage(binrank,maxbin);
+  if (maxsortkey) bytes += memory->usage(sortkey,maxsortkey);
+  if (nmax_soa) bytes += memory->usage(x_soa,3,nmax_soa);
 
   return bytes;
 }
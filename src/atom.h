@@ -36,6 +36,7 @@ class Atom : protected Pointers {
   enum { ATOM = 0, BOND = 1, ANGLE = 2, DIHEDRAL = 3, IMPROPER = 4 };
   enum { NUMERIC = 0, LABELS = 1 };
   enum { MAP_NONE = 0, MAP_ARRAY = 1, MAP_HASH = 2, MAP_YES = 3 };
+  enum { SORT_BINNED = 0, SORT_MORTON = 1, SORT_HILBERT = 2 };
 
   // atom counts
 
@@ -284,6 +285,14 @@ class Atom : protected Pointers {
   int sortfreq;          // sort atoms every this many steps, 0 = off
   bigint nextsort;       // next timestep to sort on
   double userbinsize;    // requested sort bin size
+  int sortorder;         // order of sort bins, SORT_BINNED/MORTON/HILBERT
+
+  // optional structure-of-arrays copy of coordinates for converted kernels
+
+  int soa_flag;      // 1 if x_soa is maintained, 0 = off
+  int nmax_soa;      // allocated length of each x_soa component stream
+  double **x_soa;    // x_soa[d][i] = d-th coordinate of owned + ghost atom i
+  int soa_current;   // 1 if x_soa matches x, reset when comm updates x
 
   // indices of atoms with same ID
 
@@ -329,7 +338,7 @@ class Atom : protected Pointers {
 
   virtual void deallocate_topology();
 
-  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *, int);
+  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *, int, int = 0);
   void data_vels(int, char *, tagint);
   void data_bonds(int, char *, int *, tagint, int, int, int *);
   void data_angles(int, char *, int *, tagint, int, int, int *);
@@ -358,6 +367,8 @@ class Atom : protected Pointers {
 
   void first_reorder();
   virtual void sort();
+  void curve_sort(int, int *);
+  void soa_pack();
 
   void add_callback(int);
   void delete_callback(const char *, int);
@@ -434,9 +445,15 @@ class Atom : protected Pointers {
   int *permute;                        // permutation vector
   double bininvx, bininvy, bininvz;    // inverse actual bin sizes
   double bboxlo[3], bboxhi[3];         // bounding box of my sub-domain
+  int *binrank;                        // position of each bin along curve
+  int curvebits;                       // bits per dim of curve index
+  int ncurvex, ncurvey, ncurvez;       // ghost bins added below bboxlo
+  int maxsortkey;                      // size of sortkey
+  bigint *sortkey;                     // curve index of each atom
 
   void set_atomflag_defaults();
   void setup_sort_bins();
+  bigint curve_index(int, int, int);
   int next_prime(int);
 };
 
@@ -62,6 +62,9 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   ncollections = 0;
   ncollections_cutoff = 0;
   ghost_velocity = 0;
+  overlap_flag = 0;
+  persistent_flag = 0;
+  collective_flag = 0;
 
   user_procgrid[0] = user_procgrid[1] = user_procgrid[2] = 0;
   coregrid[0] = coregrid[1] = coregrid[2] = 1;
@@ -392,6 +395,18 @@ void Comm::modify_params(int narg, char **arg)
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify vel", error);
       ghost_velocity = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"overlap") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify overlap", error);
+      overlap_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"persistent") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify persistent", error);
+      persistent_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"collective") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify collective", error);
+      collective_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else error->all(FLERR,"Unknown comm_modify keyword: {}", arg[iarg]);
   }
 }
@@ -715,8 +730,10 @@ double Comm::get_comm_cutoff()
   }
 
   // always take the larger of max neighbor list and user specified cutoff
+  // partial neighbor list rebuilds need a wider cutoff, if active
 
   maxcommcutoff = MAX(cutghostuser,neighbor->cutneighmax);
+  maxcommcutoff = MAX(maxcommcutoff,neighbor->cutghostpartial);
 
   // use cutoff estimate from bond length only if no user specified
   // cutoff was given and no pair style present. Otherwise print a
@@ -35,6 +35,9 @@ class Comm : protected Pointers {
 
   int me, nprocs;               // proc info
   int ghost_velocity;           // 1 if ghost atoms have velocity, 0 if not
+  int overlap_flag;             // 1 if forward comm overlaps with pair compute
+  int persistent_flag;          // 1 if forward/reverse comm use persistent requests
+  int collective_flag;          // 1 if forward/reverse/borders comm use neighbor collectives
   double cutghost[3];           // cutoffs used for acquiring ghost atoms
   double cutghostuser;          // user-specified ghost cutoff (mode == SINGLE)
   double *cutusermulti;         // per collection user ghost cutoff (mode == MULTI)
@@ -85,6 +88,13 @@ class Comm : protected Pointers {
   virtual void exchange() = 0;                     // move atoms to new procs
   virtual void borders() = 0;                      // setup list of atoms to comm
 
+  // split forward comm of atom coords, for overlap with pair compute
+  // default is to do all comm in forward_comm_start()
+
+  virtual void forward_comm_start() { forward_comm(); }
+  virtual int forward_comm_progress() { return 1; }
+  virtual void forward_comm_finish() {}
+
   // forward/reverse comm from a Pair, Bond, Fix, Compute, Dump
 
   virtual void forward_comm(class Pair *) = 0;
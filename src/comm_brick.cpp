@@ -29,6 +29,8 @@
 #include "memory.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "profiler.h"
+#include "timer.h"
 
 #include <cmath>
 #include <cstring>
@@ -78,6 +80,14 @@ CommBrick::~CommBrick()
 
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+
+  persist_free();
+  delete[] req_forward;
+  delete[] req_reverse;
+  memory->destroy(persist_soffset);
+  memory->destroy(persist_roffset);
+  memory->destroy(persist_sendbuf);
+  memory->destroy(persist_recvbuf);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -119,6 +129,15 @@ void CommBrick::init_buffers()
   maxswap = 6;
   CommBrick::allocate_swap(maxswap);
 
+  overlap_swap = overlap_nrequest = 0;
+
+  persist_valid = persist_nswap = maxpersist = 0;
+  req_forward = req_reverse = nullptr;
+  persist_soffset = persist_roffset = nullptr;
+  persist_sendbuf = persist_recvbuf = nullptr;
+  persist_maxsend = persist_maxrecv = 0;
+  persist_x = persist_f = nullptr;
+
   sendlist = (int **) memory->smalloc(maxswap*sizeof(int *),"comm:sendlist");
   memory->create(maxsendlist,maxswap,"comm:maxsendlist");
   for (int i = 0; i < maxswap; i++) {
@@ -132,6 +151,7 @@ void CommBrick::init_buffers()
 void CommBrick::init()
 {
   Comm::init();
+  persist_valid = 0;
 
   int bufextra_old = bufextra;
   init_exchange();
@@ -190,6 +210,8 @@ void CommBrick::init()
 
 void CommBrick::setup()
 {
+  persist_valid = 0;
+
   // cutghost[] = max distance at which ghost atoms need to be acquired
   // for orthogonal:
   //   cutghost is in box coords = neigh->cutghost in all 3 dims
@@ -543,11 +565,20 @@ void CommBrick::forward_comm(int /*dummy*/)
   double **x = atom->x;
   double *buf;
 
+  atom->soa_current = 0;
+
+  if (persistent_flag && !ghost_velocity) {
+    ProfileScope prof(timer->profiler, Profiler::COMM, this, "forward/persistent", -1, "brick");
+    forward_comm_persistent();
+    return;
+  }
+
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_x_only set, exchange or copy directly to x, don't unpack
 
   for (int iswap = 0; iswap < nswap; iswap++) {
+    ProfileScope prof(timer->profiler, Profiler::COMM, this, "forward", iswap, "brick");
     if (sendproc[iswap] != me) {
       if (comm_x_only) {
         if (size_forward_recv[iswap]) {
@@ -590,6 +621,117 @@ void CommBrick::forward_comm(int /*dummy*/)
   }
 }
 
+/* ----------------------------------------------------------------------
+   split forward communication of atom coords every timestep
+   forward_comm_start() posts the first swap with non-blocking messages
+   forward_comm_progress() tests for completion and posts later swaps,
+     it can be called repeatedly while owned-atom work is done
+   forward_comm_finish() waits for all remaining swaps
+   later swaps forward ghost atoms received in earlier swaps,
+     so swaps are posted one at a time in the same order as forward_comm()
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_start()
+{
+  atom->soa_current = 0;
+  overlap_swap = 0;
+  overlap_nrequest = 0;
+  if (nswap) forward_swap_post(0);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int CommBrick::forward_comm_progress()
+{
+  return forward_comm_advance(0);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_finish()
+{
+  forward_comm_advance(1);
+}
+
+/* ----------------------------------------------------------------------
+   complete swaps in order as long as their messages have arrived
+   wait = 1 to block until all swaps are done
+   return 1 if all swaps are done, 0 if not
+------------------------------------------------------------------------- */
+
+int CommBrick::forward_comm_advance(int wait)
+{
+  int flag;
+
+  while (overlap_swap < nswap) {
+    if (overlap_nrequest) {
+      if (wait) MPI_Waitall(overlap_nrequest,overlap_request,MPI_STATUS_IGNORE);
+      else {
+        MPI_Testall(overlap_nrequest,overlap_request,&flag,MPI_STATUS_IGNORE);
+        if (!flag) return 0;
+      }
+      overlap_nrequest = 0;
+      forward_swap_unpack(overlap_swap);
+    }
+    overlap_swap++;
+    if (overlap_swap < nswap) forward_swap_post(overlap_swap);
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   pack and post non-blocking messages for one forward comm swap
+   if other proc is self, just copy
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_swap_post(int iswap)
+{
+  int n;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+
+  if (sendproc[iswap] != me) {
+    double *buf = comm_x_only ? x[firstrecv[iswap]] : buf_recv;
+    if (size_forward_recv[iswap])
+      MPI_Irecv(buf,size_forward_recv[iswap],MPI_DOUBLE,recvproc[iswap],0,world,
+                &overlap_request[overlap_nrequest++]);
+    if (ghost_velocity)
+      n = avec->pack_comm_vel(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+    else
+      n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+    if (n)
+      MPI_Isend(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world,
+                &overlap_request[overlap_nrequest++]);
+
+  } else {
+    if (comm_x_only) {
+      if (sendnum[iswap])
+        avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                        x[firstrecv[iswap]],pbc_flag[iswap],pbc[iswap]);
+    } else if (ghost_velocity) {
+      avec->pack_comm_vel(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+      avec->unpack_comm_vel(recvnum[iswap],firstrecv[iswap],buf_send);
+    } else {
+      avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+      avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_send);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   unpack a completed forward comm swap with another proc
+   if comm_x_only set, data was received directly into x
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_swap_unpack(int iswap)
+{
+  AtomVec *avec = atom->avec;
+
+  if (comm_x_only) return;
+  if (ghost_velocity) avec->unpack_comm_vel(recvnum[iswap],firstrecv[iswap],buf_recv);
+  else avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_recv);
+}
+
 /* ----------------------------------------------------------------------
    reverse communication of forces on atoms every timestep
    other per-atom attributes may also be sent via pack/unpack routines
@@ -603,11 +745,18 @@ void CommBrick::reverse_comm()
   double **f = atom->f;
   double *buf;
 
+  if (persistent_flag) {
+    ProfileScope prof(timer->profiler, Profiler::COMM, this, "reverse/persistent", -1, "brick");
+    reverse_comm_persistent();
+    return;
+  }
+
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_f_only set, exchange or copy directly from f, don't pack
 
   for (int iswap = nswap-1; iswap >= 0; iswap--) {
+    ProfileScope prof(timer->profiler, Profiler::COMM, this, "reverse", iswap, "brick");
     if (sendproc[iswap] != me) {
       if (comm_f_only) {
         if (size_reverse_recv[iswap])
@@ -638,6 +787,208 @@ void CommBrick::reverse_comm()
   }
 }
 
+/* ----------------------------------------------------------------------
+   forward comm of atom coords with persistent requests
+   same data movement as forward_comm(), but messages of the two swaps
+     in each dim and need are posted together
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_persistent()
+{
+  int iswap,first,last,n,nactive;
+  MPI_Request active[4];
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+
+  if (!persist_valid || (x ? x[0] : nullptr) != persist_x ||
+      (atom->f ? atom->f[0] : nullptr) != persist_f) persist_setup();
+
+  for (first = 0; first < nswap; first += 2) {
+    last = MIN(first+2,nswap);
+
+    nactive = 0;
+    for (iswap = first; iswap < last; iswap++)
+      if (req_forward[2*iswap] != MPI_REQUEST_NULL) active[nactive++] = req_forward[2*iswap];
+    MPI_Startall(nactive,active);
+
+    for (iswap = first; iswap < last; iswap++) {
+      if (sendproc[iswap] != me) {
+        if (req_forward[2*iswap+1] == MPI_REQUEST_NULL) continue;
+        n = avec->pack_comm(sendnum[iswap],sendlist[iswap],&persist_sendbuf[persist_soffset[iswap]],
+                            pbc_flag[iswap],pbc[iswap]);
+        if (n != sendnum[iswap]*size_forward)
+          error->one(FLERR,"Comm_modify persistent requires a fixed forward comm size per atom");
+        MPI_Startall(1,&req_forward[2*iswap+1]);
+        active[nactive++] = req_forward[2*iswap+1];
+      } else if (comm_x_only) {
+        if (sendnum[iswap])
+          avec->pack_comm(sendnum[iswap],sendlist[iswap],x[firstrecv[iswap]],
+                          pbc_flag[iswap],pbc[iswap]);
+      } else {
+        avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+        avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_send);
+      }
+    }
+
+    if (nactive) MPI_Waitall(nactive,active,MPI_STATUS_IGNORE);
+
+    if (!comm_x_only)
+      for (iswap = first; iswap < last; iswap++)
+        if (sendproc[iswap] != me)
+          avec->unpack_comm(recvnum[iswap],firstrecv[iswap],
+                            &persist_recvbuf[persist_roffset[iswap]]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   reverse comm of forces with persistent requests
+   swaps are unpacked in the same order as in reverse_comm()
+------------------------------------------------------------------------- */
+
+void CommBrick::reverse_comm_persistent()
+{
+  int iswap,first,last,n,nactive;
+  MPI_Request active[4];
+  AtomVec *avec = atom->avec;
+  double **f = atom->f;
+
+  if (!persist_valid || (atom->x ? atom->x[0] : nullptr) != persist_x ||
+      (f ? f[0] : nullptr) != persist_f) persist_setup();
+
+  for (last = nswap-1; last >= 0; last -= 2) {
+    first = MAX(last-1,0);
+
+    nactive = 0;
+    for (iswap = last; iswap >= first; iswap--)
+      if (req_reverse[2*iswap] != MPI_REQUEST_NULL) active[nactive++] = req_reverse[2*iswap];
+    MPI_Startall(nactive,active);
+
+    for (iswap = last; iswap >= first; iswap--) {
+      if (sendproc[iswap] != me) {
+        if (req_reverse[2*iswap+1] == MPI_REQUEST_NULL) continue;
+        if (!comm_f_only) {
+          n = avec->pack_reverse(recvnum[iswap],firstrecv[iswap],
+                                 &persist_sendbuf[persist_soffset[iswap]]);
+          if (n != size_reverse_send[iswap])
+            error->one(FLERR,"Comm_modify persistent requires a fixed reverse comm size per atom");
+        }
+        MPI_Startall(1,&req_reverse[2*iswap+1]);
+        active[nactive++] = req_reverse[2*iswap+1];
+      }
+    }
+
+    if (nactive) MPI_Waitall(nactive,active,MPI_STATUS_IGNORE);
+
+    for (iswap = last; iswap >= first; iswap--) {
+      if (sendproc[iswap] != me) {
+        if (size_reverse_recv[iswap])
+          avec->unpack_reverse(sendnum[iswap],sendlist[iswap],
+                               &persist_recvbuf[persist_roffset[iswap]]);
+      } else if (comm_f_only) {
+        if (sendnum[iswap])
+          avec->unpack_reverse(sendnum[iswap],sendlist[iswap],f[firstrecv[iswap]]);
+      } else {
+        avec->pack_reverse(recvnum[iswap],firstrecv[iswap],buf_send);
+        avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_send);
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   create persistent send/recv requests for current swaps
+   redone after borders() and whenever atom coords or forces are reallocated
+   with comm_x_only, coords are received directly into x
+   with comm_f_only, forces are sent directly from f
+------------------------------------------------------------------------- */
+
+void CommBrick::persist_setup()
+{
+  int iswap,nsend,nrecv;
+  double **x = atom->x;
+  double **f = atom->f;
+
+  persist_free();
+
+  if (nswap > maxpersist) {
+    delete[] req_forward;
+    delete[] req_reverse;
+    memory->destroy(persist_soffset);
+    memory->destroy(persist_roffset);
+    maxpersist = maxswap;
+    req_forward = new MPI_Request[2*maxpersist];
+    req_reverse = new MPI_Request[2*maxpersist];
+    memory->create(persist_soffset,maxpersist,"comm:persist_soffset");
+    memory->create(persist_roffset,maxpersist,"comm:persist_roffset");
+  }
+
+  // one buffer section per swap, shared by forward and reverse comm
+
+  nsend = nrecv = 0;
+  for (iswap = 0; iswap < nswap; iswap++) {
+    persist_soffset[iswap] = nsend;
+    persist_roffset[iswap] = nrecv;
+    if (sendproc[iswap] == me) continue;
+    nsend += MAX(sendnum[iswap]*size_forward,size_reverse_send[iswap]);
+    nrecv += MAX(size_forward_recv[iswap],size_reverse_recv[iswap]);
+  }
+
+  if (nsend > persist_maxsend) {
+    memory->destroy(persist_sendbuf);
+    persist_maxsend = static_cast<int> (BUFFACTOR * nsend);
+    memory->create(persist_sendbuf,persist_maxsend,"comm:persist_sendbuf");
+  }
+  if (nrecv > persist_maxrecv) {
+    memory->destroy(persist_recvbuf);
+    persist_maxrecv = static_cast<int> (BUFFACTOR * nrecv);
+    memory->create(persist_recvbuf,persist_maxrecv,"comm:persist_recvbuf");
+  }
+
+  // tags distinguish the two swaps of a pair when both go to the same proc
+
+  for (iswap = 0; iswap < nswap; iswap++) {
+    req_forward[2*iswap] = req_forward[2*iswap+1] = MPI_REQUEST_NULL;
+    req_reverse[2*iswap] = req_reverse[2*iswap+1] = MPI_REQUEST_NULL;
+    if (sendproc[iswap] == me) continue;
+
+    double *sbuf = &persist_sendbuf[persist_soffset[iswap]];
+    double *rbuf = &persist_recvbuf[persist_roffset[iswap]];
+
+    if (size_forward_recv[iswap])
+      MPI_Recv_init(comm_x_only ? x[firstrecv[iswap]] : rbuf,size_forward_recv[iswap],
+                    MPI_DOUBLE,recvproc[iswap],iswap,world,&req_forward[2*iswap]);
+    if (sendnum[iswap] && size_forward)
+      MPI_Send_init(sbuf,sendnum[iswap]*size_forward,MPI_DOUBLE,sendproc[iswap],iswap,world,
+                    &req_forward[2*iswap+1]);
+
+    if (size_reverse_recv[iswap])
+      MPI_Recv_init(rbuf,size_reverse_recv[iswap],MPI_DOUBLE,sendproc[iswap],nswap+iswap,world,
+                    &req_reverse[2*iswap]);
+    if (size_reverse_send[iswap])
+      MPI_Send_init(comm_f_only ? f[firstrecv[iswap]] : sbuf,size_reverse_send[iswap],
+                    MPI_DOUBLE,recvproc[iswap],nswap+iswap,world,&req_reverse[2*iswap+1]);
+  }
+
+  persist_nswap = nswap;
+  persist_x = x ? x[0] : nullptr;
+  persist_f = f ? f[0] : nullptr;
+  persist_valid = 1;
+}
+
+/* ----------------------------------------------------------------------
+   free persistent requests
+------------------------------------------------------------------------- */
+
+void CommBrick::persist_free()
+{
+  for (int i = 0; i < 2*persist_nswap; i++) {
+    if (req_forward[i] != MPI_REQUEST_NULL) MPI_Request_free(&req_forward[i]);
+    if (req_reverse[i] != MPI_REQUEST_NULL) MPI_Request_free(&req_reverse[i]);
+  }
+  persist_nswap = 0;
+  persist_valid = 0;
+}
+
 /* ----------------------------------------------------------------------
    exchange: move atoms to correct processors
    atoms exchanged with all 6 stencil neighbors
@@ -692,6 +1043,7 @@ void CommBrick::exchange()
   int dimension = domain->dimension;
 
   for (int dim = 0; dim < dimension; dim++) {
+    ProfileScope prof(timer->profiler, Profiler::COMM, this, "exchange", dim, "brick");
 
     // fill buffer with atoms leaving my box, using < and >=
     // when atom is deleted, fill it in with last atom
@@ -780,6 +1132,8 @@ void CommBrick::borders()
   MPI_Request request;
   AtomVec *avec = atom->avec;
 
+  atom->soa_current = 0;
+
   // After exchanging/sorting, need to reconstruct collection array for border communication
   if (mode == Comm::MULTI) neighbor->build_collection(0);
 
@@ -792,6 +1146,7 @@ void CommBrick::borders()
     nlast = 0;
     twoneed = 2*maxneed[dim];
     for (ineed = 0; ineed < twoneed; ineed++) {
+      ProfileScope prof(timer->profiler, Profiler::COMM, this, "borders", iswap, "brick");
 
       // find atoms within slab boundaries lo/hi using <= and >=
       // check atoms between nfirst and nlast
@@ -906,6 +1261,12 @@ void CommBrick::borders()
         }
       }
 
+      // order send list along the atom sort curve, if requested,
+      //   so received ghost atoms are laid out with spatial locality
+
+      if (atom->sortfreq > 0 && atom->sortorder != Atom::SORT_BINNED)
+        atom->curve_sort(nsend,sendlist[iswap]);
+
       // pack up list of border atoms
 
       if (nsend*size_border > maxsend) grow_send(nsend*size_border,0);
@@ -973,6 +1334,10 @@ void CommBrick::borders()
   max = MAX(maxforward*rmax,maxreverse*smax);
   if (max > maxrecv) grow_recv(max);
 
+  // persistent requests must be recreated for new send/recv lists
+
+  persist_valid = 0;
+
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
@@ -1651,5 +2016,7 @@ double CommBrick::memory_usage()
     bytes += memory->usage(sendlist[i],maxsendlist[i]);
   bytes += memory->usage(buf_send,maxsend+bufextra);
   bytes += memory->usage(buf_recv,maxrecv);
+  bytes += memory->usage(persist_sendbuf,persist_maxsend);
+  bytes += memory->usage(persist_recvbuf,persist_maxrecv);
   return bytes;
 }
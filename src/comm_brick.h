@@ -32,6 +32,10 @@ class CommBrick : public Comm {
   void exchange() override;                     // move atoms to new procs
   void borders() override;                      // setup list of atoms to comm
 
+  void forward_comm_start() override;       // post first swap of forward comm
+  int forward_comm_progress() override;     // advance forward comm, 1 if done
+  void forward_comm_finish() override;      // complete forward comm
+
   void forward_comm(class Pair *) override;                 // forward comm from a Pair
   void reverse_comm(class Pair *) override;                 // reverse comm from a Pair
   void forward_comm(class Bond *) override;                 // forward comm from a Bond
@@ -77,10 +81,37 @@ class CommBrick : public Comm {
   int maxsend, maxrecv;    // current size of send/recv buffer
   int smax, rmax;          // max size in atoms of single borders send/recv
 
+  int overlap_swap;                  // swap in progress during split forward comm
+  int overlap_nrequest;              // # of pending requests of that swap
+  MPI_Request overlap_request[2];    // recv/send requests of that swap
+
+  // persistent requests for forward/reverse comm of coords and forces
+  // swaps 2k and 2k+1 go in opposite directions of one dim and are independent,
+  //   so each pair of swaps is started together with one MPI_Startall()
+
+  int persist_valid;                  // 1 if requests match current swaps and atom arrays
+  int persist_nswap;                  // # of swaps requests were created for
+  int maxpersist;                     // # of swaps per-swap arrays are allocated for
+  MPI_Request *req_forward;           // recv/send request of each swap in forward comm
+  MPI_Request *req_reverse;           // recv/send request of each swap in reverse comm
+  int *persist_soffset;               // offset of each swap in persist_sendbuf
+  int *persist_roffset;               // offset of each swap in persist_recvbuf
+  double *persist_sendbuf;            // send buffer, one section per swap
+  double *persist_recvbuf;            // recv buffer, one section per swap
+  int persist_maxsend, persist_maxrecv;
+  double *persist_x, *persist_f;      // atom coords and forces requests point into
+
   // NOTE: init_buffers is called from a constructor and must not be made virtual
   void init_buffers();
 
   int updown(int, int, int, double, int, double *);
+  void forward_swap_post(int);
+  void forward_swap_unpack(int);
+  int forward_comm_advance(int);
+  void forward_comm_persistent();
+  void reverse_comm_persistent();
+  void persist_setup();
+  void persist_free();
   // compare cutoff to procs
   virtual void grow_send(int, int);       // reallocate send buffer
   virtual void grow_recv(int);            // free/allocate recv buffer
@@ -80,6 +80,17 @@ CommTiled::~CommTiled()
   memory->sfree(rcbinfo);
   memory->destroy(cutghostmulti);
   memory->destroy(cutghostmultiold);
+  free_graph();
+  delete[] graph_forward;
+  delete[] graph_reverse;
+  memory->destroy(graphsend);
+  memory->destroy(graphrecv);
+  memory->destroy(ngraphsend);
+  memory->destroy(ngraphrecv);
+  memory->destroy(gsendcount);
+  memory->destroy(gsenddispl);
+  memory->destroy(grecvcount);
+  memory->destroy(grecvdispl);
 }
 
 /* ----------------------------------------------------------------------
@@ -122,6 +133,14 @@ void CommTiled::init_pointers()
   nexchprocmax = nullptr;
   exchproc = nullptr;
   exchnum = nullptr;
+
+  ngraph = 0;
+  graph_forward = graph_reverse = nullptr;
+  graphsend = graphrecv = nullptr;
+  ngraphsend = ngraphrecv = nullptr;
+  maxgraphproc = 0;
+  gsendcount = gsenddispl = nullptr;
+  grecvcount = grecvdispl = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -740,6 +759,100 @@ void CommTiled::setup()
     delete [] requests;
     requests = new MPI_Request[maxrequest];
   }
+
+  // create or release graph communicators for neighborhood collectives
+
+  if (collective_flag) setup_graph();
+  else if (ngraph) free_graph();
+}
+
+/* ----------------------------------------------------------------------
+   create one pair of distributed graph communicators per swap
+   forward graph: edges from recvproc to me and from me to sendproc
+   reverse graph: same edges in opposite direction
+   self is not part of the graph, it is handled by a direct copy
+   graphs are only rebuilt if the proc lists of any proc changed,
+     i.e. typically only after the decomposition was rebalanced
+   multiple edges between the same two procs are matched in list order,
+     the same as the ordering of point-to-point messages with equal tags
+------------------------------------------------------------------------- */
+
+void CommTiled::setup_graph()
+{
+  int i,iswap,nsend,nrecv;
+
+  int changed = (ngraph != nswap);
+  for (iswap = 0; iswap < nswap && !changed; iswap++) {
+    nsend = nsendproc[iswap] - sendself[iswap];
+    nrecv = nrecvproc[iswap] - sendself[iswap];
+    if (nsend != ngraphsend[iswap] || nrecv != ngraphrecv[iswap]) changed = 1;
+    for (i = 0; i < nsend && !changed; i++)
+      if (sendproc[iswap][i] != graphsend[iswap][i]) changed = 1;
+    for (i = 0; i < nrecv && !changed; i++)
+      if (recvproc[iswap][i] != graphrecv[iswap][i]) changed = 1;
+  }
+
+  int anychanged;
+  MPI_Allreduce(&changed,&anychanged,1,MPI_INT,MPI_MAX,world);
+  if (!anychanged) return;
+
+  free_graph();
+
+  if (!graph_forward) {
+    graph_forward = new MPI_Comm[maxswap];
+    graph_reverse = new MPI_Comm[maxswap];
+    memory->create(ngraphsend,maxswap,"comm:ngraphsend");
+    memory->create(ngraphrecv,maxswap,"comm:ngraphrecv");
+  }
+
+  int nmax = 1;
+  for (iswap = 0; iswap < nswap; iswap++)
+    nmax = MAX(nmax,MAX(nsendproc[iswap],nrecvproc[iswap]));
+  if (nmax > maxgraphproc) {
+    maxgraphproc = nmax;
+    memory->destroy(graphsend);
+    memory->destroy(graphrecv);
+    memory->destroy(gsendcount);
+    memory->destroy(gsenddispl);
+    memory->destroy(grecvcount);
+    memory->destroy(grecvdispl);
+    memory->create(graphsend,maxswap,maxgraphproc,"comm:graphsend");
+    memory->create(graphrecv,maxswap,maxgraphproc,"comm:graphrecv");
+    memory->create(gsendcount,maxgraphproc,"comm:gsendcount");
+    memory->create(gsenddispl,maxgraphproc,"comm:gsenddispl");
+    memory->create(grecvcount,maxgraphproc,"comm:grecvcount");
+    memory->create(grecvdispl,maxgraphproc,"comm:grecvdispl");
+  }
+
+  for (iswap = 0; iswap < nswap; iswap++) {
+    nsend = nsendproc[iswap] - sendself[iswap];
+    nrecv = nrecvproc[iswap] - sendself[iswap];
+    ngraphsend[iswap] = nsend;
+    ngraphrecv[iswap] = nrecv;
+    for (i = 0; i < nsend; i++) graphsend[iswap][i] = sendproc[iswap][i];
+    for (i = 0; i < nrecv; i++) graphrecv[iswap][i] = recvproc[iswap][i];
+
+    MPI_Dist_graph_create_adjacent(world,nrecv,graphrecv[iswap],MPI_UNWEIGHTED,
+                                   nsend,graphsend[iswap],MPI_UNWEIGHTED,
+                                   MPI_INFO_NULL,0,&graph_forward[iswap]);
+    MPI_Dist_graph_create_adjacent(world,nsend,graphsend[iswap],MPI_UNWEIGHTED,
+                                   nrecv,graphrecv[iswap],MPI_UNWEIGHTED,
+                                   MPI_INFO_NULL,0,&graph_reverse[iswap]);
+  }
+  ngraph = nswap;
+}
+
+/* ----------------------------------------------------------------------
+   free graph communicators
+------------------------------------------------------------------------- */
+
+void CommTiled::free_graph()
+{
+  for (int iswap = 0; iswap < ngraph; iswap++) {
+    MPI_Comm_free(&graph_forward[iswap]);
+    MPI_Comm_free(&graph_reverse[iswap]);
+  }
+  ngraph = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -753,6 +866,8 @@ void CommTiled::forward_comm(int /*dummy*/)
   AtomVec *avec = atom->avec;
   double **x = atom->x;
 
+  atom->soa_current = 0;
+
   // exchange data with another set of procs in each swap
   // post recvs from all procs except self
   // send data to all procs except self
@@ -760,6 +875,11 @@ void CommTiled::forward_comm(int /*dummy*/)
   // wait on all procs except self and unpack received data
   // if comm_x_only set, exchange or copy directly to x, don't unpack
 
+  if (ngraph) {
+    forward_comm_collective();
+    return;
+  }
+
   for (int iswap = 0; iswap < nswap; iswap++) {
     nsend = nsendproc[iswap] - sendself[iswap];
     nrecv = nrecvproc[iswap] - sendself[iswap];
@@ -856,6 +976,11 @@ void CommTiled::reverse_comm()
   // wait on all procs except self and unpack received data
   // if comm_f_only set, exchange or copy directly from f, don't pack
 
+  if (ngraph) {
+    reverse_comm_collective();
+    return;
+  }
+
   for (int iswap = nswap-1; iswap >= 0; iswap--) {
     nsend = nsendproc[iswap] - sendself[iswap];
     nrecv = nrecvproc[iswap] - sendself[iswap];
@@ -911,6 +1036,137 @@ void CommTiled::reverse_comm()
   }
 }
 
+/* ----------------------------------------------------------------------
+   forward communication of atom coords with one neighbor alltoallv per swap
+   sends to all procs except self are packed back-to-back into buf_send
+------------------------------------------------------------------------- */
+
+void CommTiled::forward_comm_collective()
+{
+  int i,n,nsend,nrecv,offset;
+  double *rbuf;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    nsend = nsendproc[iswap] - sendself[iswap];
+    nrecv = nrecvproc[iswap] - sendself[iswap];
+
+    offset = 0;
+    for (i = 0; i < nsend; i++) {
+      if (ghost_velocity)
+        n = avec->pack_comm_vel(sendnum[iswap][i],sendlist[iswap][i],
+                                &buf_send[offset],pbc_flag[iswap][i],pbc[iswap][i]);
+      else
+        n = avec->pack_comm(sendnum[iswap][i],sendlist[iswap][i],
+                            &buf_send[offset],pbc_flag[iswap][i],pbc[iswap][i]);
+      gsendcount[i] = n;
+      gsenddispl[i] = offset;
+      offset += n;
+    }
+
+    if (comm_x_only && nrecv) {
+      rbuf = x[0];
+      for (i = 0; i < nrecv; i++) {
+        grecvcount[i] = size_forward_recv[iswap][i];
+        grecvdispl[i] = 3*firstrecv[iswap][i];
+      }
+    } else {
+      rbuf = buf_recv;
+      for (i = 0; i < nrecv; i++) {
+        grecvcount[i] = size_forward_recv[iswap][i];
+        grecvdispl[i] = size_forward*forward_recv_offset[iswap][i];
+      }
+    }
+
+    MPI_Neighbor_alltoallv(buf_send,gsendcount,gsenddispl,MPI_DOUBLE,
+                           rbuf,grecvcount,grecvdispl,MPI_DOUBLE,graph_forward[iswap]);
+
+    if (sendself[iswap]) {
+      if (comm_x_only) {
+        avec->pack_comm(sendnum[iswap][nsend],sendlist[iswap][nsend],
+                        x[firstrecv[iswap][nrecv]],pbc_flag[iswap][nsend],pbc[iswap][nsend]);
+      } else if (ghost_velocity) {
+        avec->pack_comm_vel(sendnum[iswap][nsend],sendlist[iswap][nsend],
+                            buf_send,pbc_flag[iswap][nsend],pbc[iswap][nsend]);
+        avec->unpack_comm_vel(recvnum[iswap][nrecv],firstrecv[iswap][nrecv],buf_send);
+      } else {
+        avec->pack_comm(sendnum[iswap][nsend],sendlist[iswap][nsend],
+                        buf_send,pbc_flag[iswap][nsend],pbc[iswap][nsend]);
+        avec->unpack_comm(recvnum[iswap][nrecv],firstrecv[iswap][nrecv],buf_send);
+      }
+    }
+
+    if (comm_x_only) continue;
+
+    for (i = 0; i < nrecv; i++) {
+      if (ghost_velocity)
+        avec->unpack_comm_vel(recvnum[iswap][i],firstrecv[iswap][i],
+                              &buf_recv[size_forward*forward_recv_offset[iswap][i]]);
+      else
+        avec->unpack_comm(recvnum[iswap][i],firstrecv[iswap][i],
+                          &buf_recv[size_forward*forward_recv_offset[iswap][i]]);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   reverse communication of forces with one neighbor alltoallv per swap
+   contributions of all procs are summed in proc list order
+------------------------------------------------------------------------- */
+
+void CommTiled::reverse_comm_collective()
+{
+  int i,n,nsend,nrecv,offset;
+  double *sbuf;
+  AtomVec *avec = atom->avec;
+  double **f = atom->f;
+
+  for (int iswap = nswap-1; iswap >= 0; iswap--) {
+    nsend = nsendproc[iswap] - sendself[iswap];
+    nrecv = nrecvproc[iswap] - sendself[iswap];
+
+    if (comm_f_only && nrecv) {
+      sbuf = f[0];
+      for (i = 0; i < nrecv; i++) {
+        gsendcount[i] = size_reverse_send[iswap][i];
+        gsenddispl[i] = 3*firstrecv[iswap][i];
+      }
+    } else {
+      sbuf = buf_send;
+      offset = 0;
+      for (i = 0; i < nrecv; i++) {
+        n = avec->pack_reverse(recvnum[iswap][i],firstrecv[iswap][i],&buf_send[offset]);
+        gsendcount[i] = n;
+        gsenddispl[i] = offset;
+        offset += n;
+      }
+    }
+
+    for (i = 0; i < nsend; i++) {
+      grecvcount[i] = size_reverse_recv[iswap][i];
+      grecvdispl[i] = size_reverse*reverse_recv_offset[iswap][i];
+    }
+
+    MPI_Neighbor_alltoallv(sbuf,gsendcount,gsenddispl,MPI_DOUBLE,
+                           buf_recv,grecvcount,grecvdispl,MPI_DOUBLE,graph_reverse[iswap]);
+
+    if (sendself[iswap]) {
+      if (comm_f_only) {
+        avec->unpack_reverse(sendnum[iswap][nsend],sendlist[iswap][nsend],
+                             f[firstrecv[iswap][nrecv]]);
+      } else {
+        avec->pack_reverse(recvnum[iswap][nrecv],firstrecv[iswap][nrecv],buf_send);
+        avec->unpack_reverse(sendnum[iswap][nsend],sendlist[iswap][nsend],buf_send);
+      }
+    }
+
+    for (i = 0; i < nsend; i++)
+      avec->unpack_reverse(sendnum[iswap][i],sendlist[iswap][i],
+                           &buf_recv[size_reverse*reverse_recv_offset[iswap][i]]);
+  }
+}
+
 /* ----------------------------------------------------------------------
    exchange: move atoms to correct processors
    atoms exchanged with procs that touch sub-box in each of 3 dims
@@ -1068,6 +1324,8 @@ void CommTiled::borders()
   double **x;
   AtomVec *avec = atom->avec;
 
+  atom->soa_current = 0;
+
   // After exchanging, need to reconstruct collection array for border communication
   if (mode == Comm::MULTI) neighbor->build_collection(0);
 
@@ -1247,14 +1505,20 @@ void CommTiled::borders()
     nsend = nsendproc[iswap] - sendself[iswap];
     nrecv = nrecvproc[iswap] - sendself[iswap];
 
-    if (recvother[iswap])
-      for (m = 0; m < nrecv; m++)
-        MPI_Irecv(&recvnum[iswap][m],1,MPI_INT,recvproc[iswap][m],0,world,&requests[m]);
-    if (sendother[iswap])
-      for (m = 0; m < nsend; m++)
-        MPI_Send(&sendnum[iswap][m],1,MPI_INT,sendproc[iswap][m],0,world);
-    if (sendself[iswap]) recvnum[iswap][nrecv] = sendnum[iswap][nsend];
-    if (recvother[iswap]) MPI_Waitall(nrecv,requests,MPI_STATUS_IGNORE);
+    if (ngraph) {
+      MPI_Neighbor_alltoall(sendnum[iswap],1,MPI_INT,recvnum[iswap],1,MPI_INT,
+                            graph_forward[iswap]);
+      if (sendself[iswap]) recvnum[iswap][nrecv] = sendnum[iswap][nsend];
+    } else {
+      if (recvother[iswap])
+        for (m = 0; m < nrecv; m++)
+          MPI_Irecv(&recvnum[iswap][m],1,MPI_INT,recvproc[iswap][m],0,world,&requests[m]);
+      if (sendother[iswap])
+        for (m = 0; m < nsend; m++)
+          MPI_Send(&sendnum[iswap][m],1,MPI_INT,sendproc[iswap][m],0,world);
+      if (sendself[iswap]) recvnum[iswap][nrecv] = sendnum[iswap][nsend];
+      if (recvother[iswap]) MPI_Waitall(nrecv,requests,MPI_STATUS_IGNORE);
+    }
 
     // setup other per swap/proc values from sendnum and recvnum
 
@@ -1285,15 +1549,21 @@ void CommTiled::borders()
     rmaxall = MAX(rmaxall,ncountall);
 
     // ensure send/recv buffers are large enough for this border comm swap
+    // neighbor collectives pack sends to all procs into buf_send at once
 
-    if (smaxone*size_border > maxsend) grow_send(smaxone*size_border,0);
+    if (ngraph) {
+      if (smaxall*size_border > maxsend) grow_send(smaxall*size_border,0);
+    } else if (smaxone*size_border > maxsend) grow_send(smaxone*size_border,0);
     if (rmaxall*size_border > maxrecv) grow_recv(rmaxall*size_border);
 
     // swap atoms with other procs using pack_border(), unpack_border()
     // can use Waitany() because calls to unpack_border()
     //   increment per-atom arrays as much as needed
 
-    if (ghost_velocity) {
+    if (ngraph) {
+      borders_exchange_collective(iswap,nsend,nrecv);
+
+    } else if (ghost_velocity) {
       if (recvother[iswap]) {
         for (m = 0; m < nrecv; m++)
           MPI_Irecv(&buf_recv[size_border*forward_recv_offset[iswap][m]],
@@ -1366,9 +1636,12 @@ void CommTiled::borders()
 
   // ensure send/recv buffers are long enough for all forward & reverse comm
   // send buf is for one forward or reverse sends to one proc
+  //   or for all sends in one swap with neighbor collectives
   // recv buf is for all forward or reverse recvs in one swap
 
-  int max = MAX(maxforward*smaxone,maxreverse*rmaxone);
+  int max;
+  if (ngraph) max = MAX(maxforward*smaxall,maxreverse*rmaxall);
+  else max = MAX(maxforward*smaxone,maxreverse*rmaxone);
   if (max > maxsend) grow_send(max,0);
   max = MAX(maxforward*rmaxall,maxreverse*smaxall);
   if (max > maxrecv) grow_recv(max);
@@ -1378,6 +1651,59 @@ void CommTiled::borders()
   if (map_style != Atom::MAP_NONE) atom->map_set();
 }
 
+/* ----------------------------------------------------------------------
+   swap border atoms of one swap with one neighbor alltoallv
+   recvnum and offsets for this swap must already be set
+------------------------------------------------------------------------- */
+
+void CommTiled::borders_exchange_collective(int iswap, int nsend, int nrecv)
+{
+  int m,n,offset;
+  AtomVec *avec = atom->avec;
+
+  offset = 0;
+  for (m = 0; m < nsend; m++) {
+    if (ghost_velocity)
+      n = avec->pack_border_vel(sendnum[iswap][m],sendlist[iswap][m],
+                                &buf_send[offset],pbc_flag[iswap][m],pbc[iswap][m]);
+    else
+      n = avec->pack_border(sendnum[iswap][m],sendlist[iswap][m],
+                            &buf_send[offset],pbc_flag[iswap][m],pbc[iswap][m]);
+    gsendcount[m] = n;
+    gsenddispl[m] = offset;
+    offset += n;
+  }
+
+  for (m = 0; m < nrecv; m++) {
+    grecvcount[m] = recvnum[iswap][m]*size_border;
+    grecvdispl[m] = size_border*forward_recv_offset[iswap][m];
+  }
+
+  MPI_Neighbor_alltoallv(buf_send,gsendcount,gsenddispl,MPI_DOUBLE,
+                         buf_recv,grecvcount,grecvdispl,MPI_DOUBLE,graph_forward[iswap]);
+
+  if (sendself[iswap]) {
+    if (ghost_velocity) {
+      avec->pack_border_vel(sendnum[iswap][nsend],sendlist[iswap][nsend],
+                            buf_send,pbc_flag[iswap][nsend],pbc[iswap][nsend]);
+      avec->unpack_border_vel(recvnum[iswap][nrecv],firstrecv[iswap][nrecv],buf_send);
+    } else {
+      avec->pack_border(sendnum[iswap][nsend],sendlist[iswap][nsend],
+                        buf_send,pbc_flag[iswap][nsend],pbc[iswap][nsend]);
+      avec->unpack_border(recvnum[iswap][nrecv],firstrecv[iswap][nrecv],buf_send);
+    }
+  }
+
+  for (m = 0; m < nrecv; m++) {
+    if (ghost_velocity)
+      avec->unpack_border_vel(recvnum[iswap][m],firstrecv[iswap][m],
+                              &buf_recv[size_border*forward_recv_offset[iswap][m]]);
+    else
+      avec->unpack_border(recvnum[iswap][m],firstrecv[iswap][m],
+                          &buf_recv[size_border*forward_recv_offset[iswap][m]]);
+  }
+}
+
 /* ----------------------------------------------------------------------
    forward communication invoked by a Pair
    nsize used only to set recv buffer limit
@@ -100,6 +100,17 @@ class CommTiled : public Comm {
   int maxrequest;    // max size of Request vector
   MPI_Request *requests;
 
+  // neighborhood collective comm info, proc lists do not include self
+
+  int ngraph;                      // # of swaps with graph communicators
+  MPI_Comm *graph_forward;         // graph comm of forward comm per swap
+  MPI_Comm *graph_reverse;         // graph comm of reverse comm per swap
+  int **graphsend, **graphrecv;    // proc lists the graphs were built from
+  int *ngraphsend, *ngraphrecv;    // # of procs in those lists per swap
+  int maxgraphproc;                // current max # of procs in graph lists
+  int *gsendcount, *gsenddispl;    // per-neighbor counts and displacements
+  int *grecvcount, *grecvdispl;    //   for neighbor alltoall calls
+
   struct RCBinfo {
     double mysplit[3][2];    // fractional RCB bounding box for one proc
     double cutfrac;          // fractional position of cut this proc owns
@@ -154,6 +165,12 @@ class CommTiled : public Comm {
   void grow_swap_send_multi(int, int);    // grow multi swap arrays for send and recv
   void grow_swap_recv(int, int);
   void deallocate_swap(int);    // deallocate swap arrays
+
+  void setup_graph();                    // build neighborhood graphs
+  void free_graph();                     // free neighborhood graphs
+  void forward_comm_collective();        // forward comm with neighbor collectives
+  void reverse_comm_collective();        // reverse comm with neighbor collectives
+  void borders_exchange_collective(int, int, int);    // borders swap with collectives
 };
 
 }    // namespace LAMMPS_NS
@@ -29,6 +29,7 @@
 
 #include <cstring>
 #include <stdexcept>
+#include <thread>
 
 using namespace LAMMPS_NS;
 
@@ -42,6 +43,25 @@ static constexpr double EPSILON = 1.0e-6;
 
 enum { ASCEND, DESCEND };
 
+/* ----------------------------------------------------------------------
+   copy of one snapshot as received by a filewriter proc
+   written to file by a background thread while the run continues
+------------------------------------------------------------------------- */
+
+struct Dump::AsyncWriter {
+  std::thread thread;            // thread writing the snapshot
+  int active;                    // 1 if thread was started and not yet joined
+  char *buf;                     // data of all procs in my cluster
+  bigint maxbuf;                 // allocated size of buf in bytes
+  bigint nbuf;                   // used size of buf in bytes
+  std::vector<int> count;        // # of lines or chars from each proc
+  std::vector<bigint> offset;    // offset of data from each proc in buf
+  int errflag;                   // 1 if writing file failed
+  std::string errmsg;            // system error message if writing failed
+
+  AsyncWriter() : active(0), buf(nullptr), maxbuf(0), nbuf(0), errflag(0) {}
+};
+
 /* ---------------------------------------------------------------------- */
 
 Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
@@ -50,7 +70,7 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
     format_int_user(nullptr), format_bigint_user(nullptr), format_column_user(nullptr), fp(nullptr),
     nameslist(nullptr), buf(nullptr), sbuf(nullptr), ids(nullptr), bufsort(nullptr),
     idsort(nullptr), index(nullptr), proclist(nullptr), xpbc(nullptr), vpbc(nullptr),
-    imagepbc(nullptr), irregular(nullptr)
+    imagepbc(nullptr), irregular(nullptr), async(nullptr)
 {
   MPI_Comm_rank(world, &me);
   MPI_Comm_size(world, &nprocs);
@@ -77,6 +97,8 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  async_allow = 0;
+  async_flag = 0;
   padflag = 0;
   pbcflag = 0;
   time_flag = 0;
@@ -140,6 +162,15 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
 
 Dump::~Dump()
 {
+  // Output waits for pending writes before deleting a dump,
+  //   since derived classes free data needed by write_data()
+
+  if (async) {
+    if (async->active) async->thread.join();
+    memory->sfree(async->buf);
+    delete async;
+  }
+
   delete[] id;
   delete[] style;
   delete[] filename;
@@ -200,6 +231,7 @@ Dump::~Dump()
 
 void Dump::init()
 {
+  async_wait();
   init_style();
 
   if (!sort_flag) {
@@ -328,6 +360,10 @@ void Dump::write()
   imageint *imagehold;
   double **xhold,**vhold;
 
+  // previous snapshot must be completely written before using fp again
+
+  async_wait();
+
   // simulation box bounds
 
   if (domain->triclinic == 0) {
@@ -486,9 +522,10 @@ void Dump::write()
           nlines /= size_one;
         } else nlines = nme;
 
-        write_data(nlines,buf);
+        if (async_flag) async_store(nlines,buf,(bigint) nlines*size_one*sizeof(double));
+        else write_data(nlines,buf);
       }
-      if (flush_flag && fp) fflush(fp);
+      if (flush_flag && fp && !async_flag) fflush(fp);
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -507,9 +544,10 @@ void Dump::write()
           MPI_Get_count(&status,MPI_CHAR,&nchars);
         } else nchars = nsme;
 
-        write_data(nchars,(double *) sbuf);
+        if (async_flag) async_store(nchars,sbuf,nchars);
+        else write_data(nchars,(double *) sbuf);
       }
-      if (flush_flag && fp) fflush(fp);
+      if (flush_flag && fp && !async_flag) fflush(fp);
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -530,6 +568,13 @@ void Dump::write()
 
   if (refreshflag) irefresh->refresh();
 
+  // background thread writes data, footer, and closes file if needed
+
+  if (async_flag && filewriter && fp != nullptr) {
+    async_start();
+    return;
+  }
+
   if (filewriter && fp != nullptr) write_footer();
 
   if (fp && ferror(fp)) error->one(FLERR,"Error writing dump {}: {}", id, utils::getsyserror());
@@ -1040,6 +1085,82 @@ void Dump::balance()
   delete[] request;
 }
 
+/* ----------------------------------------------------------------------
+   append data received from one proc in my cluster to async buffer
+   n = # of lines or chars as passed to write_data()
+   nbytes = size of data
+------------------------------------------------------------------------- */
+
+void Dump::async_store(int n, void *data, bigint nbytes)
+{
+  if (!async) async = new AsyncWriter();
+
+  // keep offsets aligned for data stored as doubles
+
+  bigint offset = (async->nbuf + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+  if (offset + nbytes > async->maxbuf) {
+    async->maxbuf = offset + nbytes;
+    async->buf = (char *) memory->srealloc(async->buf,async->maxbuf,"dump:async_buf");
+  }
+
+  if (nbytes) memcpy(async->buf + offset,data,nbytes);
+  async->count.push_back(n);
+  async->offset.push_back(offset);
+  async->nbuf = offset + nbytes;
+}
+
+/* ----------------------------------------------------------------------
+   start background thread which writes stored data to file
+   also does flush, footer, and closing of file per timestep
+   no MPI calls or errors are allowed in the thread
+------------------------------------------------------------------------- */
+
+void Dump::async_start()
+{
+  if (!async) async = new AsyncWriter();
+
+  async->active = 1;
+  async->thread = std::thread([this]() {
+    int nchunk = async->count.size();
+    for (int i = 0; i < nchunk; i++)
+      write_data(async->count[i],(double *) (async->buf + async->offset[i]));
+    if (flush_flag) fflush(fp);
+    write_footer();
+
+    if (ferror(fp)) {
+      async->errflag = 1;
+      async->errmsg = utils::getsyserror();
+    }
+
+    if (multifile) {
+      if (compressed) platform::pclose(fp);
+      else fclose(fp);
+    }
+  });
+}
+
+/* ----------------------------------------------------------------------
+   wait until background thread has finished writing previous snapshot
+   check = 0 when called from a destructor, where no error can be raised
+------------------------------------------------------------------------- */
+
+void Dump::async_wait(int check)
+{
+  if (!async) return;
+
+  if (async->active) {
+    async->thread.join();
+    async->active = 0;
+    if (multifile) fp = nullptr;
+  }
+  async->count.clear();
+  async->offset.clear();
+  async->nbuf = 0;
+
+  if (check && async->errflag)
+    error->one(FLERR,"Error writing dump {}: {}", id, async->errmsg);
+}
+
 /* ----------------------------------------------------------------------
    process params common to all dumps here
    if unknown param, call modify_param specific to the dump
@@ -1049,6 +1170,8 @@ void Dump::modify_params(int narg, char **arg)
 {
   if (narg == 0) utils::missing_cmd_args(FLERR, "dump_modify", error);
 
+  async_wait();
+
   int iarg = 0;
   while (iarg < narg) {
     if (strcmp(arg[iarg],"append") == 0) {
@@ -1056,6 +1179,13 @@ void Dump::modify_params(int narg, char **arg)
       append_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify async", error);
+      async_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (async_flag && async_allow == 0)
+        error->all(FLERR,"Dump_modify async yes not allowed for this style");
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"balance") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify balance", error);
       if (nprocs > 1)
@@ -1353,6 +1483,7 @@ double Dump::memory_usage()
 {
   double bytes = memory->usage(buf,maxbuf);
   bytes += memory->usage(sbuf,maxsbuf);
+  if (async) bytes += (double) async->maxbuf;
   if (sort_flag) {
     if (sortcol == 0) bytes += memory->usage(ids,maxids);
     bytes += memory->usage(bufsort,size_one*maxsort);
@@ -74,6 +74,8 @@ class Dump : protected Pointers {
   int append_flag;          // 1 if open file in append mode, 0 if not
   int buffer_allow;         // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;          // 1 if buffer output as one big string, 0 if not
+  int async_allow;          // 1 if style allows for async_flag, 0 if not
+  int async_flag;           // 1 if file writes are done by a background thread
   int padflag;              // timestep padding in filename
   int pbcflag;              // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;    // 1 = one big file, already opened, else 0
@@ -151,6 +153,9 @@ class Dump : protected Pointers {
 
   class Irregular *irregular;
 
+  struct AsyncWriter;     // background thread writing previous snapshot
+  AsyncWriter *async;
+
   virtual void init_style() = 0;
   virtual void openfile();
   virtual int modify_param(int, char **) { return 0; }
@@ -175,6 +180,9 @@ class Dump : protected Pointers {
   static int bufcompare_reverse(const int, const int, void *);
 #endif
   void balance();
+  void async_store(int, void *, bigint);
+  void async_start();
+  void async_wait(int check = 1);
 };
 
 }    // namespace LAMMPS_NS
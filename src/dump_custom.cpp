@@ -25,7 +25,9 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "profiler.h"
 #include "region.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -87,6 +89,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
 
   triclinic_general = 0;
   nthresh = 0;
@@ -621,6 +624,7 @@ int DumpCustom::count()
         error->all(FLERR,"Dump compute ID {} cannot be invoked before initialization by a run",
           compute[i]->id);
       if (!(compute[i]->invoked_flag & Compute::INVOKED_PERATOM)) {
+        ProfileScope prof(timer->profiler, compute[i]);
         compute[i]->compute_peratom();
         compute[i]->invoked_flag |= Compute::INVOKED_PERATOM;
       }
@@ -72,6 +72,7 @@ DumpImage::DumpImage(LAMMPS *lmp, int narg, char **arg) :
 
   binary = 1;
   multifile_override = 0;
+  async_allow = 0;
 
   // flag has_id as true to avoid bogus warnings about atom IDs for dump styles derived from DumpCustom
 
@@ -0,0 +1,239 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "dump_indexed.h"
+
+#include "domain.h"
+#include "error.h"
+#include "memory.h"
+#include "update.h"
+
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+DumpIndexed::DumpIndexed(LAMMPS *lmp, int narg, char **arg) :
+    DumpCustom(lmp, narg, arg), fpindex(nullptr), magic(MAGIC_STRING), revision(FORMAT_REVISION),
+    maxcol(0), ibuf(nullptr), bbuf(nullptr), dbuf(nullptr)
+{
+  if (compressed) error->all(FLERR, "Dump indexed cannot write compressed files");
+
+  // always binary, data is written column by column per chunk
+
+  binary = 1;
+  buffer_allow = 0;
+  buffer_flag = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+DumpIndexed::~DumpIndexed()
+{
+  // pending asynchronous writes must finish before the index is closed
+
+  async_wait(0);
+  if (fpindex) fclose(fpindex);
+  memory->destroy(ibuf);
+  memory->destroy(bbuf);
+  memory->destroy(dbuf);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpIndexed::init_style()
+{
+  if (triclinic_general)
+    error->all(FLERR, "Dump indexed does not support general triclinic boxes");
+  if (!write_header_flag) error->all(FLERR, "Dump indexed requires dump_modify header yes");
+  DumpCustom::init_style();
+}
+
+/* ----------------------------------------------------------------------
+   open dump file and its index file and write the file header if empty
+   same file naming logic as Dump::openfile()
+------------------------------------------------------------------------- */
+
+void DumpIndexed::openfile()
+{
+  // single file, already opened, so just return
+
+  if (singlefile_opened) return;
+  if (multifile == 0) singlefile_opened = 1;
+
+  unit_count = 0;
+
+  // if one file per timestep, replace '*' with current timestep
+
+  char *filecurrent = filename;
+  if (multiproc) filecurrent = multiname;
+
+  if (multifile) {
+    filecurrent = utils::strdup(utils::star_subst(filecurrent, update->ntimestep, padflag));
+    if (maxfiles > 0) {
+      if (numfiles < maxfiles) {
+        nameslist[numfiles] = utils::strdup(filecurrent);
+        ++numfiles;
+      } else {
+        remove(nameslist[fileidx]);
+        remove((std::string(nameslist[fileidx]) + ".index").c_str());
+        delete[] nameslist[fileidx];
+        nameslist[fileidx] = utils::strdup(filecurrent);
+        fileidx = (fileidx + 1) % maxfiles;
+      }
+    }
+  }
+
+  // each proc with filewriter = 1 opens a file and its index
+  // with append, the header is only written if the file is new or empty
+
+  if (filewriter) {
+    if (fpindex) fclose(fpindex);
+    std::string indexname = std::string(filecurrent) + ".index";
+
+    fp = fopen(filecurrent, append_flag ? "ab" : "wb");
+    if (fp == nullptr)
+      error->one(FLERR, "Cannot open dump file {}: {}", filecurrent, utils::getsyserror());
+    fpindex = fopen(indexname.c_str(), append_flag ? "ab" : "wb");
+    if (fpindex == nullptr)
+      error->one(FLERR, "Cannot open dump index file {}: {}", indexname, utils::getsyserror());
+
+    platform::fseek(fp, platform::END_OF_FILE);
+    if (platform::ftell(fp) == 0) write_file_header();
+  } else fp = nullptr;
+
+  // delete string with timestep replaced
+
+  if (multifile) delete[] filecurrent;
+}
+
+/* ----------------------------------------------------------------------
+   file header: magic string, endian and revision flags,
+   column count, per-column storage types, derived class column info,
+   column labels, unit style
+------------------------------------------------------------------------- */
+
+void DumpIndexed::write_file_header()
+{
+  bigint len = strlen(magic);
+  bigint nlen = -len;
+  int endian = ENDIAN;
+  fwrite(&nlen, sizeof(bigint), 1, fp);
+  fwrite(magic, sizeof(char), len, fp);
+  fwrite(&endian, sizeof(int), 1, fp);
+  fwrite(&revision, sizeof(int), 1, fp);
+
+  fwrite(&nfield, sizeof(int), 1, fp);
+  for (int j = 0; j < nfield; j++) {
+    int coltype = COL_INT;
+    if (vtype[j] == Dump::BIGINT) coltype = COL_BIGINT;
+    else if (vtype[j] == Dump::DOUBLE) coltype = COL_DOUBLE;
+    fwrite(&coltype, sizeof(int), 1, fp);
+  }
+  write_column_info();
+
+  int n = strlen(columns);
+  fwrite(&n, sizeof(int), 1, fp);
+  fwrite(columns, sizeof(char), n, fp);
+
+  n = unit_flag ? strlen(update->unit_style) : 0;
+  fwrite(&n, sizeof(int), 1, fp);
+  if (n) fwrite(update->unit_style, sizeof(char), n, fp);
+}
+
+/* ----------------------------------------------------------------------
+   append (timestep, offset) of this snapshot to the index, then
+   write snapshot header: timestep, natoms, time, box, # of chunks
+------------------------------------------------------------------------- */
+
+void DumpIndexed::write_header(bigint ndump)
+{
+  bigint offset = platform::ftell(fp);
+  fwrite(&update->ntimestep, sizeof(bigint), 1, fpindex);
+  fwrite(&offset, sizeof(bigint), 1, fpindex);
+  if (flush_flag) fflush(fpindex);
+
+  fwrite(&update->ntimestep, sizeof(bigint), 1, fp);
+  fwrite(&ndump, sizeof(bigint), 1, fp);
+
+  char flag = time_flag ? 1 : 0;
+  fwrite(&flag, sizeof(char), 1, fp);
+  if (time_flag) {
+    double t = compute_time();
+    fwrite(&t, sizeof(double), 1, fp);
+  }
+
+  fwrite(&domain->triclinic, sizeof(int), 1, fp);
+  fwrite(&domain->boundary[0][0], 6 * sizeof(int), 1, fp);
+  fwrite(&boxxlo, sizeof(double), 1, fp);
+  fwrite(&boxxhi, sizeof(double), 1, fp);
+  fwrite(&boxylo, sizeof(double), 1, fp);
+  fwrite(&boxyhi, sizeof(double), 1, fp);
+  fwrite(&boxzlo, sizeof(double), 1, fp);
+  fwrite(&boxzhi, sizeof(double), 1, fp);
+  if (domain->triclinic) {
+    fwrite(&boxxy, sizeof(double), 1, fp);
+    fwrite(&boxxz, sizeof(double), 1, fp);
+    fwrite(&boxyz, sizeof(double), 1, fp);
+  }
+
+  fwrite(&nclusterprocs, sizeof(int), 1, fp);
+
+  // size column buffers for the largest chunk here, since write_data()
+  //   may run in the background thread of dump_modify async
+  // buffered derived styles write their own encoding and need none
+
+  int nmax = maxbuf / size_one;
+  if (!buffer_flag && (nmax > maxcol)) {
+    maxcol = nmax;
+    memory->destroy(ibuf);
+    memory->destroy(bbuf);
+    memory->destroy(dbuf);
+    memory->create(ibuf, maxcol, "dump:ibuf");
+    memory->create(bbuf, maxcol, "dump:bbuf");
+    memory->create(dbuf, maxcol, "dump:dbuf");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   write one chunk of N atoms: count, then each column with its own type
+   column buffers were sized in write_header()
+------------------------------------------------------------------------- */
+
+void DumpIndexed::write_data(int n, double *mybuf)
+{
+  fwrite(&n, sizeof(int), 1, fp);
+
+  for (int j = 0; j < nfield; j++) {
+    if (vtype[j] == Dump::DOUBLE) {
+      for (int i = 0; i < n; i++) dbuf[i] = mybuf[i * nfield + j];
+      fwrite(dbuf, sizeof(double), n, fp);
+    } else if (vtype[j] == Dump::BIGINT) {
+      for (int i = 0; i < n; i++) bbuf[i] = static_cast<bigint>(mybuf[i * nfield + j]);
+      fwrite(bbuf, sizeof(bigint), n, fp);
+    } else {
+      for (int i = 0; i < n; i++) ibuf[i] = static_cast<int>(mybuf[i * nfield + j]);
+      fwrite(ibuf, sizeof(int), n, fp);
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double DumpIndexed::memory_usage()
+{
+  double bytes = DumpCustom::memory_usage();
+  bytes += (double) maxcol * (sizeof(int) + sizeof(bigint) + sizeof(double));
+  return bytes;
+}
@@ -0,0 +1,63 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef DUMP_CLASS
+// clang-format off
+DumpStyle(indexed,DumpIndexed);
+// clang-format on
+#else
+
+#ifndef LMP_DUMP_INDEXED_H
+#define LMP_DUMP_INDEXED_H
+
+#include "dump_custom.h"
+
+namespace LAMMPS_NS {
+
+class DumpIndexed : public DumpCustom {
+ public:
+  DumpIndexed(class LAMMPS *, int, char **);
+  ~DumpIndexed() override;
+  double memory_usage() override;
+
+  // per-column storage types in the file
+
+  enum { COL_INT, COL_BIGINT, COL_DOUBLE };
+
+  static constexpr const char *MAGIC_STRING = "DUMPINDEXED";
+  static constexpr int FORMAT_REVISION = 0x0001;
+  static constexpr int ENDIAN = 0x0001;
+
+ protected:
+  FILE *fpindex;        // sidecar file with (timestep, offset) pairs
+  const char *magic;    // magic string and format revision of the file header
+  int revision;
+
+  int maxcol;            // allocated length of column scratch buffers
+  int *ibuf;             // scratch for one column of 32-bit ints
+  bigint *bbuf;          // scratch for one column of 64-bit ints
+  double *dbuf;          // scratch for one column of doubles
+
+  void init_style() override;
+  void openfile() override;
+  void write_header(bigint) override;
+  void write_data(int, double *) override;
+
+  void write_file_header();
+  virtual void write_column_info() {}
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -21,6 +21,8 @@
 #include "fix.h"
 #include "memory.h"
 #include "modify.h"
+#include "profiler.h"
+#include "timer.h"
 #include "update.h"
 
 #include <cstring>
@@ -65,6 +67,7 @@ DumpLocal::DumpLocal(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
 
   // computes & fixes which the dump accesses
 
@@ -333,6 +336,7 @@ int DumpLocal::count()
         error->all(FLERR,"Dump compute ID {} cannot be invoked before initialization by a run",
           compute[i]->id);
       if (!(compute[i]->invoked_flag & Compute::INVOKED_LOCAL)) {
+        ProfileScope prof(timer->profiler, compute[i]);
         compute[i]->compute_local();
         compute[i]->invoked_flag |= Compute::INVOKED_LOCAL;
       }
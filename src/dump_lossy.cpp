@@ -0,0 +1,257 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "dump_lossy.h"
+
+#include "error.h"
+#include "memory.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+// encoding of one chunk = atoms of one proc:
+//   # of bytes that follow (int), # of atoms (int), then each column
+// lossless floating-point column:
+//   each value XORed with the previous one, stored as
+//   # of leading zero bytes followed by the remaining bytes
+// integer column or floating-point column with error bound B:
+//   values are mapped to integers, floating-point values as round(value/2B)
+//   # of escapes (varint), then per escape the index distance to
+//     the previous escape (varint) and the value as raw double
+//   then differences to the previous integer as zigzag codes,
+//     bit-packed in blocks of BLOCK values with the bit width of the block
+//     stored in the leading byte
+// escapes are floating-point values too large to quantize or not finite
+
+static constexpr double MAXQUANT = 4.0e15;    // larger multiples are escaped
+
+/* ---------------------------------------------------------------------- */
+
+static void put_varint(std::vector<char> &out, uint64_t u)
+{
+  while (u >= 0x80) {
+    out.push_back((char) ((u & 0x7f) | 0x80));
+    u >>= 7;
+  }
+  out.push_back((char) u);
+}
+
+/* ---------------------------------------------------------------------- */
+
+static void put_raw(std::vector<char> &out, const void *ptr, size_t n)
+{
+  const char *bytes = (const char *) ptr;
+  out.insert(out.end(), bytes, bytes + n);
+}
+
+/* ----------------------------------------------------------------------
+   pack N values with the smallest common bit width
+------------------------------------------------------------------------- */
+
+static void put_block(std::vector<char> &out, const uint64_t *u, int n)
+{
+  uint64_t all = 0;
+  for (int i = 0; i < n; i++) all |= u[i];
+  int width = 0;
+  while ((width < 64) && (all >> width)) width++;
+  out.push_back((char) width);
+
+  uint64_t acc = 0;
+  int nacc = 0;
+  for (int i = 0; i < n; i++) {
+    uint64_t v = u[i];
+    for (int left = width; left > 0;) {
+      int take = (left < 32) ? left : 32;
+      acc |= (v & ((1ULL << take) - 1)) << nacc;
+      v >>= take;
+      nacc += take;
+      left -= take;
+      while (nacc >= 8) {
+        out.push_back((char) (acc & 0xff));
+        acc >>= 8;
+        nacc -= 8;
+      }
+    }
+  }
+  if (nacc) out.push_back((char) acc);
+}
+
+/* ---------------------------------------------------------------------- */
+
+DumpLossy::DumpLossy(LAMMPS *lmp, int narg, char **arg) : DumpIndexed(lmp, narg, arg)
+{
+  // each proc encodes its atoms in convert_string(), which Dump::write()
+  // only calls for buffered text output; the file is still opened as binary
+
+  binary = 0;
+  buffer_flag = 1;
+  magic = MAGIC_STRING;
+  revision = FORMAT_REVISION;
+
+  bound.resize(nfield, 0.0);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpLossy::init_style()
+{
+  buffer_flag = 1;
+  DumpIndexed::init_style();
+}
+
+/* ----------------------------------------------------------------------
+   file header: same as dump indexed plus the error bound of each column
+------------------------------------------------------------------------- */
+
+void DumpLossy::write_column_info()
+{
+  fwrite(bound.data(), sizeof(double), nfield, fp);
+}
+
+/* ----------------------------------------------------------------------
+   encode my N atoms into sbuf, called by all procs
+   return # of bytes, or -1 if the chunk is too large
+------------------------------------------------------------------------- */
+
+int DumpLossy::convert_string(int n, double *mybuf)
+{
+  encbuf.resize(2 * sizeof(int));
+  for (int j = 0; j < nfield; j++) encode_column(n, mybuf, j);
+
+  bigint nbytes = encbuf.size();
+  if (nbytes > MAXSMALLINT) return -1;
+  int nfollow = nbytes - sizeof(int);
+  memcpy(&encbuf[0], &nfollow, sizeof(int));
+  memcpy(&encbuf[sizeof(int)], &n, sizeof(int));
+
+  if (nbytes > maxsbuf) {
+    maxsbuf = nbytes;
+    memory->grow(sbuf, maxsbuf, "dump:sbuf");
+  }
+  memcpy(sbuf, encbuf.data(), nbytes);
+  return nbytes;
+}
+
+/* ----------------------------------------------------------------------
+   append column J of N packed atoms to encbuf
+------------------------------------------------------------------------- */
+
+void DumpLossy::encode_column(int n, double *mybuf, int j)
+{
+  uint64_t prev = 0;
+
+  if ((vtype[j] == Dump::DOUBLE) && (bound[j] == 0.0)) {
+    for (int i = 0; i < n; i++) {
+      uint64_t u;
+      memcpy(&u, &mybuf[i * size_one + j], sizeof(double));
+      uint64_t x = u ^ prev;
+      prev = u;
+
+      int lz = 0;
+      while ((lz < 8) && (((x >> (56 - 8 * lz)) & 0xff) == 0)) lz++;
+      encbuf.push_back((char) lz);
+      for (int k = 7 - lz; k >= 0; k--) encbuf.push_back((char) ((x >> (8 * k)) & 0xff));
+    }
+    return;
+  }
+
+  // residuals use unsigned arithmetic, which wraps around consistently
+
+  double step = 2.0 * bound[j];
+  resid.resize(n);
+  escape.clear();
+
+  for (int i = 0; i < n; i++) {
+    double value = mybuf[i * size_one + j];
+    uint64_t q;
+    if (vtype[j] == Dump::DOUBLE) {
+      double d = value / step;
+      if (!(fabs(d) < MAXQUANT)) {
+        escape.push_back(i);
+        resid[i] = 0;
+        continue;
+      }
+      q = (uint64_t) llround(d);
+    } else q = (uint64_t) static_cast<int64_t>(value);
+
+    uint64_t d = q - prev;
+    resid[i] = (d << 1) ^ (uint64_t) ((int64_t) d >> 63);
+    prev = q;
+  }
+
+  put_varint(encbuf, escape.size());
+  int last = 0;
+  for (int i : escape) {
+    put_varint(encbuf, i - last);
+    put_raw(encbuf, &mybuf[i * size_one + j], sizeof(double));
+    last = i;
+  }
+
+  for (int i = 0; i < n; i += BLOCK) put_block(encbuf, &resid[i], MIN(BLOCK, n - i));
+}
+
+/* ----------------------------------------------------------------------
+   write one encoded chunk of N bytes
+------------------------------------------------------------------------- */
+
+void DumpLossy::write_data(int n, double *mybuf)
+{
+  fwrite(mybuf, sizeof(char), n, fp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DumpLossy::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0], "bound") == 0) {
+    if (narg < 3) utils::missing_cmd_args(FLERR, "dump_modify bound", error);
+    double value = utils::numeric(FLERR, arg[2], false, lmp);
+    if (value < 0.0) error->all(FLERR, "Dump_modify bound must be >= 0.0");
+
+    // bounds are stored in the file header and cannot change within a file
+
+    if (singlefile_opened)
+      error->all(FLERR, "Dump_modify bound cannot be changed after the dump file was opened");
+
+    if (strcmp(arg[1], "*") == 0) {
+      for (int j = 0; j < nfield; j++)
+        if (vtype[j] == Dump::DOUBLE) bound[j] = value;
+      return 3;
+    }
+
+    int icol = -1;
+    if (utils::is_integer(arg[1])) icol = utils::inumeric(FLERR, arg[1], false, lmp) - 1;
+    else if (key2col.count(arg[1])) icol = key2col[arg[1]];
+    if ((icol < 0) || (icol >= nfield))
+      error->all(FLERR, "Unknown dump_modify bound column {}", arg[1]);
+    if (vtype[icol] != Dump::DOUBLE)
+      error->all(FLERR, "Dump_modify bound column {} is not a floating-point column", arg[1]);
+    bound[icol] = value;
+    return 3;
+  }
+
+  return DumpIndexed::modify_param(narg, arg);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double DumpLossy::memory_usage()
+{
+  double bytes = DumpIndexed::memory_usage();
+  bytes += (double) encbuf.capacity();
+  bytes += (double) resid.capacity() * sizeof(uint64_t);
+  bytes += (double) escape.capacity() * sizeof(int);
+  return bytes;
+}
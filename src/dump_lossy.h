@@ -0,0 +1,57 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef DUMP_CLASS
+// clang-format off
+DumpStyle(lossy,DumpLossy);
+// clang-format on
+#else
+
+#ifndef LMP_DUMP_LOSSY_H
+#define LMP_DUMP_LOSSY_H
+
+#include "dump_indexed.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class DumpLossy : public DumpIndexed {
+ public:
+  DumpLossy(class LAMMPS *, int, char **);
+  double memory_usage() override;
+
+  static constexpr const char *MAGIC_STRING = "DUMPLOSSY";
+  static constexpr int FORMAT_REVISION = 0x0001;
+  static constexpr int BLOCK = 64;    // # of values bit-packed with a common width
+
+ protected:
+  std::vector<double> bound;      // absolute error bound of each column, 0.0 = lossless
+  std::vector<char> encbuf;       // encoded chunk of my atoms
+  std::vector<uint64_t> resid;    // zigzag encoded residuals of one column
+  std::vector<int> escape;        // indices of values of one column stored verbatim
+
+  void init_style() override;
+  int modify_param(int, char **) override;
+  void write_column_info() override;
+  int convert_string(int, double *) override;
+  void write_data(int, double *) override;
+
+  void encode_column(int, double *, int);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -27,6 +27,7 @@
 #include "neighbor.h"           // IWYU pragma: keep
 #include "output.h"
 #include "pair.h"
+#include "profiler.h"
 #include "thermo.h"
 #include "timer.h"              // IWYU pragma: keep
 #include "universe.h"
@@ -75,6 +76,11 @@ void Finish::end(int flag)
 
   const int nthreads = comm->nthreads;
 
+  // dump and restart files must be complete when the run command returns
+
+  output->finish_dumps();
+  output->finish_restart();
+
   // recompute natoms in case atoms have been lost
 
   bigint nblocal = atom->nlocal;
@@ -356,6 +362,15 @@ void Finish::end(int flag)
     }
   }
 
+  // per-instance profile, if enabled with the timer command
+
+  if (timeflag && timer->profiler) {
+    double time_profile = timer->has_loop() ? time_loop : 0.0;
+    timer->profiler->report(time_profile);
+    if (!timer->profiler->json_file.empty())
+      timer->profiler->write_json(timer->profiler->json_file,time_profile);
+  }
+
 #ifdef LMP_OPENMP
   FixOMP *fixomp = dynamic_cast<FixOMP *>(modify->get_fix_by_id("package_omp"));
 
@@ -538,6 +553,8 @@ void Finish::end(int flag)
       if ((atom->molecular != Atom::ATOMIC) && (atom->natoms > 0))
         mesg += fmt::format("Ave special neighs/atom = {:.8}\n",nspec_all/atom->natoms);
       mesg += fmt::format("Neighbor list builds = {}\n",neighbor->ncalls);
+      if (neighbor->partial_flag)
+        mesg += fmt::format("Partial neighbor list rebuilds = {}\n",neighbor->npartial);
       if (neighbor->dist_check)
         mesg += fmt::format("Dangerous builds = {}\n",neighbor->ndanger);
       else mesg += "Dangerous builds not checked\n";
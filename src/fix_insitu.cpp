@@ -0,0 +1,238 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_insitu.h"
+
+#include "arg_info.h"
+#include "atom.h"
+#include "compute.h"
+#include "domain.h"
+#include "error.h"
+#include "modify.h"
+#include "update.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+/* ---------------------------------------------------------------------- */
+
+FixInsitu::FixInsitu(LAMMPS *lmp, int narg, char **arg) :
+    Fix(lmp, narg, arg), callback(nullptr), ptr_caller(nullptr), lastcall(-1)
+{
+  if (narg < 5) utils::missing_cmd_args(FLERR, "fix insitu", error);
+
+  nevery = utils::inumeric(FLERR, arg[3], false, lmp);
+  if (nevery <= 0) error->all(FLERR, "Illegal fix insitu nevery value: {}", nevery);
+
+  // per-atom properties are looked up by name in init()
+
+  for (int iarg = 4; iarg < narg; iarg++) {
+    field_t field;
+    field.name = arg[iarg];
+    field.val.c = nullptr;
+
+    ArgInfo argi(arg[iarg], ArgInfo::COMPUTE | ArgInfo::FIX | ArgInfo::INAME | ArgInfo::DNAME);
+    field.which = argi.get_type();
+    field.id = argi.get_name();
+    field.argindex = argi.get_index1();
+    if ((field.which == ArgInfo::UNKNOWN) || (argi.get_dim() > 1))
+      error->all(FLERR, "Invalid fix insitu argument: {}", arg[iarg]);
+    fields.push_back(field);
+  }
+
+  views.resize(fields.size());
+  for (std::size_t m = 0; m < fields.size(); m++) views[m].name = fields[m].name.c_str();
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixInsitu::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ----------------------------------------------------------------------
+   check validity of all fields, so errors are reported on all procs
+   before the first callback
+------------------------------------------------------------------------- */
+
+void FixInsitu::init()
+{
+  for (auto &field : fields) {
+    int j = field.argindex;
+
+    if (field.which == ArgInfo::NONE) {
+      bool found = false;
+      for (const auto &p : atom->peratom) {
+        if (p.name != field.name) continue;
+        found = true;
+        if ((atom->nmax > 0) && (*(void **) p.address == nullptr))
+          error->all(FLERR, "Fix insitu per-atom property {} is not available", field.name);
+      }
+      if (!found) error->all(FLERR, "Unknown fix insitu per-atom property {}", field.name);
+
+    } else if (field.which == ArgInfo::COMPUTE) {
+      field.val.c = modify->get_compute_by_id(field.id);
+      if (!field.val.c) error->all(FLERR, "Compute ID {} for fix insitu does not exist", field.id);
+      if (field.val.c->peratom_flag == 0)
+        error->all(FLERR, "Fix insitu compute {} does not calculate per-atom values", field.id);
+      if (j && (j > field.val.c->size_peratom_cols))
+        error->all(FLERR, "Fix insitu compute {} array is accessed out-of-range", field.id);
+
+    } else if (field.which == ArgInfo::FIX) {
+      field.val.f = modify->get_fix_by_id(field.id);
+      if (!field.val.f) error->all(FLERR, "Fix ID {} for fix insitu does not exist", field.id);
+      if (field.val.f->peratom_flag == 0)
+        error->all(FLERR, "Fix insitu fix {} does not calculate per-atom values", field.id);
+      if (j && (j > field.val.f->size_peratom_cols))
+        error->all(FLERR, "Fix insitu fix {} array is accessed out-of-range", field.id);
+      if (nevery % field.val.f->peratom_freq)
+        error->all(FLERR, "Fix {} for fix insitu not computed at compatible time", field.id);
+
+    } else {
+      int flag, cols;
+      int index = atom->find_custom(field.id.c_str(), flag, cols);
+      if ((index < 0) || (flag != ((field.which == ArgInfo::DNAME) ? 1 : 0)))
+        error->all(FLERR, "Custom per-atom property {} for fix insitu does not exist", field.id);
+      if (j && (j > cols))
+        error->all(FLERR, "Fix insitu custom per-atom array {} is accessed out-of-range",
+                   field.id);
+    }
+  }
+
+  // computes must know the next step they are invoked on
+
+  bigint nextstep = (update->ntimestep / nevery) * nevery;
+  if (nextstep < update->ntimestep) nextstep += nevery;
+  modify->addstep_compute_all(nextstep);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixInsitu::setup(int /*vflag*/)
+{
+  end_of_step();
+}
+
+/* ----------------------------------------------------------------------
+   point views at the current per-atom data and pass them to the callback
+   nothing is copied, the views are only valid during the callback
+------------------------------------------------------------------------- */
+
+void FixInsitu::end_of_step()
+{
+  bigint ntimestep = update->ntimestep;
+  if ((ntimestep % nevery) || (ntimestep == lastcall)) return;
+  lastcall = ntimestep;
+  if (!callback) return;
+
+  // computes may be invoked, so wrap with clear/add
+
+  modify->clearstep_compute();
+  for (std::size_t m = 0; m < fields.size(); m++) set_view(fields[m], views[m]);
+  modify->addstep_compute(ntimestep + nevery);
+
+  lammps_insitu_frame frame;
+  frame.timestep = ntimestep;
+  frame.nlocal = atom->nlocal;
+  frame.groupbit = groupbit;
+
+  // sublo/subhi are not maintained for triclinic boxes,
+  //   use the bounding box of the subdomain in lamda coords instead
+
+  if (domain->triclinic)
+    domain->bbox(domain->sublo_lamda, domain->subhi_lamda, frame.sublo, frame.subhi);
+  else {
+    for (int k = 0; k < 3; k++) {
+      frame.sublo[k] = domain->sublo[k];
+      frame.subhi[k] = domain->subhi[k];
+    }
+  }
+  frame.nview = views.size();
+  frame.views = views.data();
+
+  callback(ptr_caller, &frame);
+}
+
+/* ----------------------------------------------------------------------
+   set view to the current storage of a field
+   arrays are allocated contiguously, so rows are a fixed stride apart
+------------------------------------------------------------------------- */
+
+void FixInsitu::set_view(field_t &field, lammps_insitu_view &view)
+{
+  int j = field.argindex;
+  int cols = 0;
+  void *ptr = nullptr;
+
+  if (field.which == ArgInfo::NONE) {
+    for (const auto &p : atom->peratom) {
+      if (p.name != field.name) continue;
+      ptr = *(void **) p.address;
+      cols = (p.cols < 0) ? *p.address_maxcols : p.cols;
+      if (p.datatype == Atom::DOUBLE) view.datatype = LAMMPS_DOUBLE;
+      else if (p.datatype == Atom::BIGINT) view.datatype = LAMMPS_INT64;
+      else view.datatype = LAMMPS_INT;
+      break;
+    }
+
+  } else if (field.which == ArgInfo::COMPUTE) {
+    Compute *compute = field.val.c;
+    if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+      compute->compute_peratom();
+      compute->invoked_flag |= Compute::INVOKED_PERATOM;
+    }
+    cols = compute->size_peratom_cols;
+    ptr = cols ? (void *) compute->array_atom : (void *) compute->vector_atom;
+    view.datatype = LAMMPS_DOUBLE;
+
+  } else if (field.which == ArgInfo::FIX) {
+    Fix *fix = field.val.f;
+    cols = fix->size_peratom_cols;
+    ptr = cols ? (void *) fix->array_atom : (void *) fix->vector_atom;
+    view.datatype = LAMMPS_DOUBLE;
+
+  } else {
+    int flag;
+    int index = atom->find_custom(field.id.c_str(), flag, cols);
+    if (flag) ptr = cols ? (void *) atom->darray[index] : (void *) atom->dvector[index];
+    else ptr = cols ? (void *) atom->iarray[index] : (void *) atom->ivector[index];
+    view.datatype = flag ? LAMMPS_DOUBLE : LAMMPS_INT;
+  }
+
+  // for arrays, ptr points to the row pointers
+
+  if (cols && ptr) ptr = ((void **) ptr)[0];
+
+  int size = (view.datatype == LAMMPS_DOUBLE) ? sizeof(double)
+      : ((view.datatype == LAMMPS_INT64) ? sizeof(int64_t) : sizeof(int));
+  if (cols && j) {
+    view.data = ptr ? (const char *) ptr + (bigint) (j - 1) * size : nullptr;
+    view.ncol = 1;
+    view.stride = cols;
+  } else {
+    view.data = ptr;
+    view.ncol = cols ? cols : 1;
+    view.stride = cols ? cols : 1;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixInsitu::set_callback(FnPtr caller_callback, void *caller_ptr)
+{
+  callback = caller_callback;
+  ptr_caller = caller_ptr;
+}
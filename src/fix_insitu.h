@@ -0,0 +1,66 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(insitu,FixInsitu);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_INSITU_H
+#define LMP_FIX_INSITU_H
+
+#include "fix.h"
+#include "library.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class FixInsitu : public Fix {
+ public:
+  FixInsitu(class LAMMPS *, int, char **);
+
+  int setmask() override;
+  void init() override;
+  void setup(int) override;
+  void end_of_step() override;
+
+  typedef void (*FnPtr)(void *, const lammps_insitu_frame *);
+  void set_callback(FnPtr, void *);
+
+ private:
+  struct field_t {
+    std::string name;    // field name as given
+    int which;           // per-atom property or ArgInfo::COMPUTE, FIX, INAME, DNAME
+    std::string id;      // compute, fix, or custom property ID
+    int argindex;        // column (1 to N) of compute, fix, or custom array, 0 for all
+    union {
+      class Compute *c;
+      class Fix *f;
+    } val;
+  };
+  std::vector<field_t> fields;
+  std::vector<lammps_insitu_view> views;
+
+  FnPtr callback;
+  void *ptr_caller;
+  bigint lastcall;    // last timestep the callback was invoked on
+
+  void set_view(field_t &, lammps_insitu_view &);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -2021,6 +2021,17 @@ void FixNH::nve_x()
   int nlocal = atom->nlocal;
   if (igroup == atom->firstgroup) nlocal = atom->nfirst;
 
+  // with atom_modify soa and group all, update x as a flat 3*nlocal stream
+
+  if (atom->soa_flag && (igroup == 0)) {
+    if (nlocal == 0) return;
+    double * _noalias const xx = x[0];
+    const double * _noalias const vv = v[0];
+    const int n3 = 3 * nlocal;
+    for (int k = 0; k < n3; k++) xx[k] += dtv * vv[k];
+    return;
+  }
+
   // x update by full step only for atoms in group
 
   for (int i = 0; i < nlocal; i++) {
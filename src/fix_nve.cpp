@@ -77,6 +77,33 @@ void FixNVE::initial_integrate(int /*vflag*/)
   int nlocal = atom->nlocal;
   if (igroup == atom->firstgroup) nlocal = atom->nfirst;
 
+  // with atom_modify soa and group all no per-atom mask test is needed
+  // and the position update runs over x and v as flat 3*nlocal streams
+
+  if (atom->soa_flag && (igroup == 0)) {
+    if (nlocal == 0) return;
+    if (rmass) {
+      for (int i = 0; i < nlocal; i++) {
+        dtfm = dtf / rmass[i];
+        v[i][0] += dtfm * f[i][0];
+        v[i][1] += dtfm * f[i][1];
+        v[i][2] += dtfm * f[i][2];
+      }
+    } else {
+      for (int i = 0; i < nlocal; i++) {
+        dtfm = dtf / mass[type[i]];
+        v[i][0] += dtfm * f[i][0];
+        v[i][1] += dtfm * f[i][1];
+        v[i][2] += dtfm * f[i][2];
+      }
+    }
+    double * _noalias const xx = x[0];
+    const double * _noalias const vv = v[0];
+    const int n3 = 3 * nlocal;
+    for (int k = 0; k < n3; k++) xx[k] += dtv * vv[k];
+    return;
+  }
+
   if (rmass) {
     for (int i = 0; i < nlocal; i++)
       if (mask[i] & groupbit) {
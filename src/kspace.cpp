@@ -23,6 +23,7 @@
 #include "memory.h"
 #include "pair.h"
 #include "suffix.h"
+#include "update.h"
 
 #include <cmath>
 #include <cstring>
@@ -40,6 +41,7 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   virial[0] = virial[1] = virial[2] = virial[3] = virial[4] = virial[5] = 0.0;
 
   triclinic_support = 1;
+  every_allow = 1;
   ewaldflag = pppmflag = msmflag = dispersionflag = tip4pflag =
     dipoleflag = spinflag = 0;
   compute_flag = 1;
@@ -60,6 +62,12 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
 #else
   collective_flag = 0;
 #endif
+  fft_batch_flag = 0;
+  fft_nranks = 0;
+  nevery = 1;
+  f_every = nullptr;
+  t_every = nullptr;
+  maxfevery = 0;
 
   kewaldflag = 0;
 
@@ -156,6 +164,8 @@ KSpace::~KSpace()
 
   memory->destroy(eatom);
   memory->destroy(vatom);
+  memory->destroy(f_every);
+  memory->destroy(t_every);
   memory->destroy(gcons);
   memory->destroy(dgcons);
 }
@@ -186,6 +196,66 @@ void KSpace::compute_dummy(int eflag, int vflag)
   ev_init(eflag,vflag);
 }
 
+/* ----------------------------------------------------------------------
+   compute forces for multiple time stepping with nevery > 1
+   on steps that are a multiple of nevery, forces are applied as an
+     impulse, i.e. scaled by nevery, on other steps they are not applied
+   forces are still computed on other steps during setup or if per-atom
+     energy/virial is requested, so that those values are current
+   otherwise global energy/virial are those of the last multiple of nevery,
+     so they are always computed on those steps
+------------------------------------------------------------------------- */
+
+void KSpace::compute_every(int eflag, int vflag, int setupflag)
+{
+  double weight = nevery;
+  if (update->ntimestep % nevery) {
+    if (!setupflag && !(eflag & ENERGY_ATOM) && !(vflag & (VIRIAL_ATOM | VIRIAL_CENTROID)))
+      return;
+    weight = 0.0;
+  } else {
+    eflag |= ENERGY_GLOBAL;
+    vflag |= VIRIAL_PAIR;
+  }
+
+  // store forces and torques of other contributions, then scale the kspace ones
+  // include ghost atoms, since some styles add forces to ghost atoms
+  // styles that set other per-atom quantities have every_allow = 0
+
+  int nall = atom->nlocal + atom->nghost;
+  int torqueflag = atom->torque_flag;
+  if (atom->nmax > maxfevery) {
+    memory->destroy(f_every);
+    memory->destroy(t_every);
+    maxfevery = atom->nmax;
+    memory->create(f_every,maxfevery,3,"kspace:f_every");
+    if (torqueflag) memory->create(t_every,maxfevery,3,"kspace:t_every");
+  } else if (torqueflag && !t_every)
+    memory->create(t_every,maxfevery,3,"kspace:t_every");
+
+  double **f = atom->f;
+  double **torque = atom->torque;
+  if (nall) {
+    memcpy(&f_every[0][0],&f[0][0],3*sizeof(double)*nall);
+    if (torqueflag) memcpy(&t_every[0][0],&torque[0][0],3*sizeof(double)*nall);
+  }
+
+  compute(eflag,vflag);
+
+  for (int i = 0; i < nall; i++) {
+    f[i][0] = f_every[i][0] + weight*(f[i][0] - f_every[i][0]);
+    f[i][1] = f_every[i][1] + weight*(f[i][1] - f_every[i][1]);
+    f[i][2] = f_every[i][2] + weight*(f[i][2] - f_every[i][2]);
+  }
+  if (torqueflag) {
+    for (int i = 0; i < nall; i++) {
+      torque[i][0] = t_every[i][0] + weight*(torque[i][0] - t_every[i][0]);
+      torque[i][1] = t_every[i][1] + weight*(torque[i][1] - t_every[i][1]);
+      torque[i][2] = t_every[i][2] + weight*(torque[i][2] - t_every[i][2]);
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    check that pair style is compatible with long-range solver
 ------------------------------------------------------------------------- */
@@ -549,6 +619,22 @@ void KSpace::modify_params(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       collective_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"fft/batch") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      fft_batch_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"every") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      nevery = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (nevery < 1) error->all(FLERR,"Illegal kspace_modify every value");
+      if ((nevery > 1) && !every_allow)
+        error->all(FLERR,"KSpace style does not support kspace_modify every > 1");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"fft/ranks") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      fft_nranks = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (fft_nranks < 0) error->all(FLERR,"Illegal kspace_modify fft/ranks value");
+      iarg += 2;
     } else if (strcmp(arg[iarg],"diff") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       if (strcmp(arg[iarg+1],"ad") == 0) differentiation_flag = 1;
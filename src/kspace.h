@@ -30,6 +30,7 @@ class KSpace : protected Pointers {
   double e2group;            // accumulated group-group energy
   double f2group[3];         // accumulated group-group force
   int triclinic_support;     // 1 if supports triclinic geometries
+  int every_allow;           // 1 if supports kspace_modify every > 1
 
   int ewaldflag;         // 1 if a Ewald solver
   int pppmflag;          // 1 if a PPPM solver
@@ -88,6 +89,9 @@ class KSpace : protected Pointers {
   int compute_flag;       // 0 if skip compute()
   int fftbench;           // 0 if skip FFT timing
   int collective_flag;    // 1 if use MPI collectives for FFT/remap
+  int fft_batch_flag;     // 1 if pipeline FFTs of several fields
+  int fft_nranks;         // # of procs doing the FFTs, 0 = all procs
+  int nevery;             // compute forces every this many steps
   int stagger_flag;       // 1 if using staggered PPPM grids
 
   double splittol;    // tolerance for when to truncate splitting
@@ -99,6 +103,7 @@ class KSpace : protected Pointers {
   void modify_params(int, char **);
   void *extract(const char *);
   void compute_dummy(int, int);
+  void compute_every(int, int, int);
 
   // triclinic
 
@@ -117,6 +122,7 @@ class KSpace : protected Pointers {
   virtual void setup() = 0;
   virtual void reset_grid(){};
   virtual void compute(int, int) = 0;
+  virtual void compute_begin(int, int){};
   virtual void compute_group_group(int, int, int){};
 
   virtual void pack_forward_grid(int, void *, int, int *){};
@@ -176,6 +182,10 @@ class KSpace : protected Pointers {
   double **get_gcons() { return gcons; }
   double **get_dgcons() { return dgcons; }
 
+  // 1 if g_ewald and grid are derived from the accuracy, not set by kspace_modify
+
+  int auto_params() const { return !(gewaldflag || gridflag); }
+
  protected:
   int gridflag, gridflag_6;
   int gewaldflag, gewaldflag_6;
@@ -192,6 +202,10 @@ class KSpace : protected Pointers {
   int vflag_either, vflag_global, vflag_atom;
   int maxeatom, maxvatom;
 
+  double **f_every;    // forces before kspace compute with nevery > 1
+  double **t_every;    // torques before kspace compute with nevery > 1
+  int maxfevery;
+
   int kewaldflag;                      // 1 if kspace range set for Ewald sum
   int kx_ewald, ky_ewald, kz_ewald;    // kspace settings for Ewald sum
 
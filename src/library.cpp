@@ -31,6 +31,7 @@
 #include "exceptions.h"
 #include "fix.h"
 #include "fix_external.h"
+#include "fix_insitu.h"
 #include "force.h"
 #include "group.h"
 #include "info.h"
@@ -6670,6 +6671,58 @@ void lammps_fix_external_set_vector(void *handle, const char *id, int idx, doubl
 
 /* ---------------------------------------------------------------------- */
 
+/** Set up the callback function for a fix insitu instance with the given ID.
+
+\verbatim embed:rst
+
+Fix :doc:`insitu <fix_insitu>` passes read-only views of per-atom data
+to a function in the calling program on every MPI rank, without
+gathering or copying the data.  The function has to have C language
+bindings with the prototype:
+
+.. code-block:: c
+
+   void func(void *ptr, const lammps_insitu_frame *frame);
+
+The *frame* argument describes the owned atoms and the subdomain of the
+calling rank and holds one :cpp:struct:`lammps_insitu_view` per field
+requested in the fix command.  Value *k* of local atom *i* of a view
+is at offset ``i*stride + k`` from its *data* pointer.  The pointers
+refer to the current storage of LAMMPS and are only valid until the
+callback function returns; the data must not be modified.
+
+The argument *ptr* to this function will be stored in fix insitu and
+passed as the first argument of the callback function.  This function
+must be called on **all** MPI ranks, since the callback is invoked on
+every rank.  Setting a null pointer as *funcptr* disables the callback.
+
+\endverbatim
+ *
+ * \param  handle   pointer to a previously created LAMMPS instance cast to ``void *``.
+ * \param  id       fix ID of fix insitu instance
+ * \param  funcptr  pointer to callback function
+ * \param  ptr      pointer to object in calling code, passed to callback function as first argument */
+
+void lammps_set_fix_insitu_callback(void *handle, const char *id, FixInsituFnPtr funcptr, void *ptr)
+{
+  auto lmp = (LAMMPS *) handle;
+
+  BEGIN_CAPTURE
+  {
+    auto fix = lmp->modify->get_fix_by_id(id);
+    if (!fix) lmp->error->all(FLERR,"Cannot find fix with ID '{}'!", id);
+
+    if (strcmp("insitu",fix->style) != 0)
+      lmp->error->all(FLERR,"Fix '{}' is not of style 'insitu'", id);
+
+    auto finsitu = dynamic_cast<FixInsitu *>(fix);
+    finsitu->set_callback(funcptr, ptr);
+  }
+  END_CAPTURE
+}
+
+/* ---------------------------------------------------------------------- */
+
 /** Flush output buffers
 
 \verbatim embed:rst
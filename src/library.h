@@ -291,6 +291,36 @@ void lammps_fix_external_set_virial_peratom(void *handle, const char *id, double
 void lammps_fix_external_set_vector_length(void *handle, const char *id, int len);
 void lammps_fix_external_set_vector(void *handle, const char *id, int idx, double val);
 
+/** Read-only view of one per-atom quantity passed to fix insitu callbacks.
+ *
+ * Element *k* of local atom *i* is at ``data[i*stride + k]`` (cast to the
+ * type selected by *datatype*) with 0 <= i < nlocal and 0 <= k < ncol. */
+
+typedef struct lammps_insitu_view {
+  const char *name; /*!< field name as given to fix insitu */
+  const void *data; /*!< address of first value of first local atom */
+  int datatype;     /*!< LAMMPS_INT, LAMMPS_INT64, or LAMMPS_DOUBLE */
+  int ncol;         /*!< # of values per atom */
+  int stride;       /*!< distance between consecutive atoms in elements */
+} lammps_insitu_view;
+
+/** Per-rank data passed to fix insitu callbacks */
+
+typedef struct lammps_insitu_frame {
+  int64_t timestep;                /*!< current timestep */
+  int nlocal;                      /*!< # of owned atoms on this rank */
+  int groupbit;                    /*!< bitmask of fix group, test against "mask" field */
+  double sublo[3];                 /*!< lower bounds of subdomain of this rank */
+  double subhi[3];                 /*!< upper bounds of subdomain of this rank */
+  int nview;                       /*!< # of views */
+  const lammps_insitu_view *views; /*!< one view per requested field */
+} lammps_insitu_frame;
+
+typedef void (*FixInsituFnPtr)(void *, const lammps_insitu_frame *);
+
+void lammps_set_fix_insitu_callback(void *handle, const char *id, FixInsituFnPtr funcptr,
+                                    void *ptr);
+
 void lammps_flush_buffers(void *ptr);
 
 void lammps_free(void *ptr);
@@ -24,7 +24,9 @@
 #include "group.h"
 #include "input.h"
 #include "memory.h"
+#include "profiler.h"
 #include "region.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -395,8 +397,10 @@ void Modify::setup_pre_reverse(int eflag, int vflag)
 
 void Modify::initial_integrate(int vflag)
 {
-  for (int i = 0; i < n_initial_integrate; i++)
+  for (int i = 0; i < n_initial_integrate; i++) {
+    ProfileScope prof(timer->profiler, fix[list_initial_integrate[i]]);
     fix[list_initial_integrate[i]]->initial_integrate(vflag);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -405,7 +409,10 @@ void Modify::initial_integrate(int vflag)
 
 void Modify::post_integrate()
 {
-  for (int i = 0; i < n_post_integrate; i++) fix[list_post_integrate[i]]->post_integrate();
+  for (int i = 0; i < n_post_integrate; i++) {
+    ProfileScope prof(timer->profiler, fix[list_post_integrate[i]]);
+    fix[list_post_integrate[i]]->post_integrate();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -414,7 +421,10 @@ void Modify::post_integrate()
 
 void Modify::pre_exchange()
 {
-  for (int i = 0; i < n_pre_exchange; i++) fix[list_pre_exchange[i]]->pre_exchange();
+  for (int i = 0; i < n_pre_exchange; i++) {
+    ProfileScope prof(timer->profiler, fix[list_pre_exchange[i]]);
+    fix[list_pre_exchange[i]]->pre_exchange();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -423,7 +433,10 @@ void Modify::pre_exchange()
 
 void Modify::pre_neighbor()
 {
-  for (int i = 0; i < n_pre_neighbor; i++) fix[list_pre_neighbor[i]]->pre_neighbor();
+  for (int i = 0; i < n_pre_neighbor; i++) {
+    ProfileScope prof(timer->profiler, fix[list_pre_neighbor[i]]);
+    fix[list_pre_neighbor[i]]->pre_neighbor();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -432,7 +445,10 @@ void Modify::pre_neighbor()
 
 void Modify::post_neighbor()
 {
-  for (int i = 0; i < n_post_neighbor; i++) fix[list_post_neighbor[i]]->post_neighbor();
+  for (int i = 0; i < n_post_neighbor; i++) {
+    ProfileScope prof(timer->profiler, fix[list_post_neighbor[i]]);
+    fix[list_post_neighbor[i]]->post_neighbor();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -441,7 +457,10 @@ void Modify::post_neighbor()
 
 void Modify::pre_force(int vflag)
 {
-  for (int i = 0; i < n_pre_force; i++) fix[list_pre_force[i]]->pre_force(vflag);
+  for (int i = 0; i < n_pre_force; i++) {
+    ProfileScope prof(timer->profiler, fix[list_pre_force[i]]);
+    fix[list_pre_force[i]]->pre_force(vflag);
+  }
 }
 /* ----------------------------------------------------------------------
    pre_reverse call, only for relevant fixes
@@ -449,7 +468,10 @@ void Modify::pre_force(int vflag)
 
 void Modify::pre_reverse(int eflag, int vflag)
 {
-  for (int i = 0; i < n_pre_reverse; i++) fix[list_pre_reverse[i]]->pre_reverse(eflag, vflag);
+  for (int i = 0; i < n_pre_reverse; i++) {
+    ProfileScope prof(timer->profiler, fix[list_pre_reverse[i]]);
+    fix[list_pre_reverse[i]]->pre_reverse(eflag, vflag);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -461,11 +483,17 @@ void Modify::pre_reverse(int eflag, int vflag)
 void Modify::post_force(int vflag)
 {
   if (n_post_force_group) {
-    for (int i = 0; i < n_post_force_group; i++) fix[list_post_force_group[i]]->post_force(vflag);
+    for (int i = 0; i < n_post_force_group; i++) {
+      ProfileScope prof(timer->profiler, fix[list_post_force_group[i]]);
+      fix[list_post_force_group[i]]->post_force(vflag);
+    }
   }
 
   if (n_post_force) {
-    for (int i = 0; i < n_post_force; i++) fix[list_post_force[i]]->post_force(vflag);
+    for (int i = 0; i < n_post_force; i++) {
+      ProfileScope prof(timer->profiler, fix[list_post_force[i]]);
+      fix[list_post_force[i]]->post_force(vflag);
+    }
   }
 }
 
@@ -475,7 +503,10 @@ void Modify::post_force(int vflag)
 
 void Modify::final_integrate()
 {
-  for (int i = 0; i < n_final_integrate; i++) fix[list_final_integrate[i]]->final_integrate();
+  for (int i = 0; i < n_final_integrate; i++) {
+    ProfileScope prof(timer->profiler, fix[list_final_integrate[i]]);
+    fix[list_final_integrate[i]]->final_integrate();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -486,7 +517,10 @@ void Modify::final_integrate()
 void Modify::end_of_step()
 {
   for (int i = 0; i < n_end_of_step; i++)
-    if (update->ntimestep % end_of_step_every[i] == 0) fix[list_end_of_step[i]]->end_of_step();
+    if (update->ntimestep % end_of_step_every[i] == 0) {
+      ProfileScope prof(timer->profiler, fix[list_end_of_step[i]]);
+      fix[list_end_of_step[i]]->end_of_step();
+    }
 }
 
 /* ----------------------------------------------------------------------
@@ -89,16 +89,20 @@ void NBinStandard::setup_bins(int style)
   //   include dimension-dependent extension via comm->cutghost
   //   domain->bbox() converts lamda extent to box coords and computes bbox
 
+  // with partial rebuilds, ghost atoms are re-binned between full builds
+  //   and may have drifted outward by up to neighbor->partial_drift
+
   double bbox[3],bsubboxlo[3],bsubboxhi[3];
   double *cutghost = comm->cutghost;
 
   if (triclinic == 0) {
-    bsubboxlo[0] = domain->sublo[0] - cutghost[0];
-    bsubboxlo[1] = domain->sublo[1] - cutghost[1];
-    bsubboxlo[2] = domain->sublo[2] - cutghost[2];
-    bsubboxhi[0] = domain->subhi[0] + cutghost[0];
-    bsubboxhi[1] = domain->subhi[1] + cutghost[1];
-    bsubboxhi[2] = domain->subhi[2] + cutghost[2];
+    const double drift = neighbor->partial_drift;
+    bsubboxlo[0] = domain->sublo[0] - cutghost[0] - drift;
+    bsubboxlo[1] = domain->sublo[1] - cutghost[1] - drift;
+    bsubboxlo[2] = domain->sublo[2] - cutghost[2] - drift;
+    bsubboxhi[0] = domain->subhi[0] + cutghost[0] + drift;
+    bsubboxhi[1] = domain->subhi[1] + cutghost[1] + drift;
+    bsubboxhi[2] = domain->subhi[2] + cutghost[2] + drift;
   } else {
     double lo[3],hi[3];
     lo[0] = domain->sublo_lamda[0] - cutghost[0];
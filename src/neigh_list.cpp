@@ -32,6 +32,7 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   // initializations
 
   maxatom = 0;
+  stamp = -1;
 
   inum = gnum = 0;
   ilist = nullptr;
@@ -49,6 +50,7 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   respainner = 0;
   copy = 0;
   trim = 0;
+  cluster = 0;
   copymode = 0;
 
   // ptrs
@@ -64,6 +66,15 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
 
   ipage = nullptr;
 
+  // cluster-pair lists
+
+  nicluster = ncluster = 0;
+  clusteratom = nullptr;
+  cfirst = nullptr;
+  cjlist = nullptr;
+  cjmask = nullptr;
+  maxcluster = maxicluster = maxcpair = 0;
+
   // extra rRESPA lists
 
   inum_inner = gnum_inner = 0;
@@ -120,6 +131,13 @@ NeighList::~NeighList()
     delete [] ipage_middle;
   }
 
+  if (cluster) {
+    memory->destroy(clusteratom);
+    memory->destroy(cfirst);
+    memory->destroy(cjlist);
+    memory->destroy(cjmask);
+  }
+
   delete [] iskip;
   memory->destroy(ijskip);
 }
@@ -147,6 +165,7 @@ void NeighList::post_constructor(NeighRequest *nq)
   respainner = nq->respainner;
   copy = nq->copy;
   trim = nq->trim;
+  cluster = nq->cluster;
   id = nq->id;
 
   if (nq->copy) {
@@ -290,6 +309,7 @@ void NeighList::print_attributes()
   printf("  %d = off2on\n",rq->off2on);
   printf("  %d = copy flag\n",rq->copy);
   printf("  %d = trim flag\n",rq->trim);
+  printf("  %d = cluster flag\n",rq->cluster);
   printf("  %d = kk2cpu flag\n",kk2cpu);
   printf("  %d = half/full\n",rq->halffull);
   printf("\n");
@@ -335,5 +355,12 @@ double NeighList::memory_usage()
     }
   }
 
+  if (cluster) {
+    bytes += memory->usage(clusteratom,CLUSTERSIZE*maxcluster);
+    bytes += memory->usage(cfirst,maxicluster);
+    bytes += memory->usage(cjlist,maxcpair);
+    bytes += memory->usage(cjmask,maxcpair);
+  }
+
   return bytes;
 }
@@ -43,6 +43,7 @@ class NeighList : protected Pointers {
   int respainner;     // 1 if there is also a rRespa inner list
   int copy;           // 1 if this list is copied from another list
   int trim;           // 1 if this list is trimmed from another list
+  int cluster;        // 1 if list stores pairs of atom clusters
   int kk2cpu;         // 1 if this list is copied from Kokkos to CPU
   int copymode;       // 1 if this is a Kokkos on-device copy
   int id;             // copied from neighbor list request
@@ -55,11 +56,28 @@ class NeighList : protected Pointers {
   int *numneigh;       // # of J neighbors for each I atom
   int **firstneigh;    // ptr to 1st J int value of each I atom
   int maxatom;         // size of allocated per-atom arrays
+  bigint stamp;        // neighbor->nstamp of last full or partial build
 
   int pgsize;            // size of each page
   int oneatom;           // max size for one atom
   MyPage<int> *ipage;    // pages of neighbor indices
 
+  // data structs to store pairs of atom clusters, only for cluster lists
+  // clusters of owned atoms are listed first, followed by clusters of ghosts
+  // empty slots of a cluster have atom index -1
+
+  static constexpr int CLUSTERSIZE = 4;
+
+  int nicluster;             // # of clusters of owned atoms
+  int ncluster;              // # of clusters of owned and ghost atoms
+  int *clusteratom;          // CLUSTERSIZE atom indices of each cluster
+  int *cfirst;               // 1st index into cjlist of each owned cluster
+  int *cjlist;               // J clusters of all cluster pairs
+  unsigned int *cjmask;      // bit a*CLUSTERSIZE+b set if slots a,b interact
+  int maxcluster;            // size of allocated clusteratom
+  int maxicluster;           // size of allocated cfirst
+  int maxcpair;              // size of allocated cjlist, cjmask
+
   // data structs to store rRESPA neighbor pairs I,J and associated values
 
   int inum_inner;            // # of I atoms neighbors are stored for
@@ -42,12 +42,14 @@
 #include "output.h"
 #include "pair.h"
 #include "pair_hybrid.h"
+#include "profiler.h"
 #include "respa.h"
 #include "style_nbin.h"  // IWYU pragma: keep
 #include "style_npair.h"  // IWYU pragma: keep
 #include "style_nstencil.h"  // IWYU pragma: keep
 #include "style_ntopo.h"  // IWYU pragma: keep
 #include "suffix.h"
+#include "timer.h"
 #include "tokenizer.h"
 #include "update.h"
 
@@ -63,6 +65,17 @@ static constexpr int DELTA_PERATOM = 64;
 
 static constexpr double BIG = 1.0e20;
 
+// total # of neighbors stored in a list, for profiling
+
+static bigint count_pairs(NeighList *list)
+{
+  if (!list->ilist || !list->numneigh) return 0;
+  bigint npairs = 0;
+  int n = list->inum + list->gnum;
+  for (int ii = 0; ii < n; ii++) npairs += list->numneigh[list->ilist[ii]];
+  return npairs;
+}
+
 enum{NONE,ALL,PARTIAL,TEMPLATE};
 
 static const char cite_neigh_multi_old[] =
@@ -136,6 +149,7 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   binsizeflag = 0;
   build_once = 0;
   cluster_check = 0;
+  partial_flag = 0;
   ago = -1;
 
   cutneighmax = 0.0;
@@ -172,6 +186,7 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
 
   old_style = style;
   old_triclinic = 0;
+  old_partial = 0;
   old_pgsize = pgsize;
   old_oneatom = oneatom;
 
@@ -198,6 +213,17 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   lastcall = -1;
   last_setup_bins = -1;
 
+  // coords for partial rebuilds
+
+  partial_active = 0;
+  partial_drift = 0.0;
+  cutghostpartial = 0.0;
+  npartial = 0;
+  nstamp = 0;
+  maxpartial = maxhot = 0;
+  xpartial = nullptr;
+  hotlist = nullptr;
+
   // pair exclusion list info
 
   includegroup = 0;
@@ -279,6 +305,8 @@ Neighbor::~Neighbor()
   delete neigh_improper;
 
   memory->destroy(xhold);
+  memory->destroy(xpartial);
+  memory->destroy(hotlist);
 
   memory->destroy(ex1_type);
   memory->destroy(ex2_type);
@@ -306,7 +334,7 @@ void Neighbor::init()
   int i,j,n;
 
   overlap_topo = 0;
-  ncalls = ndanger = 0;
+  ncalls = ndanger = npartial = 0;
   dimension = domain->dimension;
   triclinic = domain->triclinic;
   newton_pair = force->newton_pair;
@@ -384,6 +412,42 @@ void Neighbor::init()
   }
   cutneighmaxsq = cutneighmax * cutneighmax;
 
+  // partial rebuilds of list rows between full rebuilds
+  // only done by plain Verlet, which calls build_partial() every step
+  // rows are rebuilt when an owned or ghost atom moves 1/4 of the skin,
+  //   so that pairs in rows built at different times stay within the skin
+  // full rebuild trigger is widened to 1/2 of the extra ghost cutoff,
+  //   since it now only guards the ghost atoms
+  // the ghost cutoff is widened by another skin, unless a larger one
+  //   is set via comm_modify cutoff, see Comm::get_comm_cutoff()
+  // not with KSpace, since its grids assume atoms stay within skin/2,
+  //   and not for triclinic boxes, where ghost cutoffs are in lamda units
+
+  partial_active = 0;
+  partial_drift = 0.0;
+  cutghostpartial = 0.0;
+  if (partial_flag) {
+    if (style != Neighbor::BIN)
+      error->all(FLERR, "Neigh_modify partial requires neighbor style bin");
+    if (includegroup)
+      error->all(FLERR, "Neigh_modify partial cannot be used with neigh_modify include");
+    if (boxcheck) {
+      if (me == 0)
+        error->warning(FLERR, "Neigh_modify partial is ignored for a changing periodic box");
+    } else if (force->pair && dist_check && !build_once && (update->whichflag == 1) &&
+               update->integrate_style && (strcmp(update->integrate_style, "verlet") == 0)) {
+      partial_active = 1;
+      triggerpartialsq = 0.0625 * skin * skin;
+      if (!force->kspace && !triclinic) {
+        double ghostskin = MAX(comm->cutghostuser, cutneighmax) - (cutneighmax - skin);
+        ghostskin = MAX(ghostskin, 2.0 * skin);
+        cutghostpartial = cutneighmax - skin + ghostskin;
+        triggersq = 0.25 * ghostskin * ghostskin;
+        partial_drift = 0.5 * ghostskin;
+      }
+    }
+  }
+
   // Define cutoffs for multi
   if (style == Neighbor::MULTI) {
     int icollection, jcollection;
@@ -667,6 +731,17 @@ void Neighbor::init()
 
   int same = init_pair();
 
+  // all perpetual lists must support rebuilding individual rows
+
+  if (partial_active) {
+    for (i = 0; i < npair_perpetual; i++) {
+      int m = plist[i];
+      if (!neigh_pair[m]->partial_enable || lists[m]->history)
+        error->all(FLERR, "Neighbor list {} does not support neigh_modify partial",
+                   pairnames[lists[m]->pair_method - 1]);
+    }
+  }
+
   // invoke copy_neighbor_info() in Bin,Stencil,Pair classes
   // copied once per run in case any cutoff, exclusion, special info changed
 
@@ -799,6 +874,7 @@ int Neighbor::init_pair()
   int same = 1;
   if (style != old_style) same = 0;
   if (triclinic != old_triclinic) same = 0;
+  if (partial_active != old_partial) same = 0;
   if (pgsize != old_pgsize) same = 0;
   if (oneatom != old_oneatom) same = 0;
 
@@ -1281,6 +1357,7 @@ void Neighbor::morph_skip()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // 2 lists are a match
 
@@ -1444,6 +1521,7 @@ void Neighbor::morph_halffull()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // skip flag must be same
       // if both are skip lists, skip info must match
@@ -1482,8 +1560,9 @@ void Neighbor::morph_copy_trim()
     int trim_flag = irq->trim;
 
     // this list is already a copy list due to another morph method
+    // cluster-pair lists are always built directly
 
-    if (irq->copy) continue;
+    if (irq->copy || irq->cluster) continue;
 
     // check all other lists
 
@@ -1553,6 +1632,7 @@ void Neighbor::morph_copy_trim()
       if (irq->kokkos_host && !jrq->kokkos_host) continue;
       if (irq->kokkos_device && !jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // skip flag must be same
       // if both are skip lists, skip info must match
@@ -1733,7 +1813,7 @@ void Neighbor::print_pairwise_info()
   int i;
   NeighRequest *rq;
 
-  const double cutghost = MAX(cutneighmax,comm->cutghostuser);
+  const double cutghost = MAX(MAX(cutneighmax,comm->cutghostuser),cutghostpartial);
 
   double binsize, bbox[3];
   bbox[0] =  bboxhi[0]-bboxlo[0];
@@ -1831,6 +1911,7 @@ void Neighbor::print_pairwise_info()
     if (rq->kokkos_device) out += ", kokkos_device";
     if (rq->kokkos_host) out += ", kokkos_host";
     if (rq->ssa) out += ", ssa";
+    if (rq->cluster) out += ", cluster";
     if (rq->cut) out += fmt::format(", cut {}",rq->cutoff);
     if (rq->off2on) out += ", off2on";
     out += "\n";
@@ -1869,10 +1950,32 @@ void Neighbor::requests_new2old()
 
   old_style = style;
   old_triclinic = triclinic;
+  old_partial = partial_active;
   old_pgsize = pgsize;
   old_oneatom = oneatom;
 }
 
+/* ----------------------------------------------------------------------
+   replace pending requests with copies of the requests of the current lists
+   a following init() then finds them unchanged and keeps all lists, but
+     updates their cutoffs from the pair style, e.g. during a run
+------------------------------------------------------------------------- */
+
+void Neighbor::reissue_requests()
+{
+  for (int i = 0; i < nrequest; i++) delete requests[i];
+  nrequest = 0;
+
+  for (int i = 0; i < old_nrequest; i++) {
+    if (nrequest == maxrequest) {
+      maxrequest += RQDELTA;
+      requests = (NeighRequest **)
+        memory->srealloc(requests,maxrequest*sizeof(NeighRequest *), "neighbor:requests");
+    }
+    requests[nrequest++] = new NeighRequest(old_requests[i]);
+  }
+}
+
 /* ----------------------------------------------------------------------
    find and return request made by classptr
    if not found or classptr = nullptr, return nullptr
@@ -1933,6 +2036,10 @@ int Neighbor::choose_bin(NeighRequest *rq)
   if (style == Neighbor::NSQ) return 0;
   if (rq->skip || rq->copy || rq->halffull) return 0;
 
+  // cluster-pair lists sort atoms into their own columns
+
+  if (rq->cluster) return 0;
+
   // use request settings to match exactly one NBin class mask
   // checks are bitwise using NeighConst bit masks
 
@@ -1979,6 +2086,7 @@ int Neighbor::choose_stencil(NeighRequest *rq)
 
   if (style == Neighbor::NSQ) return 0;
   if (rq->skip || rq->copy || rq->halffull) return 0;
+  if (rq->cluster) return 0;
 
   // convert newton request to newtflag = on or off
 
@@ -2042,8 +2150,9 @@ int Neighbor::choose_stencil(NeighRequest *rq)
     }
 
     // domain triclinic flag is on or off and must match
+    // partial rebuilds need the triclinic full stencil for orthogonal boxes
 
-    if (triclinic) {
+    if (triclinic || partial_active) {
       if (!(mask & NS_TRI)) continue;
     } else if (!triclinic) {
       if (!(mask & NS_ORTHO)) continue;
@@ -2161,6 +2270,7 @@ int Neighbor::choose_pair(NeighRequest *rq)
     if (!rq->kokkos_device != !(mask & NP_KOKKOS_DEVICE)) continue;
     if (!rq->kokkos_host != !(mask & NP_KOKKOS_HOST)) continue;
     if (!rq->ssa != !(mask & NP_SSA)) continue;
+    if (!rq->cluster != !(mask & NP_CLUSTER)) continue;
 
     if (!rq->skip != !(mask & NP_SKIP)) continue;
 
@@ -2182,8 +2292,11 @@ int Neighbor::choose_pair(NeighRequest *rq)
     }
 
     // domain triclinic flag is on or off and must match
+    // partial rebuilds need the triclinic half lists for orthogonal boxes,
+    //   since they decide which atom of a pair stores it via indices and IDs,
+    //   which does not change between full rebuilds, unlike coordinates
 
-    if (triclinic) {
+    if (triclinic || partial_active) {
       if (!(mask & NP_TRI)) continue;
     } else if (!triclinic) {
       if (!(mask & NP_ORTHO)) continue;
@@ -2473,8 +2586,29 @@ void Neighbor::build(int topoflag)
     m = plist[i];
     if (!lists[m]->copy || lists[m]->trim || lists[m]->kk2cpu)
       lists[m]->grow(nlocal,nall);
+    ProfileScope prof(timer->profiler, Profiler::NPAIR, neigh_pair[m],
+                      pairnames[lists[m]->pair_method-1], m+1);
     neigh_pair[m]->build_setup();
     neigh_pair[m]->build(lists[m]);
+    lists[m]->stamp = ++nstamp;
+    prof.stop();
+    if (prof.active()) prof.items(count_pairs(lists[m]));
+  }
+
+  // store current owned and ghost atom positions for partial rebuilds
+
+  if (partial_active) {
+    double **x = atom->x;
+    if (atom->nmax > maxpartial) {
+      maxpartial = atom->nmax;
+      memory->destroy(xpartial);
+      memory->create(xpartial,maxpartial,3,"neigh:xpartial");
+    }
+    for (i = 0; i < nall; i++) {
+      xpartial[i][0] = x[i][0];
+      xpartial[i][1] = x[i][1];
+      xpartial[i][2] = x[i][2];
+    }
   }
 
   // build topology lists for bonds/angles/etc
@@ -2483,6 +2617,77 @@ void Neighbor::build(int topoflag)
   if ((atom->molecular != Atom::ATOMIC) && topoflag && !overlap_topo) build_topology();
 }
 
+/* ----------------------------------------------------------------------
+   rebuild rows of perpetual lists near atoms that moved more than 1/4 skin
+   called every step by Verlet after forward comm when no full build occurred
+   purely local, atom indices and ghosts are unchanged since last full build
+   each NPair rebins atoms and rebuilds rows of owned atoms within
+     neighbor cutoff + skin of a moved atom, new rows are appended to pages
+------------------------------------------------------------------------- */
+
+void Neighbor::build_partial()
+{
+  if (!partial_active) return;
+
+  int i,m;
+  double delx,dely,delz;
+
+  double **x = atom->x;
+  int nall = atom->nlocal + atom->nghost;
+
+  if (nall > maxhot) {
+    maxhot = atom->nmax;
+    memory->destroy(hotlist);
+    memory->create(hotlist,maxhot,"neigh:hotlist");
+  }
+
+  int nhot = 0;
+  for (i = 0; i < nall; i++) {
+    delx = x[i][0] - xpartial[i][0];
+    dely = x[i][1] - xpartial[i][1];
+    delz = x[i][2] - xpartial[i][2];
+    if (delx*delx + dely*dely + delz*delz > triggerpartialsq) hotlist[nhot++] = i;
+  }
+  if (nhot == 0) return;
+
+  npartial++;
+
+  for (i = 0; i < nbin; i++) neigh_bin[i]->bin_atoms();
+
+  // if many atoms moved, rebuilding all rows is cheaper than flagging bins
+  //   and also releases the page space of rows replaced since last build
+
+  int allrows = (nhot > nall/8);
+
+  for (i = 0; i < npair_perpetual; i++) {
+    m = plist[i];
+    ProfileScope prof(timer->profiler, Profiler::NPAIR, neigh_pair[m],
+                      pairnames[lists[m]->pair_method-1], m+1);
+    neigh_pair[m]->build_setup();
+    if (allrows) neigh_pair[m]->build(lists[m]);
+    else neigh_pair[m]->build_partial(lists[m],hotlist,nhot);
+    lists[m]->stamp = ++nstamp;
+    prof.stop();
+    if (prof.active()) prof.items(count_pairs(lists[m]));
+  }
+
+  if (allrows) {
+    for (i = 0; i < nall; i++) {
+      xpartial[i][0] = x[i][0];
+      xpartial[i][1] = x[i][1];
+      xpartial[i][2] = x[i][2];
+    }
+    return;
+  }
+
+  for (i = 0; i < nhot; i++) {
+    m = hotlist[i];
+    xpartial[m][0] = x[m][0];
+    xpartial[m][1] = x[m][1];
+    xpartial[m][2] = x[m][2];
+  }
+}
+
 /* ----------------------------------------------------------------------
    build topology neighbor lists: bond, angle, dihedral, improper
    copy their list info back to Neighbor for access by bond/angle/etc classes
@@ -2565,8 +2770,13 @@ void Neighbor::build_one(class NeighList *mylist, int preflag)
 
   if (!mylist->copy || mylist->trim || mylist->kk2cpu)
     mylist->grow(atom->nlocal,atom->nlocal+atom->nghost);
+  ProfileScope prof(timer->profiler, Profiler::NPAIR, np,
+                    pairnames[mylist->pair_method-1], mylist->index+1);
   np->build_setup();
   np->build(mylist);
+  mylist->stamp = ++nstamp;
+  prof.stop();
+  if (prof.active()) prof.items(count_pairs(mylist));
 }
 
 /* ----------------------------------------------------------------------
@@ -2659,6 +2869,10 @@ void Neighbor::modify_params(int narg, char **arg)
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify cluster", error);
       cluster_check = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"partial") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify partial", error);
+      partial_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"include") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify include", error);
       includegroup = group->find(arg[iarg+1]);
@@ -3002,6 +3216,8 @@ double Neighbor::memory_usage()
 {
   double bytes = 0;
   bytes += memory->usage(xhold,maxhold,3);
+  bytes += memory->usage(xpartial,maxpartial,3);
+  bytes += memory->usage(hotlist,maxhot);
 
   for (int i = 0; i < nlist; i++)
     if (lists[i]) bytes += lists[i]->memory_usage();
@@ -34,6 +34,7 @@ class Neighbor : protected Pointers {
   int oneatom;         // max # of neighbors for one atom
   int includegroup;    // only build pairwise lists for this group
   int build_once;      // 1 if only build lists once per run
+  int partial_flag;    // 1 if rows of lists may be rebuilt between full builds
 
   double skin;                    // skin distance
   double cutneighmin;             // min neighbor cutoff for all type pairs
@@ -53,6 +54,13 @@ class Neighbor : protected Pointers {
   bigint ncalls;      // # of times build has been called
   bigint ndanger;     // # of dangerous builds
   bigint lastcall;    // timestep of last neighbor::build() call
+  bigint npartial;    // # of partial rebuilds of perpetual lists
+  bigint nstamp;      // # of list builds since creation, never reset
+
+  double partial_drift;    // max drift of ghost atoms between full builds
+                           // beyond comm cutoff, 0.0 unless partial is active
+  double cutghostpartial;  // min comm cutoff for partial rebuilds
+                           // 0.0 unless partial is active
 
   // geometry and static info, used by other Neigh classes
 
@@ -134,6 +142,9 @@ class Neighbor : protected Pointers {
   NeighRequest *add_request(class Compute *, int flags = 0);
   NeighRequest *add_request(class Command *, const char *, int flags = 0);
 
+  // re-issue the requests of the current lists, e.g. for a cutoff change during a run
+  void reissue_requests();
+
   // set neighbor list request OpenMP flag
   void set_omp_neighbor(int);
 
@@ -144,6 +155,7 @@ class Neighbor : protected Pointers {
   virtual int check_distance();     // check max distance moved since last build
   void setup_bins();                // setup bins based on box and cutoff
   virtual void build(int);          // build all perpetual neighbor lists
+  void build_partial();             // rebuild list rows near atoms that moved
   virtual void build_topology();    // pairwise topology neighbor lists
   // create a one-time pairwise neigh list
   void build_one(class NeighList *list, int preflag = 0);
@@ -194,6 +206,13 @@ class Neighbor : protected Pointers {
   double **xhold;    // atom coords at last neighbor build
   int maxhold;       // size of xhold array
 
+  int partial_active;          // 1 if partial rebuilds are done during this run
+  double triggerpartialsq;    // partial rebuild when atom moves this dist
+  double **xpartial;          // owned+ghost coords at last rebuild of their rows
+  int maxpartial;             // size of xpartial array
+  int *hotlist;               // atoms that moved more than partial trigger
+  int maxhot;                 // size of hotlist
+
   int boxcheck;                           // 1 if need to store box size
   double boxlo_hold[3], boxhi_hold[3];    // box size at last neighbor build
   double corners_hold[8][3];              // box corners at last neighbor build
@@ -202,6 +221,7 @@ class Neighbor : protected Pointers {
   double inner[2], middle[2];    // rRESPA cutoffs for extra lists
 
   int old_style, old_triclinic;    // previous run info
+  int old_partial;
   int old_pgsize, old_oneatom;     // used to avoid re-creating neigh lists
 
   int nstencil_perpetual;    // # of perpetual NeighStencil classes
@@ -334,7 +354,8 @@ namespace NeighConst {
     NP_HALF_FULL = 1 << 23,
     NP_OFF2ON = 1 << 24,
     NP_MULTI_OLD = 1 << 25,
-    NP_TRIM = 1 << 26
+    NP_TRIM = 1 << 26,
+    NP_CLUSTER = 1 << 27
   };
 
   enum {
@@ -349,6 +370,7 @@ namespace NeighConst {
     REQ_NEWTON_ON = 1 << 8,
     REQ_NEWTON_OFF = 1 << 9,
     REQ_SSA = 1 << 10,
+    REQ_CLUSTER = 1 << 11,
   };
 }    // namespace NeighConst
 
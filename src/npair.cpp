@@ -31,6 +31,7 @@ NPair::NPair(LAMMPS *lmp)
   : Pointers(lmp), nb(nullptr), ns(nullptr), bins(nullptr), stencil(nullptr)
 {
   last_build = -1;
+  partial_enable = 0;
   mycutneighsq = nullptr;
   molecular = atom->molecular;
   copymode = 0;
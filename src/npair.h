@@ -26,6 +26,7 @@ class NPair : protected Pointers {
   bigint last_build;     // last timestep build performed
 
   double cutoff_custom;    // cutoff set by requestor
+  int partial_enable;      // 1 if build_partial() can rebuild individual rows
 
   NPair(class LAMMPS *);
   ~NPair() override;
@@ -33,6 +34,7 @@ class NPair : protected Pointers {
   virtual void copy_neighbor_info();
   void build_setup();
   virtual void build(class NeighList *) = 0;
+  virtual void build_partial(class NeighList *, int *, int) {}
 
  protected:
   double **mycutneighsq;    // per-type cutoffs when user specified
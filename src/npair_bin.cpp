@@ -18,6 +18,7 @@
 #include "domain.h"
 #include "error.h"
 #include "force.h"
+#include "memory.h"
 #include "molecule.h"
 #include "my_page.h"
 #include "neigh_list.h"
@@ -31,7 +32,22 @@ using namespace NeighConst;
 /* ---------------------------------------------------------------------- */
 
 template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
-NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::NPairBin(LAMMPS *lmp) : NPair(lmp) {}
+NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::NPairBin(LAMMPS *lmp) :
+  NPair(lmp), binflag(nullptr), maxbinflag(0)
+{
+  // orthogonal half lists with Newton on select the stored atom of a pair
+  //   by comparing coordinates, which can flip between two builds of a row
+
+  partial_enable = !(HALF && NEWTON && !TRI);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
+NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::~NPairBin()
+{
+  memory->destroy(binflag);
+}
 
 /* ----------------------------------------------------------------------
    Full:
@@ -50,6 +66,56 @@ NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::NPairBin(LAMMPS *lmp) : NPair(lmp)
 
 template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
 void NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::build(NeighList *list)
+{
+  build_rows(list, nullptr);
+}
+
+/* ----------------------------------------------------------------------
+   rebuild only rows of owned atoms in bins within neighbor cutoff + skin
+     of any of the nhot atoms in hot, which may be owned or ghost atoms
+   atoms must have been re-binned, ilist and inum are unchanged
+   new rows are appended to the pages of the list, old rows become unused
+     until the next full build resets the pages
+------------------------------------------------------------------------- */
+
+template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
+void NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::build_partial(NeighList *list, int *hot, int nhot)
+{
+  int i, ibin, ix, iy, iz, jx, jy, jz;
+
+  if (mbins > maxbinflag) {
+    maxbinflag = mbins;
+    memory->destroy(binflag);
+    memory->create(binflag, maxbinflag, "neigh:binflag");
+  }
+  for (i = 0; i < mbins; i++) binflag[i] = 0;
+
+  const double reach = MAX(neighbor->cutneighmax, cutoff_custom) + skin;
+  const int sx = static_cast<int>(reach * bininvx) + 1;
+  const int sy = static_cast<int>(reach * bininvy) + 1;
+  const int sz = (mbinz > 1) ? static_cast<int>(reach * bininvz) + 1 : 0;
+
+  for (i = 0; i < nhot; i++) {
+    ibin = atom2bin[hot[i]];
+    ix = ibin % mbinx;
+    iy = (ibin / mbinx) % mbiny;
+    iz = ibin / (mbinx * mbiny);
+    for (jz = MAX(iz - sz, 0); jz <= MIN(iz + sz, mbinz - 1); jz++)
+      for (jy = MAX(iy - sy, 0); jy <= MIN(iy + sy, mbiny - 1); jy++)
+        for (jx = MAX(ix - sx, 0); jx <= MIN(ix + sx, mbinx - 1); jx++)
+          binflag[jz * mbiny * mbinx + jy * mbinx + jx] = 1;
+  }
+
+  build_rows(list, binflag);
+}
+
+/* ----------------------------------------------------------------------
+   build rows of the list for all owned atoms or, if rowbins is not null,
+     only for owned atoms in bins flagged in rowbins
+------------------------------------------------------------------------- */
+
+template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
+void NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::build_rows(NeighList *list, int *rowbins)
 {
   int i, j, jh, k, n, itype, jtype, ibin, bin_start, which, imol, iatom, moltemplate;
   tagint itag, jtag, tagprev;
@@ -88,9 +154,10 @@ void NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::build(NeighList *list)
   MyPage<int> *ipage = list->ipage;
 
   int inum = 0;
-  ipage->reset();
+  if (!rowbins) ipage->reset();
 
   for (i = 0; i < nlocal; i++) {
+    if (rowbins && !rowbins[atom2bin[i]]) continue;
     n = 0;
     neighptr = ipage->vget();
 
@@ -241,13 +308,15 @@ void NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::build(NeighList *list)
       }
     }
 
-    ilist[inum++] = i;
+    if (!rowbins) ilist[inum++] = i;
     firstneigh[i] = neighptr;
     numneigh[i] = n;
     ipage->vgot(n);
     if (ipage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
   }
 
+  if (rowbins) return;
+
   list->inum = inum;
   if (!HALF) list->gnum = 0;
 }
@@ -110,7 +110,15 @@ template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
 class NPairBin : public NPair {
  public:
   NPairBin(class LAMMPS *);
+  ~NPairBin() override;
   void build(class NeighList *) override;
+  void build_partial(class NeighList *, int *, int) override;
+
+ private:
+  int *binflag;      // 1 for bins whose atoms need their rows rebuilt
+  int maxbinflag;    // size of binflag
+
+  void build_rows(class NeighList *, int *);
 };
 
 }    // namespace LAMMPS_NS
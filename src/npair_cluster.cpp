@@ -0,0 +1,384 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "npair_cluster.h"
+
+#include "atom.h"
+#include "domain.h"
+#include "force.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace LAMMPS_NS;
+
+static constexpr int CLUSTERSIZE = NeighList::CLUSTERSIZE;
+static constexpr int PAIRDELTA = 8192;
+static constexpr double BIG = 1.0e20;
+
+/* ---------------------------------------------------------------------- */
+
+NPairCluster::NPairCluster(LAMMPS *lmp) : NPair(lmp)
+{
+  maxatom = maxcol = maxbox = 0;
+  atomcol = order = nullptr;
+  colfirst = gcolfirst = nullptr;
+  clusterbox = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+NPairCluster::~NPairCluster()
+{
+  memory->destroy(atomcol);
+  memory->destroy(order);
+  memory->destroy(colfirst);
+  memory->destroy(gcolfirst);
+  memory->destroy(clusterbox);
+}
+
+/* ----------------------------------------------------------------------
+   Half + Newton, clusters of CLUSTERSIZE atoms:
+     owned and ghost atoms are separately sorted into columns along x (and y
+       in 3d) and by height within each column, then consecutive atoms of
+       a column are grouped into clusters, owned clusters are listed first
+     store pairs of clusters whose bounding boxes are within the cutoff,
+       with a bit mask of the atom pairs in them that are in the list
+     pair of owned clusters is stored once, a cluster with itself only
+       stores pairs of slots a < b
+     pairs are not found from a stencil of bins, so each owned/ghost atom
+       pair is tested explicitly to store it only once across procs:
+       orthogonal boxes keep the ghost atom if it is above the owned atom
+       in z, then y, then x, triclinic boxes use itag/jtag tests
+------------------------------------------------------------------------- */
+
+void NPairCluster::build(NeighList *list)
+{
+  int i, d, c, ci, cj, pass, npair;
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+  const int dimension = domain->dimension;
+
+  double cut = neighbor->cutneighmax;
+  if (cutoff_custom > 0.0) cut = cutoff_custom;
+  const double cutsq = cut * cut;
+
+  // bounding box of owned and ghost atoms and of owned atoms only
+
+  double lo[3], hi[3], olo[3], ohi[3];
+  for (d = 0; d < 3; d++) {
+    lo[d] = olo[d] = BIG;
+    hi[d] = ohi[d] = -BIG;
+  }
+  for (i = 0; i < nall; i++) {
+    for (d = 0; d < 3; d++) {
+      lo[d] = MIN(lo[d], x[i][d]);
+      hi[d] = MAX(hi[d], x[i][d]);
+    }
+    if (i == nlocal - 1)
+      for (d = 0; d < 3; d++) {
+        olo[d] = lo[d];
+        ohi[d] = hi[d];
+      }
+  }
+  if (nall == 0)
+    for (d = 0; d < 3; d++) lo[d] = hi[d] = 0.0;
+
+  // column width so that a cluster of owned atoms spans a cube on average
+  // coarsen columns, if there are more columns than atoms
+
+  sortdim = dimension - 1;
+  double volume = 1.0;
+  for (d = 0; d < dimension; d++) volume *= MAX(ohi[d] - olo[d], cut);
+  double width = cut;
+  if (nlocal > 0) width = pow(CLUSTERSIZE * volume / nlocal, 1.0 / dimension);
+
+  while (true) {
+    ncolx = static_cast<int>((hi[0] - lo[0]) / width) + 1;
+    ncoly = (dimension == 3) ? static_cast<int>((hi[1] - lo[1]) / width) + 1 : 1;
+    if ((bigint) ncolx * ncoly <= MAX(nall, 1)) break;
+    width *= 1.5;
+  }
+  collo[0] = lo[0];
+  collo[1] = lo[1];
+  colinv = 1.0 / width;
+  int ncol = ncolx * ncoly;
+
+  // grow scratch arrays
+
+  if (nall > maxatom) {
+    maxatom = atom->nmax;
+    memory->destroy(atomcol);
+    memory->destroy(order);
+    memory->create(atomcol, maxatom, "neigh:atomcol");
+    memory->create(order, maxatom, "neigh:order");
+  }
+  if (ncol + 1 > maxcol) {
+    maxcol = ncol + 1;
+    memory->destroy(colfirst);
+    memory->destroy(gcolfirst);
+    memory->create(colfirst, maxcol, "neigh:colfirst");
+    memory->create(gcolfirst, maxcol, "neigh:gcolfirst");
+  }
+
+  // clusters of owned atoms, then clusters of ghost atoms
+
+  list->nicluster = make_clusters(list, 0, nlocal, colfirst, 0);
+  list->ncluster = make_clusters(list, nlocal, nall, gcolfirst, list->nicluster);
+
+  if (list->nicluster + 1 > list->maxicluster) {
+    list->maxicluster = list->nicluster + 1;
+    memory->destroy(list->cfirst);
+    memory->create(list->cfirst, list->maxicluster, "neigh:cfirst");
+  }
+
+  // loop over owned clusters and columns within the cutoff of their box
+
+  int *cfirst = list->cfirst;
+  int c0lo, c0hi, c1lo, c1hi, ix, iy, jfirst, jlast;
+  double dist, rsq;
+  unsigned int bits;
+
+  npair = 0;
+  for (ci = 0; ci < list->nicluster; ci++) {
+    cfirst[ci] = npair;
+    const double *ibox = &clusterbox[6 * ci];
+
+    c0lo = MAX(static_cast<int>((ibox[0] - cut - collo[0]) * colinv), 0);
+    c0hi = MIN(static_cast<int>((ibox[3] + cut - collo[0]) * colinv), ncolx - 1);
+    c1lo = c1hi = 0;
+    if (dimension == 3) {
+      c1lo = MAX(static_cast<int>((ibox[1] - cut - collo[1]) * colinv), 0);
+      c1hi = MIN(static_cast<int>((ibox[4] + cut - collo[1]) * colinv), ncoly - 1);
+    }
+
+    for (iy = c1lo; iy <= c1hi; iy++) {
+      for (ix = c0lo; ix <= c0hi; ix++) {
+        c = iy * ncolx + ix;
+        for (pass = 0; pass < 2; pass++) {
+          if (pass == 0) {
+            jfirst = MAX(colfirst[c], ci);
+            jlast = colfirst[c + 1];
+          } else {
+            jfirst = gcolfirst[c];
+            jlast = gcolfirst[c + 1];
+          }
+
+          // clusters in a column are sorted by their lower bound in height
+
+          for (cj = jfirst; cj < jlast; cj++) {
+            const double *jbox = &clusterbox[6 * cj];
+            if (jbox[sortdim] > ibox[3 + sortdim] + cut) break;
+            rsq = 0.0;
+            for (d = 0; d < dimension; d++) {
+              dist = MAX(jbox[d] - ibox[3 + d], ibox[d] - jbox[3 + d]);
+              if (dist > 0.0) rsq += dist * dist;
+            }
+            if (rsq >= cutsq) continue;
+
+            bits = pair_mask(list, ci, cj);
+            if (!bits) continue;
+
+            if (npair == list->maxcpair) {
+              list->maxcpair += PAIRDELTA;
+              memory->grow(list->cjlist, list->maxcpair, "neigh:cjlist");
+              memory->grow(list->cjmask, list->maxcpair, "neigh:cjmask");
+            }
+            list->cjlist[npair] = cj;
+            list->cjmask[npair++] = bits;
+          }
+        }
+      }
+    }
+  }
+  cfirst[list->nicluster] = npair;
+
+  // per-atom list is left empty
+
+  list->inum = 0;
+  list->gnum = 0;
+}
+
+/* ----------------------------------------------------------------------
+   sort atoms ifirst to ilast-1 into columns and by height within columns
+   append clusters of consecutive atoms of each column to list, starting
+     at cluster index nstart, store their bounding boxes
+   set first[c] = first cluster of column c, first[ncol] = end
+   return new total # of clusters
+------------------------------------------------------------------------- */
+
+int NPairCluster::make_clusters(NeighList *list, int ifirst, int ilast, int *first, int nstart)
+{
+  int i, j, c, d, m, n, ix, iy;
+
+  double **x = atom->x;
+  const int ncol = ncolx * ncoly;
+
+  // count atoms per column, via first[] shifted by one
+
+  for (c = 0; c <= ncol; c++) first[c] = 0;
+  for (i = ifirst; i < ilast; i++) {
+    ix = static_cast<int>((x[i][0] - collo[0]) * colinv);
+    iy = (ncoly > 1) ? static_cast<int>((x[i][1] - collo[1]) * colinv) : 0;
+    ix = MIN(MAX(ix, 0), ncolx - 1);
+    iy = MIN(MAX(iy, 0), ncoly - 1);
+    atomcol[i] = iy * ncolx + ix;
+    first[atomcol[i] + 1]++;
+  }
+
+  // total # of clusters, each column starts a new cluster
+
+  int ntotal = nstart;
+  for (c = 1; c <= ncol; c++) ntotal += (first[c] + CLUSTERSIZE - 1) / CLUSTERSIZE;
+
+  if (ntotal > list->maxcluster) {
+    list->maxcluster = ntotal;
+    memory->grow(list->clusteratom, CLUSTERSIZE * list->maxcluster, "neigh:clusteratom");
+  }
+  if (ntotal > maxbox) {
+    maxbox = list->maxcluster;
+    memory->grow(clusterbox, 6 * maxbox, "neigh:clusterbox");
+  }
+
+  // counting sort by column, then by height within each column
+
+  for (c = 1; c <= ncol; c++) first[c] += first[c - 1];
+  int *next = order + ifirst;
+  for (i = ifirst; i < ilast; i++) next[first[atomcol[i]]++] = i;
+  for (c = ncol; c > 0; c--) first[c] = first[c - 1];
+  first[0] = 0;
+
+  const int sd = sortdim;
+  for (c = 0; c < ncol; c++)
+    std::sort(next + first[c], next + first[c + 1],
+              [x, sd](int a, int b) { return x[a][sd] < x[b][sd]; });
+
+  // group atoms of each column into clusters, empty slots are -1
+  // convert first[] from atom offsets to cluster indices
+
+  int *clusteratom = list->clusteratom;
+  int nclusters = nstart;
+  int istart = 0;
+
+  for (c = 0; c < ncol; c++) {
+    int iend = first[c + 1];
+    first[c] = nclusters;
+    for (m = istart; m < iend; m += CLUSTERSIZE) {
+      double *box = &clusterbox[6 * nclusters];
+      for (d = 0; d < 3; d++) {
+        box[d] = BIG;
+        box[3 + d] = -BIG;
+      }
+      for (n = 0; n < CLUSTERSIZE; n++) {
+        if (m + n < iend) {
+          j = next[m + n];
+          clusteratom[CLUSTERSIZE * nclusters + n] = j;
+          for (d = 0; d < 3; d++) {
+            box[d] = MIN(box[d], x[j][d]);
+            box[3 + d] = MAX(box[3 + d], x[j][d]);
+          }
+        } else
+          clusteratom[CLUSTERSIZE * nclusters + n] = -1;
+      }
+      nclusters++;
+    }
+    istart = iend;
+  }
+  first[ncol] = nclusters;
+
+  return nclusters;
+}
+
+/* ----------------------------------------------------------------------
+   return mask of atom pairs in clusters ci,cj stored in the list
+   bit a*CLUSTERSIZE+b is set if atoms in slots a,b of ci,cj interact
+------------------------------------------------------------------------- */
+
+unsigned int NPairCluster::pair_mask(NeighList *list, int ci, int cj)
+{
+  int a, b, i, j, itype, jtype;
+  tagint itag, jtag;
+  double delx, dely, delz, rsq;
+
+  const double delta = 0.01 * force->angstrom;
+
+  // a cutoff set by the requestor replaces the per-type cutoffs
+
+  const double cutcustomsq = cutoff_custom * cutoff_custom;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *tag = atom->tag;
+  tagint *molecule = atom->molecule;
+  int nlocal = atom->nlocal;
+  int triclinic = domain->triclinic;
+
+  const int *iatoms = &list->clusteratom[CLUSTERSIZE * ci];
+  const int *jatoms = &list->clusteratom[CLUSTERSIZE * cj];
+  unsigned int bits = 0;
+
+  for (a = 0; a < CLUSTERSIZE; a++) {
+    i = iatoms[a];
+    if (i < 0) break;
+    itag = tag[i];
+    itype = type[i];
+
+    for (b = (ci == cj) ? a + 1 : 0; b < CLUSTERSIZE; b++) {
+      j = jatoms[b];
+      if (j < 0) break;
+
+      if (j >= nlocal && !triclinic) {
+        if (x[j][2] < x[i][2]) continue;
+        if (x[j][2] == x[i][2]) {
+          if (x[j][1] < x[i][1]) continue;
+          if (x[j][1] == x[i][1] && x[j][0] < x[i][0]) continue;
+        }
+      } else if (j >= nlocal) {
+        jtag = tag[j];
+        if (itag > jtag) {
+          if ((itag + jtag) % 2 == 0) continue;
+        } else if (itag < jtag) {
+          if ((itag + jtag) % 2 == 1) continue;
+        } else {
+          if (fabs(x[j][2] - x[i][2]) > delta) {
+            if (x[j][2] < x[i][2]) continue;
+          } else if (fabs(x[j][1] - x[i][1]) > delta) {
+            if (x[j][1] < x[i][1]) continue;
+          } else {
+            if (x[j][0] < x[i][0]) continue;
+          }
+        }
+      }
+
+      jtype = type[j];
+      if (exclude && exclusion(i, j, itype, jtype, mask, molecule)) continue;
+
+      delx = x[i][0] - x[j][0];
+      dely = x[i][1] - x[j][1];
+      delz = x[i][2] - x[j][2];
+      rsq = delx * delx + dely * dely + delz * delz;
+      if (cutoff_custom > 0.0) {
+        if (rsq <= cutcustomsq) bits |= 1U << (a * CLUSTERSIZE + b);
+      } else if (rsq <= cutneighsq[itype][jtype])
+        bits |= 1U << (a * CLUSTERSIZE + b);
+    }
+  }
+
+  return bits;
+}
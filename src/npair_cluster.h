@@ -0,0 +1,58 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef NPAIR_CLASS
+// clang-format off
+NPairStyle(half/cluster/newton,
+           NPairCluster,
+           NP_HALF | NP_CLUSTER | NP_NSQ | NP_BIN | NP_NEWTON | NP_ATOMONLY |
+           NP_ORTHO | NP_TRI);
+// clang-format on
+#else
+
+#ifndef LMP_NPAIR_CLUSTER_H
+#define LMP_NPAIR_CLUSTER_H
+
+#include "npair.h"
+
+namespace LAMMPS_NS {
+
+class NPairCluster : public NPair {
+ public:
+  NPairCluster(class LAMMPS *);
+  ~NPairCluster() override;
+  void build(class NeighList *) override;
+
+ private:
+  int maxatom;          // size of per-atom scratch arrays
+  int *atomcol;         // column of each atom
+  int *order;           // atom indices sorted by column and height
+  int maxcol;           // size of per-column arrays
+  int *colfirst;        // first cluster of owned atoms in each column
+  int *gcolfirst;       // first cluster of ghost atoms in each column
+  int maxbox;           // size of per-cluster bounding boxes
+  double *clusterbox;   // lo/hi bounds of each cluster in 3 dims
+
+  int ncolx, ncoly;     // # of columns in x and y
+  int sortdim;          // dimension along columns, z in 3d, y in 2d
+  double collo[2];      // lower corner of column grid
+  double colinv;        // inverse column width
+
+  int make_clusters(class NeighList *, int, int, int *, int);
+  unsigned int pair_mask(class NeighList *, int, int);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -18,7 +18,12 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-NPairCopy::NPairCopy(LAMMPS *lmp) : NPair(lmp) {}
+NPairCopy::NPairCopy(LAMMPS *lmp) : NPair(lmp)
+{
+  // rows rebuilt in parent list are visible here, since arrays are shared
+
+  partial_enable = 1;
+}
 
 /* ----------------------------------------------------------------------
    create list which is simply a copy of parent list
@@ -120,7 +120,10 @@ Output::~Output()
   for (int i = 0; i < ndump; i++) delete[] var_dump[i];
   memory->sfree(var_dump);
   memory->destroy(ivar_dump);
-  for (int i = 0; i < ndump; i++) delete dump[i];
+  for (int i = 0; i < ndump; i++) {
+    dump[i]->async_wait(0);
+    delete dump[i];
+  }
   memory->sfree(dump);
 
   delete[] restart1;
@@ -462,6 +465,26 @@ void Output::write(bigint ntimestep)
   next = MIN(next,next_thermo);
 }
 
+/* ----------------------------------------------------------------------
+   wait for snapshots still being written by background threads
+   called at the end of a run, so files are complete when it returns
+------------------------------------------------------------------------- */
+
+void Output::finish_dumps()
+{
+  for (int idump = 0; idump < ndump; idump++) dump[idump]->async_wait();
+}
+
+/* ----------------------------------------------------------------------
+   complete a restart file still being written with asynchronous MPI-IO
+   called at the end of a run, so the file is complete when it returns
+------------------------------------------------------------------------- */
+
+void Output::finish_restart()
+{
+  if (restart) restart->finish();
+}
+
 /* ----------------------------------------------------------------------
    force a snapshot to be written for all dumps
    called from PRD and TAD
@@ -819,6 +842,7 @@ void Output::delete_dump(const std::string &id)
   for (idump = 0; idump < ndump; idump++) if (id == dump[idump]->id) break;
   if (idump == ndump) error->all(FLERR,"Could not find undump ID: {}", id);
 
+  dump[idump]->async_wait();
   delete dump[idump];
   delete[] var_dump[idump];
 
@@ -1001,6 +1025,14 @@ void Output::create_restart(int narg, char **arg)
   restart = new WriteRestart(lmp);
   int iarg = nfile+1;
   restart->multiproc_options(multiproc,narg-iarg,&arg[iarg]);
+
+  // single and toggled files share the same WriteRestart instance,
+  //   so they would also share the sequence of base and delta files
+
+  if (restart_flag_double && restart->delta_every)
+    error->all(FLERR,"Restart delta cannot be used with two restart file names");
+  if (restart->delta_every && !strchr(arg[1],'*'))
+    error->all(FLERR,"Restart delta requires a file name with the '*' wildcard");
 }
 
 /* ----------------------------------------------------------------------
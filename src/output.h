@@ -76,6 +76,8 @@ class Output : protected Pointers {
   void setup(int memflag = 1);    // initial output before run/min
   void write(bigint);             // output for current timestep
   void write_dump(bigint);        // force output of dump snapshots
+  void finish_dumps();            // complete pending async dump writes
+  void finish_restart();          // complete a pending async restart write
   void write_restart(bigint);     // force output of a restart file
   void reset_timestep(bigint);    // reset output which depends on timestep
   void reset_dt();                // reset output which depends on timestep size
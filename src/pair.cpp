@@ -28,6 +28,7 @@
 #include "math_const.h"
 #include "math_special.h"
 #include "memory.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "suffix.h"
 #include "update.h"
@@ -42,6 +43,8 @@ using MathConst::MY_ISPI4;
 using MathConst::THIRD;
 using MathSpecial::powint;
 
+static constexpr int OVERLAP_CHUNK = 1024;    // # of interior atoms between comm progress
+
 enum { NONE, RLINEAR, RSQ, BMP };
 static const std::string mixing_rule_names[Pair::SIXTHPOWER + 1] = {"geometric", "arithmetic",
                                                                     "sixthpower"};
@@ -75,6 +78,9 @@ Pair::Pair(LAMMPS *lmp) :
   respa_enable = 0;
   one_coeff = 0;
   no_virial_fdotr_compute = 0;
+  cluster_enable = 0;
+  precision_enable = 0;
+  overlap_enable = 0;
   writedata = 0;
   finitecutflag = 0;
   ghostneigh = 0;
@@ -102,12 +108,29 @@ Pair::Pair(LAMMPS *lmp) :
   tabinner = sqrt(2.0);
   tabinner_disp = sqrt(2.0);
   trim_flag = 1;
+  cluster_flag = 0;
+  precision = PREC_DOUBLE;
 
   allocated = 0;
   suffix_flag = Suffix::NONE;
 
   maxeatom = maxvatom = maxcvatom = 0;
 
+  maxcluster = 0;
+  xcluster = fcluster = nullptr;
+  tcluster = nullptr;
+
+  maxxfloat = 0;
+  xfloat = nullptr;
+
+  overlap_flag = overlap_first = overlap_last = 0;
+  overlap_inum = 0;
+  overlap_ilist = nullptr;
+  ninterior = nboundary = maxoverlap = 0;
+  ilist_interior = ilist_boundary = nullptr;
+  overlap_list = nullptr;
+  overlap_stamp = -1;
+
   num_tally_compute = 0;
   did_tally_flag = 0;
 
@@ -144,6 +167,13 @@ Pair::~Pair()
   memory->destroy(eatom);
   memory->destroy(vatom);
   memory->destroy(cvatom);
+
+  memory->destroy(xcluster);
+  memory->destroy(fcluster);
+  memory->destroy(tcluster);
+  memory->destroy(xfloat);
+  memory->destroy(ilist_interior);
+  memory->destroy(ilist_boundary);
 }
 
 // clang-format off
@@ -206,6 +236,17 @@ void Pair::modify_params(int narg, char **arg)
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "pair_modify neigh/trim", error);
       trim_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"cluster") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "pair_modify cluster", error);
+      cluster_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"precision") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "pair_modify precision", error);
+      if (strcmp(arg[iarg+1],"double") == 0) precision = PREC_DOUBLE;
+      else if (strcmp(arg[iarg+1],"mixed") == 0) precision = PREC_MIXED;
+      else if (strcmp(arg[iarg+1],"single") == 0) precision = PREC_SINGLE;
+      else error->all(FLERR,"Unknown pair_modify precision setting: {}", arg[iarg+1]);
+      iarg += 2;
     } else error->all(FLERR,"Unknown pair_modify keyword: {}", arg[iarg]);
   }
 }
@@ -227,6 +268,27 @@ void Pair::init()
   if (!compute_flag && offset_flag && comm->me == 0)
     error->warning(FLERR,"Using pair potential shift with pair_modify compute no");
 
+  // cluster-pair lists store each pair once and no special bond info
+
+  if (cluster_flag) {
+    if (!cluster_enable)
+      error->all(FLERR,"Pair style {} does not support pair_modify cluster",force->pair_style);
+    if (atom->molecular != Atom::ATOMIC)
+      error->all(FLERR,"Pair_modify cluster requires an atomic system");
+    if (!force->newton_pair)
+      error->all(FLERR,"Pair_modify cluster requires newton pair on");
+  }
+
+  // reduced precision compute() is only available in some styles
+
+  if (precision != PREC_DOUBLE) {
+    if (!precision_enable)
+      error->all(FLERR,"Pair style {} does not support pair_modify precision",
+                 force->pair_style);
+    if (cluster_flag)
+      error->all(FLERR,"Pair_modify precision single or mixed cannot be used with cluster yes");
+  }
+
   // for manybody potentials
   // check if bonded exclusions could invalidate the neighbor list
 
@@ -251,6 +313,11 @@ void Pair::init()
   for (i = 1; i <= atom->ntypes; i++)
     if (setflag[i][i] == 0) error->all(FLERR,"All pair coeffs are not set");
 
+  // interior/boundary split must be redone for the lists of this run
+
+  overlap_list = nullptr;
+  overlap_stamp = -1;
+
   // style-specific initialization
 
   init_style();
@@ -334,11 +401,13 @@ void Pair::reinit()
      if needs its own error checks
      if needs another kind of neighbor list
    request default neighbor list = half list
+     or cluster-pair list if set by pair_modify cluster
 ------------------------------------------------------------------------- */
 
 void Pair::init_style()
 {
-  neighbor->add_request(this);
+  if (cluster_flag) neighbor->add_request(this, NeighConst::REQ_CLUSTER);
+  else neighbor->add_request(this);
 }
 
 /* ----------------------------------------------------------------------
@@ -1005,6 +1074,176 @@ void Pair::ev_unset()
   vflag_fdotr = 0;
 }
 
+/* ----------------------------------------------------------------------
+   gather coords and types of atoms in clusters of a cluster-pair list
+   empty slots get type 1 at the origin, they are masked in the list
+   zero per-slot forces
+------------------------------------------------------------------------- */
+
+void Pair::cluster_pack()
+{
+  const int CS = NeighList::CLUSTERSIZE;
+  int ncluster = list->ncluster;
+
+  if (ncluster > maxcluster) {
+    maxcluster = list->maxcluster;
+    memory->destroy(xcluster);
+    memory->destroy(fcluster);
+    memory->destroy(tcluster);
+    memory->create(xcluster,3*CS*maxcluster,"pair:xcluster");
+    memory->create(fcluster,3*CS*maxcluster,"pair:fcluster");
+    memory->create(tcluster,CS*maxcluster,"pair:tcluster");
+  }
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int *clusteratom = list->clusteratom;
+  int i,a,c;
+
+  for (c = 0; c < ncluster; c++) {
+    double *xc = &xcluster[3*CS*c];
+    for (a = 0; a < CS; a++) {
+      i = clusteratom[CS*c+a];
+      if (i >= 0) {
+        xc[a] = x[i][0];
+        xc[CS+a] = x[i][1];
+        xc[2*CS+a] = x[i][2];
+        tcluster[CS*c+a] = type[i];
+      } else {
+        xc[a] = xc[CS+a] = xc[2*CS+a] = 0.0;
+        tcluster[CS*c+a] = 1;
+      }
+    }
+  }
+
+  memset(fcluster,0,3*CS*ncluster*sizeof(double));
+}
+
+/* ----------------------------------------------------------------------
+   copy coords of owned and ghost atoms to single precision array
+------------------------------------------------------------------------- */
+
+void Pair::xfloat_pack()
+{
+  int nall = atom->nlocal + atom->nghost;
+
+  if (atom->nmax > maxxfloat) {
+    maxxfloat = atom->nmax;
+    memory->destroy(xfloat);
+    memory->create(xfloat,4*maxxfloat,"pair:xfloat");
+  }
+
+  double **x = atom->x;
+  for (int i = 0; i < nall; i++) {
+    xfloat[4*i] = (float) x[i][0];
+    xfloat[4*i+1] = (float) x[i][1];
+    xfloat[4*i+2] = (float) x[i][2];
+    xfloat[4*i+3] = 0.0f;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compute forces of interior atoms whose neighbors are all owned atoms
+   called while forward comm of ghost coords is in flight
+   work is done in chunks, comm is progressed between chunks
+   must be followed by compute_boundary() on the same timestep
+------------------------------------------------------------------------- */
+
+void Pair::compute_interior(int eflag, int vflag)
+{
+  if ((list != overlap_list) || (list->stamp != overlap_stamp)) overlap_split();
+
+  overlap_flag = 1;
+  overlap_last = 0;
+
+  int ifirst = 0;
+  do {
+    overlap_first = (ifirst == 0);
+    overlap_inum = MIN(OVERLAP_CHUNK,ninterior-ifirst);
+    overlap_ilist = ilist_interior + ifirst;
+    compute(eflag,vflag);
+    comm->forward_comm_progress();
+    ifirst += overlap_inum;
+  } while (ifirst < ninterior);
+}
+
+/* ----------------------------------------------------------------------
+   compute forces of boundary atoms with ghost neighbors
+   called after forward comm of ghost coords has completed
+------------------------------------------------------------------------- */
+
+void Pair::compute_boundary(int eflag, int vflag)
+{
+  overlap_first = 0;
+  overlap_last = 1;
+  overlap_inum = nboundary;
+  overlap_ilist = ilist_boundary;
+  compute(eflag,vflag);
+  overlap_flag = 0;
+}
+
+/* ----------------------------------------------------------------------
+   split atoms of the neighbor list into interior and boundary atoms
+   redone after every full or partial build of the list
+------------------------------------------------------------------------- */
+
+void Pair::overlap_split()
+{
+  overlap_list = list;
+  overlap_stamp = list->stamp;
+
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  int nlocal = atom->nlocal;
+
+  if (inum > maxoverlap) {
+    memory->destroy(ilist_interior);
+    memory->destroy(ilist_boundary);
+    maxoverlap = atom->nmax;
+    memory->create(ilist_interior,maxoverlap,"pair:ilist_interior");
+    memory->create(ilist_boundary,maxoverlap,"pair:ilist_boundary");
+  }
+
+  ninterior = nboundary = 0;
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+    int jj;
+    for (jj = 0; jj < jnum; jj++)
+      if ((jlist[jj] & NEIGHMASK) >= nlocal) break;
+    if (jj == jnum) ilist_interior[ninterior++] = i;
+    else ilist_boundary[nboundary++] = i;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   add per-slot forces of atom clusters to atom forces
+------------------------------------------------------------------------- */
+
+void Pair::cluster_unpack()
+{
+  const int CS = NeighList::CLUSTERSIZE;
+  int ncluster = list->ncluster;
+
+  double **f = atom->f;
+  int *clusteratom = list->clusteratom;
+  int i,a,c;
+
+  for (c = 0; c < ncluster; c++) {
+    const double *fc = &fcluster[3*CS*c];
+    for (a = 0; a < CS; a++) {
+      i = clusteratom[CS*c+a];
+      if (i < 0) continue;
+      f[i][0] += fc[a];
+      f[i][1] += fc[CS+a];
+      f[i][2] += fc[2*CS+a];
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    tally eng_vdwl and virial into global or per-atom accumulators
    need i < nlocal test since called by bond_quartic and dihedral_charmm
@@ -2007,6 +2246,9 @@ double Pair::memory_usage()
   double bytes = (double)comm->nthreads*maxeatom * sizeof(double);
   bytes += (double)comm->nthreads*maxvatom*6 * sizeof(double);
   bytes += (double)comm->nthreads*maxcvatom*9 * sizeof(double);
+  bytes += (double)maxcluster*NeighList::CLUSTERSIZE * (6*sizeof(double) + sizeof(int));
+  bytes += (double)2*maxoverlap * sizeof(int);
+  bytes += (double)4*maxxfloat * sizeof(float);
   return bytes;
 }
 
@@ -56,6 +56,9 @@ class Pair : protected Pointers {
   int single_hessian_enable;      // 1 if single_hessian() routine exists
   int restartinfo;                // 1 if pair style writes restart info
   int respa_enable;               // 1 if inner/middle/outer rRESPA routines
+  int cluster_enable;             // 1 if compute() supports cluster-pair lists
+  int overlap_enable;             // 1 if compute() can run on parts of the list
+  int precision_enable;           // 1 if compute() supports single/mixed precision
   int one_coeff;                  // 1 if allows only one coeff * * call
   int manybody_flag;              // 1 if a manybody potential
   int unit_convert_flag;          // value != 0 indicates support for unit conversion.
@@ -83,6 +86,8 @@ class Pair : protected Pointers {
   double etail, ptail;    // energy/pressure tail corrections
   double etail_ij, ptail_ij;
   int trim_flag;    // pair_modify flag for trimming neigh list
+  int cluster_flag;    // pair_modify flag for using cluster-pair neigh list
+  int precision;       // pair_modify precision of force compute, see enum below
 
   int evflag;    // energy,virial settings
   int eflag_either, eflag_global, eflag_atom;
@@ -116,6 +121,7 @@ class Pair : protected Pointers {
   bool did_mix;        // set to true by mix_energy() to indicate that mixing was performed
 
   enum { GEOMETRIC, ARITHMETIC, SIXTHPOWER };    // mixing options
+  enum { PREC_DOUBLE, PREC_MIXED, PREC_SINGLE };    // precision options
 
   int beyond_contact, nondefault_history_transfer;    // for granular styles
 
@@ -153,6 +159,8 @@ class Pair : protected Pointers {
   // general child-class methods
 
   virtual void compute(int, int) = 0;
+  void compute_interior(int, int);
+  void compute_boundary(int, int);
   virtual void compute_inner() {}
   virtual void compute_middle() {}
   virtual void compute_outer(int, int) {}
@@ -278,6 +286,37 @@ class Pair : protected Pointers {
   int vflag_fdotr;
   int maxeatom, maxvatom, maxcvatom;
 
+  // per-slot coordinates, types, and forces of atom clusters
+  // stored as CLUSTERSIZE values for each dimension of each cluster
+
+  int maxcluster;
+  double *xcluster, *fcluster;
+  int *tcluster;
+  void cluster_pack();
+  void cluster_unpack();
+
+  // split of the neighbor list for overlap of compute() with forward comm
+  // interior atoms have only owned neighbors, boundary atoms have ghosts
+  // while overlap_flag is set, compute() loops over overlap_ilist
+  //   and only calls ev_init() for the first and fdotr for the last part
+
+  int overlap_flag;
+  int overlap_first, overlap_last;
+  int overlap_inum;
+  int *overlap_ilist;
+  int ninterior, nboundary, maxoverlap;
+  int *ilist_interior, *ilist_boundary;
+  class NeighList *overlap_list;    // list the split was made for
+  bigint overlap_stamp;             // list->stamp when split was made
+  void overlap_split();
+
+  // single precision copy of owned and ghost coords for reduced precision
+  // stored as 4 values per atom, the 4th is padding
+
+  int maxxfloat;
+  float *xfloat;
+  void xfloat_pack();
+
   int copymode;    // if set, do not deallocate during destruction
                    // required when classes are used as functors by Kokkos
 
@@ -33,6 +33,8 @@ using namespace MathConst;
 PairBuck::PairBuck(LAMMPS *lmp) : Pair(lmp)
 {
   born_matrix_enable = 1;
+  cluster_enable = 1;
+  overlap_enable = 1;
   writedata = 1;
 }
 
@@ -67,8 +69,18 @@ void PairBuck::compute(int eflag, int vflag)
   double r,rexp;
   int *ilist,*jlist,*numneigh,**firstneigh;
 
+  if (cluster_flag) {
+    ev_init(eflag,vflag);
+    if (evflag) {
+      if (eflag) compute_cluster<1,1>();
+      else compute_cluster<1,0>();
+    } else compute_cluster<0,0>();
+    if (vflag_fdotr) virial_fdotr_compute();
+    return;
+  }
+
   evdwl = 0.0;
-  ev_init(eflag,vflag);
+  if (!overlap_flag || overlap_first) ev_init(eflag,vflag);
 
   double **x = atom->x;
   double **f = atom->f;
@@ -77,8 +89,13 @@ void PairBuck::compute(int eflag, int vflag)
   double *special_lj = force->special_lj;
   int newton_pair = force->newton_pair;
 
-  inum = list->inum;
-  ilist = list->ilist;
+  if (overlap_flag) {
+    inum = overlap_inum;
+    ilist = overlap_ilist;
+  } else {
+    inum = list->inum;
+    ilist = list->ilist;
+  }
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
@@ -133,7 +150,87 @@ void PairBuck::compute(int eflag, int vflag)
     }
   }
 
-  if (vflag_fdotr) virial_fdotr_compute();
+  if (vflag_fdotr && (!overlap_flag || overlap_last)) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   same as compute() but loops over pairs of atom clusters
+   all CLUSTERSIZE x CLUSTERSIZE atom pairs of a cluster pair are computed
+     without branches and masked, so the compiler can vectorize the loop
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG>
+void PairBuck::compute_cluster()
+{
+  constexpr int CS = NeighList::CLUSTERSIZE;
+  int ia,ib,ci,cj,k;
+  double evdwl = 0.0;
+
+  cluster_pack();
+
+  const int nlocal = atom->nlocal;
+  const int nicluster = list->nicluster;
+  const int *const clusteratom = list->clusteratom;
+  const int *const cfirst = list->cfirst;
+  const int *const cjlist = list->cjlist;
+  const unsigned int *const cjmask = list->cjmask;
+
+  for (ci = 0; ci < nicluster; ci++) {
+    const double *const xi = &xcluster[3*CS*ci];
+    const int *const ti = &tcluster[CS*ci];
+    double *const fi = &fcluster[3*CS*ci];
+
+    for (k = cfirst[ci]; k < cfirst[ci+1]; k++) {
+      cj = cjlist[k];
+      const unsigned int bits = cjmask[k];
+      const double *const xj = &xcluster[3*CS*cj];
+      const int *const tj = &tcluster[CS*cj];
+      double *const fj = &fcluster[3*CS*cj];
+
+      for (ia = 0; ia < CS; ia++) {
+        const int itype = ti[ia];
+        const double *const cutsqi = cutsq[itype];
+        const double *const rhoinvi = rhoinv[itype];
+        const double *const buck1i = buck1[itype];
+        const double *const buck2i = buck2[itype];
+        double fxtmp = 0.0, fytmp = 0.0, fztmp = 0.0;
+
+        for (ib = 0; ib < CS; ib++) {
+          const int jtype = tj[ib];
+          const double delx = xi[ia] - xj[ib];
+          const double dely = xi[CS+ia] - xj[CS+ib];
+          const double delz = xi[2*CS+ia] - xj[2*CS+ib];
+          const double rsq = delx*delx + dely*dely + delz*delz;
+          const bool inside = ((bits >> (ia*CS+ib)) & 1U) && (rsq < cutsqi[jtype]);
+          const double r2inv = inside ? 1.0/rsq : 0.0;
+          const double r6inv = r2inv*r2inv*r2inv;
+          const double r = inside ? sqrt(rsq) : 0.0;
+          const double rexp = exp(-r*rhoinvi[jtype]);
+          const double forcebuck = buck1i[jtype]*r*rexp - buck2i[jtype]*r6inv;
+          const double fpair = forcebuck*r2inv;
+
+          fxtmp += delx*fpair;
+          fytmp += dely*fpair;
+          fztmp += delz*fpair;
+          fj[ib] -= delx*fpair;
+          fj[CS+ib] -= dely*fpair;
+          fj[2*CS+ib] -= delz*fpair;
+
+          if (EVFLAG && inside) {
+            if (EFLAG)
+              evdwl = a[itype][jtype]*rexp - c[itype][jtype]*r6inv - offset[itype][jtype];
+            ev_tally(clusteratom[CS*ci+ia],clusteratom[CS*cj+ib],nlocal,1,
+                     evdwl,0.0,fpair,delx,dely,delz);
+          }
+        }
+        fi[ia] += fxtmp;
+        fi[CS+ia] += fytmp;
+        fi[2*CS+ia] += fztmp;
+      }
+    }
+  }
+
+  cluster_unpack();
 }
 
 /* ----------------------------------------------------------------------
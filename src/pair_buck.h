@@ -49,6 +49,7 @@ class PairBuck : public Pair {
   double **rhoinv, **buck1, **buck2, **offset;
 
   virtual void allocate();
+  template <int EVFLAG, int EFLAG> void compute_cluster();
 };
 
 }    // namespace LAMMPS_NS
@@ -23,8 +23,10 @@
 #include "neigh_request.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "profiler.h"
 #include "respa.h"
 #include "suffix.h"
+#include "timer.h"
 #include "update.h"
 
 #include <cstring>
@@ -130,6 +132,8 @@ void PairHybrid::compute(int eflag, int vflag)
       // outerflag is set and sub-style has a compute_outer() method
 
       if (styles[m]->compute_flag == 0) continue;
+      ProfileScope prof(timer->profiler, Profiler::PAIR, styles[m], keywords[m],
+                        multiple[m] ? multiple[m] : -1, keywords[m]);
       if (outerflag && styles[m]->respa_enable)
         styles[m]->compute_outer(eflag,vflag_substyle);
       else styles[m]->compute(eflag,vflag_substyle);
@@ -40,7 +40,11 @@ PairLJCut::PairLJCut(LAMMPS *lmp) : Pair(lmp)
 {
   respa_enable = 1;
   born_matrix_enable = 1;
+  cluster_enable = 1;
+  overlap_enable = 1;
+  precision_enable = 1;
   writedata = 1;
+  coeff_float = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -49,6 +53,8 @@ PairLJCut::~PairLJCut()
 {
   if (copymode) return;
 
+  memory->destroy(coeff_float);
+
   if (allocated) {
     memory->destroy(setflag);
     memory->destroy(cutsq);
@@ -73,8 +79,31 @@ void PairLJCut::compute(int eflag, int vflag)
   double rsq, r2inv, r6inv, forcelj, factor_lj;
   int *ilist, *jlist, *numneigh, **firstneigh;
 
+  if (cluster_flag) {
+    ev_init(eflag, vflag);
+    if (evflag) {
+      if (eflag) compute_cluster<1, 1>();
+      else compute_cluster<1, 0>();
+    } else compute_cluster<0, 0>();
+    if (vflag_fdotr) virial_fdotr_compute();
+    return;
+  }
+
+  if (precision != PREC_DOUBLE) {
+    ev_init(eflag, vflag);
+    if (precision == PREC_MIXED) compute_float<double>();
+    else compute_float<float>();
+    if (vflag_fdotr) virial_fdotr_compute();
+    return;
+  }
+
+  if (atom->soa_flag) {
+    compute_soa(eflag, vflag);
+    return;
+  }
+
   evdwl = 0.0;
-  ev_init(eflag, vflag);
+  if (!overlap_flag || overlap_first) ev_init(eflag, vflag);
 
   double **x = atom->x;
   double **f = atom->f;
@@ -83,8 +112,13 @@ void PairLJCut::compute(int eflag, int vflag)
   double *special_lj = force->special_lj;
   int newton_pair = force->newton_pair;
 
-  inum = list->inum;
-  ilist = list->ilist;
+  if (overlap_flag) {
+    inum = overlap_inum;
+    ilist = overlap_ilist;
+  } else {
+    inum = list->inum;
+    ilist = list->ilist;
+  }
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
@@ -135,9 +169,308 @@ void PairLJCut::compute(int eflag, int vflag)
     }
   }
 
+  if (vflag_fdotr && (!overlap_flag || overlap_last)) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   same as compute() but reads coordinates from the contiguous
+   per-component streams of atom->x_soa, enabled via atom_modify soa
+------------------------------------------------------------------------- */
+
+void PairLJCut::compute_soa(int eflag, int vflag)
+{
+  int i, j, ii, jj, inum, jnum, itype, jtype;
+  double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
+  double rsq, r2inv, r6inv, forcelj, factor_lj;
+  double fxtmp, fytmp, fztmp;
+  int *ilist, *jlist, *numneigh, **firstneigh;
+
+  evdwl = 0.0;
+  ev_init(eflag, vflag);
+
+  atom->soa_pack();
+  const double *const xs = atom->x_soa[0];
+  const double *const ys = atom->x_soa[1];
+  const double *const zs = atom->x_soa[2];
+  double **f = atom->f;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  double *special_lj = force->special_lj;
+  int newton_pair = force->newton_pair;
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  // loop over neighbors of my atoms
+  // accumulate force on atom i in registers, write back once per atom
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = xs[i];
+    ytmp = ys[i];
+    ztmp = zs[i];
+    itype = type[i];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    const double *const cutsqi = cutsq[itype];
+    const double *const lj1i = lj1[itype];
+    const double *const lj2i = lj2[itype];
+    fxtmp = fytmp = fztmp = 0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - xs[j];
+      dely = ytmp - ys[j];
+      delz = ztmp - zs[j];
+      rsq = delx * delx + dely * dely + delz * delz;
+      jtype = type[j];
+
+      if (rsq < cutsqi[jtype]) {
+        r2inv = 1.0 / rsq;
+        r6inv = r2inv * r2inv * r2inv;
+        forcelj = r6inv * (lj1i[jtype] * r6inv - lj2i[jtype]);
+        fpair = factor_lj * forcelj * r2inv;
+
+        fxtmp += delx * fpair;
+        fytmp += dely * fpair;
+        fztmp += delz * fpair;
+        if (newton_pair || j < nlocal) {
+          f[j][0] -= delx * fpair;
+          f[j][1] -= dely * fpair;
+          f[j][2] -= delz * fpair;
+        }
+
+        if (eflag) {
+          evdwl = r6inv * (lj3[itype][jtype] * r6inv - lj4[itype][jtype]) - offset[itype][jtype];
+          evdwl *= factor_lj;
+        }
+
+        if (evflag) ev_tally(i, j, nlocal, newton_pair, evdwl, 0.0, fpair, delx, dely, delz);
+      }
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
+
   if (vflag_fdotr) virial_fdotr_compute();
 }
 
+/* ----------------------------------------------------------------------
+   same as compute() but with pairwise terms in single precision
+   acc_t = float for single, double for mixed precision accumulation
+     of the forces on each atom i
+------------------------------------------------------------------------- */
+
+template <class acc_t> void PairLJCut::compute_float()
+{
+  xfloat_pack();
+
+  if (evflag) {
+    if (eflag_either) {
+      if (force->newton_pair) eval_float<acc_t, 1, 1, 1>();
+      else eval_float<acc_t, 1, 1, 0>();
+    } else {
+      if (force->newton_pair) eval_float<acc_t, 1, 0, 1>();
+      else eval_float<acc_t, 1, 0, 0>();
+    }
+  } else {
+    if (force->newton_pair) eval_float<acc_t, 0, 0, 1>();
+    else eval_float<acc_t, 0, 0, 0>();
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class acc_t, int EVFLAG, int EFLAG, int NEWTON_PAIR> void PairLJCut::eval_float()
+{
+  int i, j, ii, jj, jnum, jtype;
+  float xtmp, ytmp, ztmp, delx, dely, delz, fpair;
+  float rsq, r2inv, r6inv, forcelj, factor_lj;
+  float evdwl = 0.0f;
+  acc_t fxtmp, fytmp, fztmp;
+  int *jlist;
+
+  const float *const xf = xfloat;
+  double **f = atom->f;
+  const int *const type = atom->type;
+  const int nlocal = atom->nlocal;
+  const int ntypes1 = atom->ntypes + 1;
+  float special_lj[4];
+  for (i = 0; i < 4; i++) special_lj[i] = force->special_lj[i];
+
+  const int inum = list->inum;
+  const int *const ilist = list->ilist;
+  const int *const numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  // loop over neighbors of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = xf[4 * i];
+    ytmp = xf[4 * i + 1];
+    ztmp = xf[4 * i + 2];
+    const float *const ci = &coeff_float[6 * ntypes1 * type[i]];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    fxtmp = fytmp = fztmp = 0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - xf[4 * j];
+      dely = ytmp - xf[4 * j + 1];
+      delz = ztmp - xf[4 * j + 2];
+      rsq = delx * delx + dely * dely + delz * delz;
+      jtype = type[j];
+      const float *const cij = &ci[6 * jtype];
+
+      if (rsq < cij[0]) {
+        r2inv = 1.0f / rsq;
+        r6inv = r2inv * r2inv * r2inv;
+        forcelj = r6inv * (cij[1] * r6inv - cij[2]);
+        fpair = factor_lj * forcelj * r2inv;
+
+        fxtmp += delx * fpair;
+        fytmp += dely * fpair;
+        fztmp += delz * fpair;
+        if (NEWTON_PAIR || j < nlocal) {
+          f[j][0] -= delx * fpair;
+          f[j][1] -= dely * fpair;
+          f[j][2] -= delz * fpair;
+        }
+
+        if (EFLAG) {
+          evdwl = r6inv * (cij[3] * r6inv - cij[4]) - cij[5];
+          evdwl *= factor_lj;
+        }
+
+        if (EVFLAG) ev_tally(i, j, nlocal, NEWTON_PAIR, evdwl, 0.0, fpair, delx, dely, delz);
+      }
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   same as compute() but loops over pairs of atom clusters
+   for each J atom of a cluster pair, the interactions with all I atoms
+     of the cluster are computed without branches and masked, so that
+     the compiler can vectorize the innermost loop
+   forces on I atoms are accumulated across all J clusters
+   coefficient arrays are symmetric, so rows of J types are used
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG> void PairLJCut::compute_cluster()
+{
+  constexpr int CS = NeighList::CLUSTERSIZE;
+  int a, b, ci, cj, k;
+  double evdwl = 0.0;
+
+  cluster_pack();
+
+  const int nlocal = atom->nlocal;
+  const int nicluster = list->nicluster;
+  const int *const clusteratom = list->clusteratom;
+  const int *const cfirst = list->cfirst;
+  const int *const cjlist = list->cjlist;
+  const unsigned int *const cjmask = list->cjmask;
+
+  for (ci = 0; ci < nicluster; ci++) {
+    const double *const xi = &xcluster[3 * CS * ci];
+    const int *const ti = &tcluster[CS * ci];
+    double fix[CS], fiy[CS], fiz[CS];
+    for (a = 0; a < CS; a++) fix[a] = fiy[a] = fiz[a] = 0.0;
+
+    for (k = cfirst[ci]; k < cfirst[ci + 1]; k++) {
+      cj = cjlist[k];
+      const unsigned int bits = cjmask[k];
+      const double *const xj = &xcluster[3 * CS * cj];
+      const int *const tj = &tcluster[CS * cj];
+      double *const fj = &fcluster[3 * CS * cj];
+
+      for (b = 0; b < CS; b++) {
+        const int jtype = tj[b];
+        const double xtmp = xj[b];
+        const double ytmp = xj[CS + b];
+        const double ztmp = xj[2 * CS + b];
+
+        // gather coeffs of the I atoms with J atom b, cutoff is 0 for masked pairs
+
+        double cutsqa[CS], lj1a[CS], lj2a[CS];
+        for (a = 0; a < CS; a++) {
+          cutsqa[a] = ((bits >> (a * CS + b)) & 1U) ? cutsq[jtype][ti[a]] : 0.0;
+          lj1a[a] = lj1[jtype][ti[a]];
+          lj2a[a] = lj2[jtype][ti[a]];
+        }
+
+        double fxtmp = 0.0, fytmp = 0.0, fztmp = 0.0;
+        double fpair[CS];
+
+        for (a = 0; a < CS; a++) {
+          const double delx = xi[a] - xtmp;
+          const double dely = xi[CS + a] - ytmp;
+          const double delz = xi[2 * CS + a] - ztmp;
+          const double rsq = delx * delx + dely * dely + delz * delz;
+          const double on = (rsq < cutsqa[a]) ? 1.0 : 0.0;
+          const double r2inv = on / (rsq + (1.0 - on));
+          const double r6inv = r2inv * r2inv * r2inv;
+          fpair[a] = r6inv * (lj1a[a] * r6inv - lj2a[a]) * r2inv;
+
+          fix[a] += delx * fpair[a];
+          fiy[a] += dely * fpair[a];
+          fiz[a] += delz * fpair[a];
+          fxtmp += delx * fpair[a];
+          fytmp += dely * fpair[a];
+          fztmp += delz * fpair[a];
+        }
+
+        if (EVFLAG) {
+          for (a = 0; a < CS; a++) {
+            if (cutsqa[a] == 0.0) continue;
+            const double delx = xi[a] - xtmp;
+            const double dely = xi[CS + a] - ytmp;
+            const double delz = xi[2 * CS + a] - ztmp;
+            const double rsq = delx * delx + dely * dely + delz * delz;
+            if (rsq >= cutsqa[a]) continue;
+            if (EFLAG) {
+              const double r2inv = 1.0 / rsq;
+              const double r6inv = r2inv * r2inv * r2inv;
+              evdwl = r6inv * (lj3[jtype][ti[a]] * r6inv - lj4[jtype][ti[a]]) -
+                  offset[jtype][ti[a]];
+            }
+            ev_tally(clusteratom[CS * ci + a], clusteratom[CS * cj + b], nlocal, 1, evdwl, 0.0,
+                     fpair[a], delx, dely, delz);
+          }
+        }
+
+        fj[b] -= fxtmp;
+        fj[CS + b] -= fytmp;
+        fj[2 * CS + b] -= fztmp;
+      }
+    }
+
+    double *const fi = &fcluster[3 * CS * ci];
+    for (a = 0; a < CS; a++) {
+      fi[a] += fix[a];
+      fi[CS + a] += fiy[a];
+      fi[2 * CS + a] += fiz[a];
+    }
+  }
+
+  cluster_unpack();
+}
+
 /* ---------------------------------------------------------------------- */
 
 void PairLJCut::compute_inner()
@@ -483,6 +816,11 @@ void PairLJCut::init_style()
     if (respa->level_inner >= 0) list_style = NeighConst::REQ_RESPA_INOUT;
     if (respa->level_middle >= 0) list_style = NeighConst::REQ_RESPA_ALL;
   }
+  if (cluster_flag) {
+    if (list_style != NeighConst::REQ_DEFAULT)
+      error->all(FLERR, "Pair_modify cluster cannot be used with rRESPA inner levels");
+    list_style = NeighConst::REQ_CLUSTER;
+  }
   neighbor->add_request(this, list_style);
 
   // set rRESPA cutoffs
@@ -492,6 +830,14 @@ void PairLJCut::init_style()
     cut_respa = (dynamic_cast<Respa *>(update->integrate))->cutoff;
   else
     cut_respa = nullptr;
+
+  // single precision copy of the per-type coefficients, filled by init_one()
+
+  memory->destroy(coeff_float);
+  if (precision != PREC_DOUBLE) {
+    const int n = atom->ntypes + 1;
+    memory->create(coeff_float, 6 * n * n, "pair:coeff_float");
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -523,6 +869,18 @@ double PairLJCut::init_one(int i, int j)
   lj4[j][i] = lj4[i][j];
   offset[j][i] = offset[i][j];
 
+  if (coeff_float) {
+    const int n = atom->ntypes + 1;
+    for (float *c : {&coeff_float[6 * (i * n + j)], &coeff_float[6 * (j * n + i)]}) {
+      c[0] = cut[i][j] * cut[i][j];
+      c[1] = lj1[i][j];
+      c[2] = lj2[i][j];
+      c[3] = lj3[i][j];
+      c[4] = lj4[i][j];
+      c[5] = offset[i][j];
+    }
+  }
+
   // check interior rRESPA cutoff
 
   if (cut_respa && cut[i][j] < cut_respa[3])
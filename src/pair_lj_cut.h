@@ -53,8 +53,13 @@ class PairLJCut : public Pair {
   double **epsilon, **sigma;
   double **lj1, **lj2, **lj3, **lj4, **offset;
   double *cut_respa;
+  float *coeff_float;    // cutsq,lj1-lj4,offset per type pair in single precision
 
   virtual void allocate();
+  void compute_soa(int, int);
+  template <int EVFLAG, int EFLAG> void compute_cluster();
+  template <class acc_t> void compute_float();
+  template <class acc_t, int EVFLAG, int EFLAG, int NEWTON_PAIR> void eval_float();
 };
 
 }    // namespace LAMMPS_NS
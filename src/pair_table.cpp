@@ -41,6 +41,7 @@ PairTable::PairTable(LAMMPS *lmp) : Pair(lmp)
 {
   ntables = 0;
   tables = nullptr;
+  precision_enable = 1;
   unit_convert_flag = utils::get_supported_conversions(utils::ENERGY);
 }
 
@@ -76,6 +77,13 @@ void PairTable::compute(int eflag, int vflag)
   evdwl = 0.0;
   ev_init(eflag, vflag);
 
+  if (precision != PREC_DOUBLE) {
+    if (precision == PREC_MIXED) compute_float<double>();
+    else compute_float<float>();
+    if (vflag_fdotr) virial_fdotr_compute();
+    return;
+  }
+
   double **x = atom->x;
   double **f = atom->f;
   int *type = atom->type;
@@ -178,6 +186,155 @@ void PairTable::compute(int eflag, int vflag)
   if (vflag_fdotr) virial_fdotr_compute();
 }
 
+/* ----------------------------------------------------------------------
+   same as compute() but with distances and interpolation in single precision
+   acc_t = float for single, double for mixed precision accumulation
+     of the forces on each atom i
+------------------------------------------------------------------------- */
+
+template <class acc_t> void PairTable::compute_float()
+{
+  xfloat_pack();
+
+  if (evflag) {
+    if (eflag_either) {
+      if (force->newton_pair) eval_float<acc_t, 1, 1, 1>();
+      else eval_float<acc_t, 1, 1, 0>();
+    } else {
+      if (force->newton_pair) eval_float<acc_t, 1, 0, 1>();
+      else eval_float<acc_t, 1, 0, 0>();
+    }
+  } else {
+    if (force->newton_pair) eval_float<acc_t, 0, 0, 1>();
+    else eval_float<acc_t, 0, 0, 0>();
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class acc_t, int EVFLAG, int EFLAG, int NEWTON_PAIR> void PairTable::eval_float()
+{
+  int i, j, ii, jj, jnum, itype, jtype;
+  float xtmp, ytmp, ztmp, delx, dely, delz, fpair;
+  float rsq, factor_lj, value;
+  int itable = 0;
+  float fraction = 0.0f, a = 0.0f, b = 0.0f;
+  float evdwl = 0.0f;
+  acc_t fxtmp, fytmp, fztmp;
+  int *jlist;
+  Table *tb;
+
+  union_int_float_t rsq_lookup;
+  const int tlm1 = tablength - 1;
+
+  const float *const xf = xfloat;
+  double **f = atom->f;
+  const int *const type = atom->type;
+  const int nlocal = atom->nlocal;
+  float special_lj[4];
+  for (i = 0; i < 4; i++) special_lj[i] = force->special_lj[i];
+
+  const int inum = list->inum;
+  const int *const ilist = list->ilist;
+  const int *const numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  // loop over neighbors of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = xf[4 * i];
+    ytmp = xf[4 * i + 1];
+    ztmp = xf[4 * i + 2];
+    itype = type[i];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    fxtmp = fytmp = fztmp = 0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - xf[4 * j];
+      dely = ytmp - xf[4 * j + 1];
+      delz = ztmp - xf[4 * j + 2];
+      rsq = delx * delx + dely * dely + delz * delz;
+      jtype = type[j];
+
+      if (rsq < (float) cutsq[itype][jtype]) {
+        tb = &tables[tabindex[itype][jtype]];
+        const float innersq = tb->innersq;
+        const float invdelta = tb->invdelta;
+        if (rsq < innersq)
+          error->one(FLERR, "Pair distance < table inner cutoff: ijtype {} {} dist {}", itype,
+                     jtype, sqrtf(rsq));
+        if (tabstyle == LOOKUP) {
+          itable = static_cast<int>((rsq - innersq) * invdelta);
+          if (itable >= tlm1)
+            error->one(FLERR, "Pair distance > table outer cutoff: ijtype {} {} dist {}", itype,
+                       jtype, sqrtf(rsq));
+          fpair = factor_lj * (float) tb->f[itable];
+        } else if (tabstyle == LINEAR) {
+          itable = static_cast<int>((rsq - innersq) * invdelta);
+          if (itable >= tlm1)
+            error->one(FLERR, "Pair distance > table outer cutoff: ijtype {} {} dist {}", itype,
+                       jtype, sqrtf(rsq));
+          fraction = (rsq - (float) tb->rsq[itable]) * invdelta;
+          value = (float) tb->f[itable] + fraction * (float) tb->df[itable];
+          fpair = factor_lj * value;
+        } else if (tabstyle == SPLINE) {
+          itable = static_cast<int>((rsq - innersq) * invdelta);
+          if (itable >= tlm1)
+            error->one(FLERR, "Pair distance > table outer cutoff: ijtype {} {} dist {}", itype,
+                       jtype, sqrtf(rsq));
+          b = (rsq - (float) tb->rsq[itable]) * invdelta;
+          a = 1.0f - b;
+          value = a * (float) tb->f[itable] + b * (float) tb->f[itable + 1] +
+              ((a * a * a - a) * (float) tb->f2[itable] +
+               (b * b * b - b) * (float) tb->f2[itable + 1]) *
+                  (float) tb->deltasq6;
+          fpair = factor_lj * value;
+        } else {
+          rsq_lookup.f = rsq;
+          itable = rsq_lookup.i & tb->nmask;
+          itable >>= tb->nshiftbits;
+          fraction = (rsq_lookup.f - (float) tb->rsq[itable]) * (float) tb->drsq[itable];
+          value = (float) tb->f[itable] + fraction * (float) tb->df[itable];
+          fpair = factor_lj * value;
+        }
+
+        fxtmp += delx * fpair;
+        fytmp += dely * fpair;
+        fztmp += delz * fpair;
+        if (NEWTON_PAIR || j < nlocal) {
+          f[j][0] -= delx * fpair;
+          f[j][1] -= dely * fpair;
+          f[j][2] -= delz * fpair;
+        }
+
+        if (EFLAG) {
+          if (tabstyle == LOOKUP)
+            evdwl = tb->e[itable];
+          else if (tabstyle == LINEAR || tabstyle == BITMAP)
+            evdwl = (float) tb->e[itable] + fraction * (float) tb->de[itable];
+          else
+            evdwl = a * (float) tb->e[itable] + b * (float) tb->e[itable + 1] +
+                ((a * a * a - a) * (float) tb->e2[itable] +
+                 (b * b * b - b) * (float) tb->e2[itable + 1]) *
+                    (float) tb->deltasq6;
+          evdwl *= factor_lj;
+        }
+
+        if (EVFLAG) ev_tally(i, j, nlocal, NEWTON_PAIR, evdwl, 0.0, fpair, delx, dely, delz);
+      }
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
+}
+
 /* ----------------------------------------------------------------------
    allocate all arrays
 ------------------------------------------------------------------------- */
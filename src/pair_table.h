@@ -59,6 +59,8 @@ class PairTable : public Pair {
   int **tabindex;
 
   virtual void allocate();
+  template <class acc_t> void compute_float();
+  template <class acc_t, int EVFLAG, int EFLAG, int NEWTON_PAIR> void eval_float();
   void read_table(Table *, char *, char *);
   void param_extract(Table *, char *);
   void bcast_table(Table *);
@@ -0,0 +1,346 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "profiler.h"
+
+#include "comm.h"
+#include "compute.h"
+#include "error.h"
+#include "fix.h"
+
+#include <cstring>
+#include <map>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/perf_event.h>)
+#define LMP_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+using namespace LAMMPS_NS;
+
+static const char *category_name[] = {"Fix", "Compute", "Pair", "Comm", "NPair"};
+
+static constexpr double BIG = 1.0e20;
+
+/* ----------------------------------------------------------------------
+   counters = 1 to also measure CPU cycles and instructions with perf_event
+   the counters only count in the calling thread, not in OpenMP threads
+------------------------------------------------------------------------- */
+
+Profiler::Profiler(LAMMPS *lmp, int counters) : Pointers(lmp)
+{
+  for (int &fd : perf_fd) fd = -1;
+  if (!counters) return;
+
+  int flag = 0;
+
+#ifdef LMP_PERF_EVENT
+  const uint64_t config[NUM_COUNTER] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS};
+  flag = 1;
+  for (int k = 0; k < NUM_COUNTER; k++) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config[k];
+    attr.disabled = (k == 0) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    perf_fd[k] = syscall(__NR_perf_event_open, &attr, 0, -1, perf_fd[0], 0);
+    if (perf_fd[k] < 0) flag = 0;
+  }
+#endif
+
+  // use counters only if they are available on all procs
+
+  int flagall;
+  MPI_Allreduce(&flag, &flagall, 1, MPI_INT, MPI_MIN, world);
+
+  if (!flagall) {
+#ifdef LMP_PERF_EVENT
+    for (int &fd : perf_fd)
+      if (fd >= 0) close(fd);
+#endif
+    for (int &fd : perf_fd) fd = -1;
+    if (comm->me == 0)
+      error->warning(FLERR, "Hardware counters are not available, profiling only wall time");
+    return;
+  }
+
+#ifdef LMP_PERF_EVENT
+  ioctl(perf_fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(perf_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+Profiler::~Profiler()
+{
+#ifdef LMP_PERF_EVENT
+  for (int &fd : perf_fd)
+    if (fd >= 0) close(fd);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   return index of slot for a section of an instance ptr
+   the label is only created the first time the section is timed
+   sections of different instances with the same label share a slot
+------------------------------------------------------------------------- */
+
+int Profiler::slot(int category, const void *ptr, const char *name, int sub, const char *style)
+{
+  Key key = {ptr, name, category, sub};
+  auto it = index.find(key);
+  if (it != index.end()) return it->second;
+
+  std::string label = (sub < 0) ? name : fmt::format("{}[{}]", name, sub);
+  int islot = -1;
+  for (std::size_t i = 0; i < slots.size(); i++)
+    if ((slots[i].category == category) && (slots[i].name == label)) islot = i;
+
+  if (islot < 0) {
+    islot = slots.size();
+    slots.push_back({category, label, style ? style : "", 0, 0, 0.0, {0}});
+  }
+  index[key] = islot;
+  return islot;
+}
+
+/* ----------------------------------------------------------------------
+   all methods of a fix or compute instance share one slot
+------------------------------------------------------------------------- */
+
+int Profiler::slot(Fix *fix)
+{
+  return slot(FIX, fix, fix->id, -1, fix->style);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int Profiler::slot(Compute *compute)
+{
+  return slot(COMPUTE, compute, compute->id, -1, compute->style);
+}
+
+/* ----------------------------------------------------------------------
+   current wall time and counter values
+------------------------------------------------------------------------- */
+
+void Profiler::read(double &wall, uint64_t *counter)
+{
+  wall = platform::walltime();
+  for (int k = 0; k < NUM_COUNTER; k++) counter[k] = 0;
+
+#ifdef LMP_PERF_EVENT
+  if (perf_fd[0] >= 0) {
+    uint64_t buf[1 + NUM_COUNTER];
+    if (::read(perf_fd[0], buf, sizeof(buf)) == (ssize_t) sizeof(buf))
+      for (int k = 0; k < NUM_COUNTER; k++) counter[k] = buf[1 + k];
+  }
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Profiler::add(int islot, double wall, const uint64_t *c0, const uint64_t *c1, bigint nitem)
+{
+  Slot &s = slots[islot];
+  s.ncall++;
+  s.nitem += nitem;
+  s.wall += wall;
+  for (int k = 0; k < NUM_COUNTER; k++) s.counter[k] += c1[k] - c0[k];
+}
+
+/* ----------------------------------------------------------------------
+   clear all data, called at the start of a run
+------------------------------------------------------------------------- */
+
+void Profiler::reset()
+{
+  index.clear();
+  slots.clear();
+}
+
+/* ----------------------------------------------------------------------
+   combine slots of all procs by category and label
+   procs need not have the same slots, e.g. a proc without neighbors
+   in one direction, so the union of all labels is reduced
+   returns the statistics on proc 0, an empty vector on other procs
+------------------------------------------------------------------------- */
+
+std::vector<Profiler::Stats> Profiler::gather()
+{
+  int me = comm->me;
+  int nprocs = comm->nprocs;
+
+  // gather labels of all procs on proc 0, in order of first appearance
+
+  std::string mine;
+  for (const auto &s : slots) mine += fmt::format("{}\t{}\t{}\n", s.category, s.name, s.style);
+  int n = mine.size();
+
+  std::vector<int> recvcounts(nprocs), displs(nprocs);
+  MPI_Gather(&n, 1, MPI_INT, recvcounts.data(), 1, MPI_INT, 0, world);
+  int ntotal = 0;
+  for (int iproc = 0; iproc < nprocs; iproc++) {
+    displs[iproc] = ntotal;
+    ntotal += recvcounts[iproc];
+  }
+  std::vector<char> all(ntotal + 1);
+  MPI_Gatherv((char *) mine.data(), n, MPI_CHAR, all.data(), recvcounts.data(), displs.data(),
+              MPI_CHAR, 0, world);
+
+  std::string labels;
+  if (me == 0) {
+    std::map<std::string, int> seen;
+    std::vector<std::string> sorted[NUM_CATEGORY];
+    for (const auto &line : utils::split_lines(std::string(all.data(), ntotal))) {
+      if (line.empty() || seen.count(line)) continue;
+      seen[line] = 1;
+      sorted[std::stoi(line.substr(0, line.find('\t')))].push_back(line);
+    }
+    for (const auto &lines : sorted)
+      for (const auto &line : lines) labels += line + "\n";
+  }
+
+  n = labels.size();
+  MPI_Bcast(&n, 1, MPI_INT, 0, world);
+  labels.resize(n);
+  MPI_Bcast(&labels[0], n, MPI_CHAR, 0, world);
+
+  // reduce data of all procs in the order of the labels
+
+  std::vector<Stats> stats;
+  for (const auto &line : utils::split_lines(labels)) {
+    if (line.empty()) continue;
+    auto tab1 = line.find('\t');
+    auto tab2 = line.find('\t', tab1 + 1);
+    Stats st;
+    st.category = std::stoi(line.substr(0, tab1));
+    st.name = line.substr(tab1 + 1, tab2 - tab1 - 1);
+    st.style = line.substr(tab2 + 1);
+    stats.push_back(st);
+  }
+
+  int nstats = stats.size();
+  int nvalue = 4 + NUM_COUNTER;
+  std::vector<double> value(nvalue * nstats, 0.0), sum(nvalue * nstats);
+
+  // procs without a slot for a label are excluded from its min and avg time and calls
+
+  std::vector<double> wlo(nstats, BIG), whi(nstats, 0.0), wmin(nstats), wmax(nstats);
+  for (int i = 0; i < nstats; i++) {
+    for (const auto &s : slots) {
+      if ((s.category != stats[i].category) || (s.name != stats[i].name)) continue;
+      value[nvalue * i] = s.ncall;
+      value[nvalue * i + 1] = s.nitem;
+      value[nvalue * i + 2] = s.wall;
+      value[nvalue * i + 3] = 1.0;
+      for (int k = 0; k < NUM_COUNTER; k++) value[nvalue * i + 4 + k] = s.counter[k];
+      wlo[i] = whi[i] = s.wall;
+    }
+  }
+
+  MPI_Reduce(value.data(), sum.data(), nvalue * nstats, MPI_DOUBLE, MPI_SUM, 0, world);
+  MPI_Reduce(wlo.data(), wmin.data(), nstats, MPI_DOUBLE, MPI_MIN, 0, world);
+  MPI_Reduce(whi.data(), wmax.data(), nstats, MPI_DOUBLE, MPI_MAX, 0, world);
+
+  if (me != 0) return {};
+
+  for (int i = 0; i < nstats; i++) {
+    Stats &st = stats[i];
+    double nhave = MAX(sum[nvalue * i + 3], 1.0);
+    st.ncall = sum[nvalue * i] / nhave;
+    st.nitem = sum[nvalue * i + 1];
+    st.tavg = sum[nvalue * i + 2] / nhave;
+    st.tmin = wmin[i];
+    st.tmax = wmax[i];
+    for (int k = 0; k < NUM_COUNTER; k++) st.counter[k] = sum[nvalue * i + 4 + k];
+  }
+  return stats;
+}
+
+/* ----------------------------------------------------------------------
+   print table of all profiled sections, time_loop = avg time of run loop
+   calls and times are averaged over procs that ran the section,
+   items and counters are summed over procs
+------------------------------------------------------------------------- */
+
+void Profiler::report(double time_loop)
+{
+  auto stats = gather();
+  if (comm->me != 0) return;
+
+  std::string mesg = "\nProfile of fixes, computes, pair sub-styles, comm swaps, and neighbor "
+                     "list builds:\nSection | Name                         | Style            "
+                     "|   Calls  |  min time  |  avg time  |  max time  | %total |   Items";
+  if (has_counters()) mesg += "   |  Gcycles  |  IPC";
+  mesg += "\n" + std::string(has_counters() ? 151 : 129, '-') + "\n";
+
+  for (const auto &st : stats) {
+    mesg += fmt::format("{:<7s} | {:<28s} | {:<16s} | {:>8.4g} | {:<10.4g} | {:<10.4g} | {:<10.4g} "
+                        "| {:6.2f} |",
+                        category_name[st.category], st.name, st.style, st.ncall, st.tmin, st.tavg,
+                        st.tmax, (time_loop > 0.0) ? st.tavg / time_loop * 100.0 : 0.0);
+    if (st.nitem > 0.0) mesg += fmt::format(" {:>9.4g}", st.nitem);
+    else if (has_counters()) mesg += std::string(10, ' ');
+    if (has_counters())
+      mesg += fmt::format(" | {:>9.4g} | {:5.2f}", st.counter[CYCLES] * 1.0e-9,
+                          (st.counter[CYCLES] > 0.0)
+                              ? st.counter[INSTRUCTIONS] / st.counter[CYCLES]
+                              : 0.0);
+    mesg += "\n";
+  }
+  utils::logmesg(lmp, mesg);
+}
+
+/* ----------------------------------------------------------------------
+   write all profiled sections as JSON to file
+------------------------------------------------------------------------- */
+
+void Profiler::write_json(const std::string &file, double time_loop)
+{
+  auto stats = gather();
+  if (comm->me != 0) return;
+
+  FILE *fp = fopen(file.c_str(), "w");
+  if (!fp) {
+    error->warning(FLERR, "Cannot open profile file {}: {}", file, utils::getsyserror());
+    return;
+  }
+
+  fmt::print(fp, "{{\n  \"nprocs\": {},\n  \"loop_time\": {},\n  \"counters\": {},\n"
+                 "  \"sections\": [\n", comm->nprocs, time_loop, has_counters() ? "true" : "false");
+  for (std::size_t i = 0; i < stats.size(); i++) {
+    const Stats &st = stats[i];
+    fmt::print(fp,
+               "    {{\"category\": \"{}\", \"name\": \"{}\", \"style\": \"{}\", \"calls\": {}, "
+               "\"items\": {}, \"time_min\": {}, \"time_avg\": {}, \"time_max\": {}",
+               category_name[st.category], st.name, st.style, st.ncall, st.nitem, st.tmin, st.tavg,
+               st.tmax);
+    if (has_counters())
+      fmt::print(fp, ", \"cycles\": {}, \"instructions\": {}", st.counter[CYCLES],
+                 st.counter[INSTRUCTIONS]);
+    fmt::print(fp, "}}{}\n", (i + 1 < stats.size()) ? "," : "");
+  }
+  fputs("  ]\n}\n", fp);
+  fclose(fp);
+}
@@ -0,0 +1,147 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_PROFILER_H
+#define LMP_PROFILER_H
+
+#include "pointers.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class Profiler : protected Pointers {
+ public:
+  enum { FIX = 0, COMPUTE, PAIR, COMM, NPAIR, NUM_CATEGORY };
+  enum { CYCLES = 0, INSTRUCTIONS, NUM_COUNTER };
+
+  Profiler(class LAMMPS *, int);
+  ~Profiler() override;
+
+  int has_counters() const { return (perf_fd[0] >= 0); }
+
+  int slot(int, const void *, const char *, int, const char *);
+  int slot(class Fix *);
+  int slot(class Compute *);
+  void read(double &, uint64_t *);
+  void add(int, double, const uint64_t *, const uint64_t *, bigint);
+
+  void reset();
+  void report(double);
+  void write_json(const std::string &, double);
+
+  std::string json_file;    // write results to this file after a run, if not empty
+
+ private:
+  struct Key {
+    const void *ptr;     // instance that is timed
+    const char *name;    // name as passed by the caller, must stay valid
+    int category;
+    int sub;             // index within the instance, e.g. swap, or -1
+    bool operator==(const Key &k) const
+    {
+      return (ptr == k.ptr) && (name == k.name) && (category == k.category) && (sub == k.sub);
+    }
+  };
+  struct KeyHash {
+    size_t operator()(const Key &k) const
+    {
+      size_t h = std::hash<const void *>()(k.ptr);
+      h ^= std::hash<const void *>()(k.name) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      h ^= std::hash<int>()(k.category * 65536 + k.sub) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+  struct Slot {
+    int category;
+    std::string name;    // label in the report, unique within category
+    std::string style;
+    bigint ncall;
+    bigint nitem;    // # of items processed, e.g. neighbor pairs built
+    double wall;
+    uint64_t counter[NUM_COUNTER];
+  };
+
+  std::unordered_map<Key, int, KeyHash> index;
+  std::vector<Slot> slots;
+  int perf_fd[NUM_COUNTER];    // perf_event file descriptors, -1 if not used
+
+  struct Stats {
+    int category;
+    std::string name, style;
+    double ncall, nitem, tmin, tavg, tmax;
+    double counter[NUM_COUNTER];
+  };
+  std::vector<Stats> gather();
+};
+
+/* ----------------------------------------------------------------------
+   time a section from construction to destruction of this object,
+   or to an earlier call of stop(), so that items can be counted untimed
+   does nothing if the profiler pointer is null
+------------------------------------------------------------------------- */
+
+class ProfileScope {
+ public:
+  ProfileScope(Profiler *_p, int category, const void *ptr, const char *name, int sub = -1,
+               const char *style = nullptr) :
+      p(_p), nitem(0), stopped(false)
+  {
+    if (p) start(p->slot(category, ptr, name, sub, style));
+  }
+  ProfileScope(Profiler *_p, class Fix *fix) : p(_p), nitem(0), stopped(false)
+  {
+    if (p) start(p->slot(fix));
+  }
+  ProfileScope(Profiler *_p, class Compute *compute) : p(_p), nitem(0), stopped(false)
+  {
+    if (p) start(p->slot(compute));
+  }
+  ~ProfileScope()
+  {
+    if (p) {
+      stop();
+      p->add(islot, t1 - t0, c0, c1, nitem);
+    }
+  }
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+  bool active() const { return p != nullptr; }
+  void items(bigint n) { nitem += n; }
+  void stop()
+  {
+    if (p && !stopped) p->read(t1, c1);
+    stopped = true;
+  }
+
+ private:
+  void start(int i)
+  {
+    islot = i;
+    p->read(t0, c0);
+  }
+
+  Profiler *p;
+  int islot;
+  double t0, t1;
+  uint64_t c0[Profiler::NUM_COUNTER], c1[Profiler::NUM_COUNTER];
+  bigint nitem;
+  bool stopped;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
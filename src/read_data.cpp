@@ -43,12 +43,14 @@
 #include <cstring>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
 static constexpr int MAXLINE = 256;
 static constexpr double LB_FACTOR = 1.1;
 static constexpr int CHUNK = 1024;
+static constexpr bigint BLOCK = 4194304;    // default bytes per proc and round of parallel reads
 static constexpr int DELTA = 4;       // must be 2 or larger
 static constexpr int MAXBODY = 32;    // max # of lines in one body
 
@@ -146,7 +148,8 @@ void ReadData::command(int narg, char **arg)
   addflag = NONE;
   coeffflag = 1;
   id_offset = mol_offset = 0;
-  offsetflag = shiftflag = settypeflag = 0;
+  offsetflag = shiftflag = settypeflag = parallelflag = 0;
+  blocksize = BLOCK;
   tlabelflag = blabelflag = alabelflag = dlabelflag = ilabelflag = 0;
   toffset = boffset = aoffset = doffset = ioffset = 0;
   shift[0] = shift[1] = shift[2] = 0.0;
@@ -209,6 +212,16 @@ void ReadData::command(int narg, char **arg)
     } else if (strcmp(arg[iarg], "nocoeff") == 0) {
       coeffflag = 0;
       iarg++;
+    } else if (strcmp(arg[iarg], "parallel") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data parallel", error);
+      parallelflag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "parallel/block") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data parallel/block", error);
+      blocksize = utils::bnumeric(FLERR, arg[iarg + 1], false, lmp);
+      if (blocksize <= 0)
+        error->all(FLERR, "Illegal read_data parallel/block value {}", blocksize);
+      iarg += 2;
     } else if (strcmp(arg[iarg], "extra/atom/types") == 0) {
       if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data extra/atom/types", error);
       extra_atom_types = utils::inumeric(FLERR, arg[iarg + 1], false, lmp);
@@ -505,6 +518,9 @@ void ReadData::command(int narg, char **arg)
   nlocal_previous = atom->nlocal;
   int firstpass = 1;
 
+  filename = arg[0];
+  atomsend = -1;
+
   while (true) {
 
     // open file on proc 0
@@ -706,6 +722,8 @@ void ReadData::command(int narg, char **arg)
                 FLERR, "Atom style in data file {} differs from currently defined atom style {}",
                 style, atom->atom_style);
           atoms();
+        } else if (atomsend >= 0) {
+          if (me == 0) platform::fseek(fp, atomsend);
         } else
           skip_lines(natoms);
 
@@ -1521,15 +1539,19 @@ void ReadData::atoms()
 
   bigint nread = 0;
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
-    if (tlabelflag && !lmap->is_complete(Atom::ATOM))
-      error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
-    atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset,
-                     shiftflag, shift, tlabelflag, lmap->lmap2lmap.atom, triclinic_general);
-    nread += nchunk;
+  if (parallelflag && comm->nprocs > 1) atoms_parallel();
+  else {
+    while (nread < natoms) {
+      nchunk = MIN(natoms - nread, CHUNK);
+      eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
+      if (eof) error->all(FLERR, "Unexpected end of data file");
+      if (tlabelflag && !lmap->is_complete(Atom::ATOM))
+        error->all(FLERR,
+                   "Label map is incomplete: all types must be assigned a unique type label");
+      atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset,
+                       shiftflag, shift, tlabelflag, lmap->lmap2lmap.atom, triclinic_general);
+      nread += nchunk;
+    }
   }
 
   // warn if we have read data with non-zero image flags for non-periodic boundaries.
@@ -1578,6 +1600,145 @@ void ReadData::atoms()
   }
 }
 
+/* ----------------------------------------------------------------------
+   read Atoms section with all procs reading disjoint blocks of the file
+   blocks of blocksize bytes are assigned round-robin to procs
+   a line belongs to the block containing its first char and its
+     index within the section is the # of newlines preceding it
+   each proc parses its own lines, then atoms migrate to owning procs
+   proc 0 is left positioned after the section, as with a serial read
+------------------------------------------------------------------------- */
+
+void ReadData::atoms_parallel()
+{
+  int nprocs = comm->nprocs;
+
+  // the section starts at the current position of proc 0
+  // must be a regular file, so all procs can seek in it
+
+  bigint start = -1;
+  if (me == 0 && !compressed) start = platform::ftell(fp);
+  MPI_Bcast(&start, 1, MPI_LMP_BIGINT, 0, world);
+  if (start < 0) error->all(FLERR, "Read_data parallel requires an uncompressed data file");
+
+  if (tlabelflag && natoms && !lmap->is_complete(Atom::ATOM))
+    error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
+
+  FILE *fpblock = fp;
+  if (me) {
+    fpblock = fopen(filename.c_str(), "rb");
+    if (!fpblock) error->one(FLERR, "Cannot open file {}: {}", filename, utils::getsyserror());
+  }
+  platform::fseek(fpblock, platform::END_OF_FILE);
+  bigint filesize = platform::ftell(fpblock);
+
+  std::vector<char> block(blocksize + 1);
+  std::string mylines;
+  bigint nmine = 0;
+  bigint nlines = 0;
+  bigint end = start;
+
+  for (bigint round = 0; nlines < natoms; round++) {
+
+    // read my block plus the preceding char to see if the block starts a line
+
+    bigint lo = start + (round * nprocs + me) * blocksize;
+    bigint hi = MIN(lo + blocksize, filesize);
+    bigint nbytes = MAX(hi - lo, 0);
+    char *data = block.data() + 1;
+    block[0] = '\n';
+
+    if (nbytes) {
+      bigint from = (lo > start) ? lo - 1 : lo;
+      platform::fseek(fpblock, from);
+      if (fread(block.data() + 1 - (lo - from), 1, hi - from, fpblock) != (size_t) (hi - from))
+        error->one(FLERR, "Unexpected end of data file");
+    }
+
+    bigint count = 0;
+    for (bigint i = 0; i < nbytes; i++)
+      if (data[i] == '\n') count++;
+
+    bigint before, total;
+    MPI_Scan(&count, &before, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+    before -= count;
+    MPI_Allreduce(&count, &total, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+
+    // collect lines starting in my block with index < natoms
+    // the last one may continue past the end of the block
+
+    bigint index = nlines + before;
+    for (bigint i = 0; i < nbytes && index < natoms; i++) {
+      if (data[i - 1] == '\n') {
+        bigint j = i;
+        while (j < nbytes && data[j] != '\n') j++;
+        mylines.append(data + i, j - i);
+        if (j == nbytes) {
+          int c;
+          while (((c = fgetc(fpblock)) != EOF) && (c != '\n')) mylines += (char) c;
+        }
+        mylines += '\n';
+        nmine++;
+      }
+      if (data[i] == '\n') {
+        if (index == natoms - 1) end = lo + i + 1;
+        index++;
+      }
+    }
+
+    nlines += total;
+
+    // end of file reached by all blocks of this round
+    // accept a last line without trailing newline
+
+    if ((nlines < natoms) && (start + (round + 1) * nprocs * blocksize >= filesize)) {
+      char last = '\n';
+      if (filesize > start) {
+        platform::fseek(fpblock, filesize - 1);
+        last = fgetc(fpblock);
+      }
+      if ((nlines == natoms - 1) && (last != '\n')) {
+        end = filesize;
+        nlines++;
+      } else
+        error->all(FLERR, "Unexpected end of data file");
+    }
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, &end, 1, MPI_LMP_BIGINT, MPI_MAX, world);
+  atomsend = end;
+  if (me == 0) platform::fseek(fp, end);
+  else fclose(fpblock);
+
+  // parse my lines in chunks, keep atoms inside the global box
+
+  char *ptr = &mylines[0];
+  for (bigint nread = 0; nread < nmine;) {
+    int nchunk = MIN(nmine - nread, CHUNK);
+    char *next = ptr;
+    for (int i = 0; i < nchunk; i++) next = strchr(next, '\n') + 1;
+    atom->data_atoms(nchunk, ptr, id_offset, mol_offset, toffset, shiftflag, shift, tlabelflag,
+                     lmap->lmap2lmap.atom, triclinic_general, 1);
+    ptr = next;
+    nread += nchunk;
+  }
+
+  // move atoms to the procs owning their sub-domains
+  // coords were already remapped into the periodic box by data_atoms()
+  // migration updates the atom map, so it must be valid beforehand
+
+  if (atom->map_style != Atom::MAP_NONE) {
+    atom->map_init();
+    atom->map_set();
+  }
+
+  if (domain->triclinic) domain->x2lamda(atom->nlocal);
+  auto irregular = new Irregular(lmp);
+  irregular->migrate_atoms(1);
+  delete irregular;
+  if (domain->triclinic) domain->lamda2x(atom->nlocal);
+}
+
 /* ----------------------------------------------------------------------
    read all velocities
    to find atoms, must build atom map if not a molecular system
@@ -72,7 +72,7 @@ class ReadData : public Command {
 
   // optional args
 
-  int addflag, offsetflag, shiftflag, coeffflag, settypeflag;
+  int addflag, offsetflag, shiftflag, coeffflag, settypeflag, parallelflag;
   int tlabelflag, blabelflag, alabelflag, dlabelflag, ilabelflag;
   tagint addvalue;
   int toffset, boffset, aoffset, doffset, ioffset;
@@ -81,6 +81,10 @@ class ReadData : public Command {
   int extra_dihedral_types, extra_improper_types;
   int groupbit;
 
+  std::string filename;    // data file name, opened by all procs with parallel
+  bigint blocksize;        // bytes per proc and round with parallel
+  bigint atomsend;         // file offset after Atoms section, -1 if unknown
+
   int nfix;
   Fix **fix_index;
   char **fix_header;
@@ -98,6 +102,7 @@ class ReadData : public Command {
   int style_match(const char *, const char *);
 
   void atoms();
+  void atoms_parallel();
   void velocities();
 
   void bonds(int);
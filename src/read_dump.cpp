@@ -241,7 +241,22 @@ void ReadDump::setup_reader(int narg, char **arg)
       filereader = 1;
   }
 
+  // with mmap, every proc maps the file and reads its own slice of atoms
+
+  if (mmapflag) {
+    if (!readers[0]->mmap_allow)
+      error->all(FLERR,"Read_dump format {} does not support mmap", readerstyle);
+    readers[0]->mmap_flag = 1;
+    parallel = 1;
+    filereader = 1;
+  }
+
   // pass any arguments to readers
+  // mmap after format would be handed to the reader, so flag it here
+
+  for (int i = 0; i < narg; i++)
+    if (strcmp(arg[i],"mmap") == 0)
+      error->all(FLERR,"Read_dump mmap keyword must be used before format keyword");
 
   if (narg > 0 && filereader)
     for (int i = 0; i < nreader; i++)
@@ -275,6 +290,10 @@ bigint ReadDump::seek(bigint nrequest, int exact)
         readers[0]->open_file(multiname);
       } else readers[0]->open_file(files[ifile]);
 
+      // readers with a snapshot index can jump close to the requested timestep
+
+      readers[0]->seek_time(nrequest);
+
       while (true) {
         eofflag = readers[0]->read_time(ntimestep);
         if (eofflag) break;
@@ -317,6 +336,7 @@ bigint ReadDump::seek(bigint nrequest, int exact)
       std::string multiname = files[currentfile];
       multiname.replace(multiname.find('%'),1,fmt::format("{}",firstfile+i));
       readers[i]->open_file(multiname);
+      readers[i]->seek_time(ntimestep);
 
       bigint step;
       while (true) {
@@ -367,6 +387,10 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
         } else readers[0]->open_file(files[ifile]);
       }
 
+      // snapshots with timestep <= ncurrent are skipped without being counted
+
+      readers[0]->seek_time(ncurrent+1);
+
       while (true) {
         eofflag = readers[0]->read_time(ntimestep);
         if (eofflag) break;
@@ -418,6 +442,7 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
       std::string multiname = files[currentfile];
       multiname.replace(multiname.find('%'),1,fmt::format("{}",firstfile+i));
       readers[i]->open_file(multiname);
+      readers[i]->seek_time(ntimestep);
 
       bigint step;
       while (true) {
@@ -1196,6 +1221,7 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
   for (int i = 0; i < nfield; i++) fieldlabel[i] = nullptr;
   scaleflag = 0;
   wrapflag = 1;
+  mmapflag = 0;
 
   while (iarg < narg) {
     if (strcmp(arg[iarg],"nfile") == 0) {
@@ -1248,6 +1274,10 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "read_dump wrapped", error);
       wrapflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"mmap") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "read_dump mmap", error);
+      mmapflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"format") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "read_dump format", error);
       delete[] readerstyle;
@@ -1261,6 +1291,8 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
     error->all(FLERR,"Dump file is not a multi-proc file");
   if (multiproc && multiproc_nfile == 0)
     error->all(FLERR,"Dump file is a multi-proc file");
+  if (multiproc && mmapflag)
+    error->all(FLERR,"Read_dump mmap cannot be used with multi-proc files");
 
   if (purgeflag && (replaceflag || trimflag))
     error->all(FLERR,"If read_dump purges it cannot replace or trim");
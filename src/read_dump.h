@@ -57,6 +57,7 @@ class ReadDump : public Command {
                      //   (0 to multiproc_nfile-1)
   int filereader;    // 1 if this proc reads from a dump file(s)
   int parallel;      // 1 if parallel reading (e.g. via ADIOS2)
+  int mmapflag;      // 1 if every proc maps the dump file and reads a slice of it
 
   int boxflag;                 // overwrite simulation box with dump file box params
   int timestepflag;            // overwrite simulation timestep with dump file timestep
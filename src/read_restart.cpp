@@ -32,6 +32,8 @@
 #include "memory.h"
 #include "modify.h"
 #include "pair.h"
+#include "restart_delta.h"
+#include "restart_mpiio.h"
 #include "special.h"
 #include "update.h"
 
@@ -155,12 +157,20 @@ void ReadRestart::command(int narg, char **arg)
   memory->create(atom->extra,n,nextra,"atom:extra");
 
   // read file layout info
+  // for MPI-IO files, per-proc data starts right after it
 
+  mpiioflag = deltaflag = 0;
   file_layout();
 
-  // close header file if in multiproc mode
+  bigint dataoffset = 0;
+  if (mpiioflag) {
+    if (me == 0) dataoffset = platform::ftell(fp);
+    MPI_Bcast(&dataoffset,1,MPI_LMP_BIGINT,0,world);
+  }
+
+  // close header file if in multiproc or MPI-IO mode
 
-  if (multiproc && me == 0) {
+  if ((multiproc || mpiioflag) && me == 0) {
     fclose(fp);
     fp = nullptr;
   }
@@ -173,6 +183,110 @@ void ReadRestart::command(int narg, char **arg)
   double *buf = nullptr;
   int m,flag;
 
+  // input of single MPI-IO file
+  // nprocs_file = # of chunks in file, their sizes are in the header
+  // each proc reads a contiguous range of chunks via collective reads
+  //   one chunk per round, # of rounds = max # of chunks for any proc
+  // each proc keeps all atoms in its chunks
+
+  if (mpiioflag) {
+
+    int ifirst = static_cast<int> ((bigint) me * nprocs_file/nprocs);
+    int ilast = static_cast<int> ((bigint) (me+1) * nprocs_file/nprocs);
+    int nround = (nprocs_file + nprocs - 1) / nprocs;
+
+    bigint offset = dataoffset;
+    for (int i = 0; i < ifirst; i++) offset += (bigint) procsizes[i] * sizeof(double);
+
+    auto mpiio = new RestartMPIIO(lmp);
+    mpiio->open_read(file);
+
+    for (int iround = 0; iround < nround; iround++) {
+      n = 0;
+      if (ifirst + iround < ilast) n = procsizes[ifirst+iround];
+      if (n > maxbuf) {
+        maxbuf = n;
+        memory->destroy(buf);
+        memory->create(buf,maxbuf,"read_restart:buf");
+      }
+      mpiio->read(offset,n,buf);
+      offset += (bigint) n * sizeof(double);
+
+      m = 0;
+      while (m < n) m += avec->unpack_restart(&buf[m]);
+    }
+
+    delete mpiio;
+  }
+
+  // input of delta file
+  // proc 0 reads atom data of its base file in chunks and bcasts them,
+  //   each proc keeps the atoms with ID % nprocs = me as reference
+  // proc 0 then reads chunks of the delta file and bcasts them,
+  //   each proc reconstructs the atoms with ID % nprocs = me
+  // atoms are migrated to the procs owning them below
+
+  else if (deltaflag) {
+
+    auto delta = new RestartDelta(lmp);
+    FILE *fpdelta = fp;
+    if (me == 0) {
+      fp = fopen(basefile.c_str(),"rb");
+      if (fp == nullptr)
+        error->one(FLERR,"Cannot open restart base file {}: {}", basefile, utils::getsyserror());
+      platform::fseek(fp,baseoffset);
+    }
+
+    bigint nbase = 0;
+    while (nbase < basesize) {
+      if (read_int() != PERPROC)
+        error->all(FLERR,"Invalid flag in peratom section of restart base file {}", basefile);
+      n = read_int();
+      if (n > maxbuf) {
+        maxbuf = n;
+        memory->destroy(buf);
+        memory->create(buf,maxbuf,"read_restart:buf");
+      }
+      read_double_vec(n,buf);
+      delta->add_reference(n,buf,nprocs,me);
+      nbase += n;
+    }
+    if (nbase != basesize)
+      error->all(FLERR,"Restart base file {} does not match delta restart file", basefile);
+
+    if (me == 0) fclose(fp);
+    fp = fpdelta;
+
+    std::vector<double> records;
+    for (int iproc = 0; iproc < nprocs_file; iproc++) {
+      if (read_int() != PERPROC)
+        error->all(FLERR,"Invalid flag in peratom section of restart file");
+
+      n = read_int();
+      if (n > maxbuf) {
+        maxbuf = n;
+        memory->destroy(buf);
+        memory->create(buf,maxbuf,"read_restart:buf");
+      }
+      read_double_vec(n,buf);
+
+      bigint nbytes = ubuf(buf[0]).i;
+      if ((n < 1) || (nbytes < 0) || (nbytes > (bigint) (n-1) * (bigint) sizeof(double)))
+        error->all(FLERR,"Delta restart file is corrupted");
+      records.clear();
+      delta->decode((char *) &buf[1],nbytes,quantum,nprocs,me,records);
+
+      m = 0;
+      while (m < (int) records.size()) m += avec->unpack_restart(&records[m]);
+    }
+
+    delete delta;
+    if (me == 0) {
+      fclose(fp);
+      fp = nullptr;
+    }
+  }
+
   // input of single native file
   // nprocs_file = # of chunks in file
   // proc 0 reads a chunk and bcasts it to other procs
@@ -180,7 +294,7 @@ void ReadRestart::command(int narg, char **arg)
   // if remapflag set, remap the atom to box before checking sub-domain
   // check for atom in sub-domain differs for orthogonal vs triclinic box
 
-  if (multiproc == 0) {
+  else if (multiproc == 0) {
 
     int triclinic = domain->triclinic;
     imageint *iptr;
@@ -379,7 +493,7 @@ void ReadRestart::command(int narg, char **arg)
   // for multiproc or MPI-IO files:
   // perform irregular comm to migrate atoms to correct procs
 
-  if (multiproc) {
+  if (multiproc || mpiioflag || deltaflag) {
 
     // if remapflag set, remap all atoms I read back to box before migrating
 
@@ -964,6 +1078,23 @@ void ReadRestart::file_layout()
         error->all(FLERR,"Restart file is not a multi-proc file");
       if (multiproc && multiproc_file == 0)
         error->all(FLERR,"Restart file is a multi-proc file");
+
+    } else if (flag == DELTA) {
+      deltaflag = 1;
+      char *name = read_string();
+      basefile = name;
+      delete[] name;
+      baseoffset = read_bigint();
+      basesize = read_bigint();
+      quantum = read_double();
+
+    } else if (flag == MPIIO) {
+      mpiioflag = read_int();
+      if (mpiioflag) {
+        if (multiproc) error->all(FLERR,"Restart file is not a multi-proc file");
+        procsizes.resize(nprocs_file);
+        read_int_vec(nprocs_file,procsizes.data());
+      }
     }
     flag = read_int();
   }
@@ -22,6 +22,8 @@ CommandStyle(read_restart,ReadRestart);
 
 #include "command.h"
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class ReadRestart : public Command {
@@ -38,6 +40,13 @@ class ReadRestart : public Command {
   int multiproc_file;    // # of parallel files in restart
   int nprocs_file;       // total # of procs that wrote restart file
   int revision;          // revision number of the restart file format
+  int mpiioflag;         // 1 = restart file was written with MPI-IO
+  std::vector<int> procsizes;    // size of each per-proc chunk in MPI-IO file
+  int deltaflag;         // 1 = restart file stores atoms relative to a base file
+  std::string basefile;  // name of base file of a delta file
+  bigint baseoffset;     // file offset of per-proc data in base file
+  bigint basesize;       // # of values in per-proc data of base file
+  double quantum;        // precision of coords in delta file, 0.0 = exact
 
   std::string file_search(const std::string &);
   void header();
@@ -18,6 +18,7 @@
 using namespace LAMMPS_NS;
 
 // only proc 0 calls methods of this class, except for constructor/destructor
+// and with read_dump mmap, where all procs read the same file
 
 /* ---------------------------------------------------------------------- */
 
@@ -26,6 +27,8 @@ Reader::Reader(LAMMPS *lmp) : Pointers(lmp)
   fp = nullptr;
   binary = false;
   compressed = false;
+  mmap_allow = 0;
+  mmap_flag = 0;
 }
 
 // avoid resource leak
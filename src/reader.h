@@ -36,9 +36,17 @@ class Reader : protected Pointers {
                              int &, int &, int &) = 0;
   virtual void read_atoms(int, int, double **) = 0;
 
+  // position file at first snapshot with timestep >= N, if supported
+  // return 1 if the reader did the search, 0 if it has no index
+
+  virtual int seek_time(bigint) { return 0; }
+
   virtual void open_file(const std::string &);
   virtual void close_file();
 
+  int mmap_allow;    // 1 if reader can map a file and read a slice of atoms on every proc
+  int mmap_flag;     // 1 if all procs read the file through a memory mapping
+
  protected:
   FILE *fp;           // pointer to opened file or pipe
   bool compressed;    // flag for dump file compression
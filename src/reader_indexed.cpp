@@ -0,0 +1,288 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "reader_indexed.h"
+
+#include "dump_indexed.h"
+#include "error.h"
+#include "memory.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+ReaderIndexed::ReaderIndexed(LAMMPS *lmp) : ReaderNative(lmp), rowbytes(0), iframe(0) {}
+
+/* ----------------------------------------------------------------------
+   open file written by dump indexed, read its file header
+   and load the snapshot index from the sidecar file, if present
+------------------------------------------------------------------------- */
+
+void ReaderIndexed::open_file(const std::string &file)
+{
+  if (fp != nullptr) close_file();
+
+  compressed = false;
+  binary = true;
+  fp = fopen(file.c_str(), "rb");
+  if (!fp) error->one(FLERR, "Cannot open file {}: {}", file, utils::getsyserror());
+  if (mmap_flag) map_file(file);
+  read_file_header(file);
+
+  // index entries are pairs of (timestep, offset) in the order written
+  // entries pointing past the end of the data file are ignored
+
+  steps.clear();
+  offsets.clear();
+  iframe = 0;
+
+  bigint start = tell();
+  seek(platform::END_OF_FILE);
+  bigint filesize = tell();
+  seek(start);
+
+  FILE *fpindex = fopen((file + ".index").c_str(), "rb");
+  if (fpindex) {
+    bigint entry[2];
+    while (fread(entry, sizeof(bigint), 2, fpindex) == 2) {
+      if (entry[1] < start || entry[1] >= filesize) break;
+      if (!offsets.empty() && entry[1] <= offsets.back()) break;
+      steps.push_back(entry[0]);
+      offsets.push_back(entry[1]);
+    }
+    fclose(fpindex);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   read file header: magic string, endian and revision flags,
+   column count and storage types, column labels, unit style
+------------------------------------------------------------------------- */
+
+void ReaderIndexed::read_file_header(const std::string &file)
+{
+  bigint len;
+  int endian, ncol;
+  read_buf(&len, sizeof(bigint), 1);
+  if (len >= 0) error->one(FLERR, "File {} is not an indexed dump file", file);
+  magic_string = read_binary_str(-len);
+  if (magic_string != DumpIndexed::MAGIC_STRING)
+    error->one(FLERR, "File {} is not an indexed dump file", file);
+  read_buf(&endian, sizeof(int), 1);
+  if (endian != DumpIndexed::ENDIAN)
+    error->one(FLERR, "Indexed dump file {} was written with different endianness", file);
+  read_buf(&revision, sizeof(int), 1);
+  if (revision > DumpIndexed::FORMAT_REVISION)
+    error->one(FLERR, "Unsupported indexed dump file revision {}", revision);
+
+  read_buf(&ncol, sizeof(int), 1);
+  if (ncol <= 0) error->one(FLERR, "Dump file is invalid or corrupted");
+  coltype.resize(ncol);
+  read_buf(coltype.data(), sizeof(int), ncol);
+  rowbytes = 0;
+  for (int j = 0; j < ncol; j++) {
+    if (coltype[j] == DumpIndexed::COL_INT) rowbytes += sizeof(int);
+    else if (coltype[j] == DumpIndexed::COL_BIGINT) rowbytes += sizeof(bigint);
+    else if (coltype[j] == DumpIndexed::COL_DOUBLE) rowbytes += sizeof(double);
+    else error->one(FLERR, "Dump file is invalid or corrupted");
+  }
+  size_one = ncol;
+
+  int n;
+  read_buf(&n, sizeof(int), 1);
+  labelline = read_binary_str(n);
+  read_buf(&n, sizeof(int), 1);
+  unit_style = read_binary_str(n);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReaderIndexed::close_file()
+{
+  ReaderNative::close_file();
+  steps.clear();
+  offsets.clear();
+  iframe = 0;
+}
+
+/* ----------------------------------------------------------------------
+   position file at first indexed snapshot at or after the current
+   file position with timestep >= nrequest, or at end-of-file if none
+   return 0 if there is no index and the caller has to scan instead
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+int ReaderIndexed::seek_time(bigint nrequest)
+{
+  if (offsets.empty()) return 0;
+
+  bigint pos = tell();
+  if (iframe >= offsets.size() || offsets[iframe] < pos)
+    iframe = std::lower_bound(offsets.begin(), offsets.end(), pos) - offsets.begin();
+
+  while (iframe < offsets.size() && steps[iframe] < nrequest) iframe++;
+
+  if (iframe < offsets.size()) seek(offsets[iframe]);
+  else seek(platform::END_OF_FILE);
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   read and return time stamp from dump file
+   if first read reaches end-of-file, return 1 so caller can open next file
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+int ReaderIndexed::read_time(bigint &ntimestep)
+{
+  if (mapbase) {
+    if (mappos + (bigint) sizeof(bigint) > mapsize) return 1;
+    read_buf(&ntimestep, sizeof(bigint), 1);
+  } else {
+    auto ret = fread(&ntimestep, sizeof(bigint), 1, fp);
+    if (ret != 1 || feof(fp)) return 1;
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   skip snapshot from timestamp onward
+   jump to the next indexed snapshot, else skip chunks using their sizes
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderIndexed::skip()
+{
+  bigint pos = tell() - sizeof(bigint);
+  auto it = std::lower_bound(offsets.begin(), offsets.end(), pos);
+  if ((it != offsets.end()) && (*it == pos) && (it + 1 != offsets.end())) {
+    seek(*(it + 1));
+    return;
+  }
+
+  int triclinic;
+  char flag = 0;
+  skip_buf(sizeof(bigint));
+  read_buf(&flag, sizeof(char), 1);
+  if (flag) skip_buf(sizeof(double));
+  read_buf(&triclinic, sizeof(int), 1);
+  skip_buf((sizeof(int) + sizeof(double)) * 6);
+  if (triclinic) skip_buf(sizeof(double) * 3);
+
+  read_buf(&nchunk, sizeof(int), 1);
+  if (nchunk < 0) error->one(FLERR, "Dump file is invalid or corrupted");
+
+  int n;
+  for (int i = 0; i < nchunk; i++) {
+    read_buf(&n, sizeof(int), 1);
+    skip_buf(chunk_bytes(n));
+  }
+}
+
+/* ----------------------------------------------------------------------
+   read remaining header info, see ReaderNative::read_header()
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+bigint ReaderIndexed::read_header(double box[3][3], int &boxinfo, int &triclinic, int fieldinfo,
+                                  int nfield, int *fieldtype, char **fieldlabel, int scaleflag,
+                                  int wrapflag, int &fieldflag, int &xflag, int &yflag,
+                                  int &zflag)
+{
+  bigint natoms = 0;
+  read_buf(&natoms, sizeof(bigint), 1);
+
+  char flag = 0;
+  read_buf(&flag, sizeof(char), 1);
+  if (flag) skip_buf(sizeof(double));
+
+  boxinfo = 1;
+  triclinic = 0;
+  box[0][2] = box[1][2] = box[2][2] = 0.0;
+
+  int boundary[3][2];
+  read_buf(&triclinic, sizeof(int), 1);
+  read_buf(&boundary[0][0], sizeof(int), 6);
+  read_buf(box[0], sizeof(double), 2);
+  read_buf(box[1], sizeof(double), 2);
+  read_buf(box[2], sizeof(double), 2);
+  if (triclinic) {
+    read_buf(&box[0][2], sizeof(double), 1);
+    read_buf(&box[1][2], sizeof(double), 1);
+    read_buf(&box[2][2], sizeof(double), 1);
+  }
+
+  read_buf(&nchunk, sizeof(int), 1);
+  ichunk = 0;
+  iatom_chunk = 0;
+
+  if (fieldinfo && match_fields(labelline, nfield, fieldtype, fieldlabel, scaleflag, wrapflag,
+                                fieldflag, xflag, yflag, zflag))
+    return 1;
+
+  if (mmap_flag) return select_atoms(natoms);
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   read next chunk of atoms stored column by column
+   convert to doubles and store row by row in databuf
+------------------------------------------------------------------------- */
+
+void ReaderIndexed::next_chunk()
+{
+  read_buf(&natom_chunk, sizeof(int), 1);
+  int n = natom_chunk;
+
+  size_t count = (size_t) n * size_one;
+  if (count > maxbuf) {
+    memory->grow(databuf, count, "reader:databuf");
+    maxbuf = count;
+  }
+
+  for (int j = 0; j < size_one; j++) {
+    if (coltype[j] == DumpIndexed::COL_DOUBLE) {
+      colbuf.resize(n * sizeof(double));
+      read_buf(colbuf.data(), sizeof(double), n);
+      auto *col = reinterpret_cast<double *>(colbuf.data());
+      for (int i = 0; i < n; i++) databuf[i * size_one + j] = col[i];
+    } else if (coltype[j] == DumpIndexed::COL_BIGINT) {
+      colbuf.resize(n * sizeof(bigint));
+      read_buf(colbuf.data(), sizeof(bigint), n);
+      auto *col = reinterpret_cast<bigint *>(colbuf.data());
+      for (int i = 0; i < n; i++) databuf[i * size_one + j] = (double) col[i];
+    } else {
+      colbuf.resize(n * sizeof(int));
+      read_buf(colbuf.data(), sizeof(int), n);
+      auto *col = reinterpret_cast<int *>(colbuf.data());
+      for (int i = 0; i < n; i++) databuf[i * size_one + j] = col[i];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   chunk sizes are stored as # of atoms
+------------------------------------------------------------------------- */
+
+bigint ReaderIndexed::chunk_atoms(int n)
+{
+  return n;
+}
+
+bigint ReaderIndexed::chunk_bytes(int n)
+{
+  return (bigint) n * rowbytes;
+}
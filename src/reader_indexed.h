@@ -0,0 +1,61 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef READER_CLASS
+// clang-format off
+ReaderStyle(indexed,ReaderIndexed);
+// clang-format on
+#else
+
+#ifndef LMP_READER_INDEXED_H
+#define LMP_READER_INDEXED_H
+
+#include "reader_native.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class ReaderIndexed : public ReaderNative {
+ public:
+  ReaderIndexed(class LAMMPS *);
+
+  int read_time(bigint &) override;
+  void skip() override;
+  bigint read_header(double[3][3], int &, int &, int, int, int *, char **, int, int, int &, int &,
+                     int &, int &) override;
+  int seek_time(bigint) override;
+
+  void open_file(const std::string &) override;
+  void close_file() override;
+
+ protected:
+  std::string labelline;       // column labels from file header
+  std::vector<int> coltype;    // storage type of each column
+  size_t rowbytes;             // bytes of one atom summed over all columns
+  std::vector<char> colbuf;    // raw data of one column of a chunk
+
+  std::vector<bigint> steps;      // timestep of each indexed snapshot
+  std::vector<bigint> offsets;    // file offset of each indexed snapshot
+  size_t iframe;                  // next index entry to consider in seek_time()
+
+  virtual void read_file_header(const std::string &);
+  void next_chunk() override;
+  bigint chunk_atoms(int) override;
+  bigint chunk_bytes(int) override;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
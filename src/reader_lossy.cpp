@@ -0,0 +1,202 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "reader_lossy.h"
+
+#include "dump_lossy.h"
+#include "error.h"
+#include "memory.h"
+
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+ReaderLossy::ReaderLossy(LAMMPS *lmp) : ReaderIndexed(lmp) {}
+
+/* ----------------------------------------------------------------------
+   read file header written by dump lossy, see DumpLossy::write_file_header()
+------------------------------------------------------------------------- */
+
+void ReaderLossy::read_file_header(const std::string &file)
+{
+  bigint len;
+  int endian, ncol;
+  read_buf(&len, sizeof(bigint), 1);
+  if (len >= 0) error->one(FLERR, "File {} is not a lossy dump file", file);
+  magic_string = read_binary_str(-len);
+  if (magic_string != DumpLossy::MAGIC_STRING)
+    error->one(FLERR, "File {} is not a lossy dump file", file);
+  read_buf(&endian, sizeof(int), 1);
+  if (endian != DumpLossy::ENDIAN)
+    error->one(FLERR, "Lossy dump file {} was written with different endianness", file);
+  read_buf(&revision, sizeof(int), 1);
+  if (revision > DumpLossy::FORMAT_REVISION)
+    error->one(FLERR, "Unsupported lossy dump file revision {}", revision);
+
+  read_buf(&ncol, sizeof(int), 1);
+  if (ncol <= 0) error->one(FLERR, "Dump file is invalid or corrupted");
+  coltype.resize(ncol);
+  read_buf(coltype.data(), sizeof(int), ncol);
+  step.resize(ncol);
+  read_buf(step.data(), sizeof(double), ncol);
+  for (int j = 0; j < ncol; j++) {
+    if ((coltype[j] < DumpLossy::COL_INT) || (coltype[j] > DumpLossy::COL_DOUBLE) ||
+        !(step[j] >= 0.0))
+      error->one(FLERR, "Dump file is invalid or corrupted");
+    step[j] *= 2.0;
+  }
+  size_one = ncol;
+
+  int n;
+  read_buf(&n, sizeof(int), 1);
+  labelline = read_binary_str(n);
+  read_buf(&n, sizeof(int), 1);
+  unit_style = read_binary_str(n);
+}
+
+/* ----------------------------------------------------------------------
+   read and decode next chunk, see DumpLossy for the encoding
+   store values row by row in databuf
+------------------------------------------------------------------------- */
+
+void ReaderLossy::next_chunk()
+{
+  int nbytes;
+  read_buf(&nbytes, sizeof(int), 1);
+  if (nbytes < (int) sizeof(int)) error->one(FLERR, "Dump file is invalid or corrupted");
+  colbuf.resize(nbytes);
+  read_buf(colbuf.data(), sizeof(char), nbytes);
+
+  memcpy(&natom_chunk, colbuf.data(), sizeof(int));
+  int n = natom_chunk;
+  if (n < 0) error->one(FLERR, "Dump file is invalid or corrupted");
+
+  size_t count = (size_t) n * size_one;
+  if (count > maxbuf) {
+    memory->grow(databuf, count, "reader:databuf");
+    maxbuf = count;
+  }
+
+  const char *ptr = colbuf.data() + sizeof(int);
+  const char *end = colbuf.data() + nbytes;
+
+  auto get_varint = [&]() {
+    uint64_t u = 0;
+    int shift = 0;
+    while (true) {
+      if ((ptr >= end) || (shift > 63)) error->one(FLERR, "Dump file is invalid or corrupted");
+      auto c = (unsigned char) *ptr++;
+      u |= (uint64_t) (c & 0x7f) << shift;
+      if (!(c & 0x80)) break;
+      shift += 7;
+    }
+    return u;
+  };
+
+  std::vector<int> escidx;
+  std::vector<double> escval;
+
+  for (int j = 0; j < size_one; j++) {
+    uint64_t prev = 0;
+
+    // lossless floating-point column
+
+    if ((coltype[j] == DumpLossy::COL_DOUBLE) && (step[j] == 0.0)) {
+      for (int i = 0; i < n; i++) {
+        if (ptr >= end) error->one(FLERR, "Dump file is invalid or corrupted");
+        int lz = *ptr++;
+        if ((lz < 0) || (lz > 8) || (end - ptr < 8 - lz))
+          error->one(FLERR, "Dump file is invalid or corrupted");
+        uint64_t u = 0;
+        for (int k = 7 - lz; k >= 0; k--) u |= (uint64_t) (unsigned char) *ptr++ << (8 * k);
+        prev ^= u;
+        memcpy(&databuf[(size_t) i * size_one + j], &prev, sizeof(double));
+      }
+      continue;
+    }
+
+    // escaped values, then bit-packed residuals
+
+    auto nesc = get_varint();
+    if (nesc > (uint64_t) n) error->one(FLERR, "Dump file is invalid or corrupted");
+    escidx.resize(nesc);
+    escval.resize(nesc);
+    uint64_t last = 0;
+    for (uint64_t k = 0; k < nesc; k++) {
+      last += get_varint();
+      if ((last >= (uint64_t) n) || (end - ptr < (int) sizeof(double)))
+        error->one(FLERR, "Dump file is invalid or corrupted");
+      escidx[k] = last;
+      memcpy(&escval[k], ptr, sizeof(double));
+      ptr += sizeof(double);
+    }
+
+    uint64_t nextesc = 0;
+    for (int i0 = 0; i0 < n; i0 += DumpLossy::BLOCK) {
+      int nblock = MIN(DumpLossy::BLOCK, n - i0);
+      if (ptr >= end) error->one(FLERR, "Dump file is invalid or corrupted");
+      int width = (unsigned char) *ptr++;
+      if ((width > 64) || (end - ptr < ((bigint) nblock * width + 7) / 8))
+        error->one(FLERR, "Dump file is invalid or corrupted");
+
+      uint64_t acc = 0;
+      int nacc = 0;
+      for (int i = i0; i < i0 + nblock; i++) {
+        uint64_t v = 0;
+        int shift = 0;
+        for (int left = width; left > 0;) {
+          int take = (left < 32) ? left : 32;
+          while (nacc < take) {
+            acc |= (uint64_t) (unsigned char) *ptr++ << nacc;
+            nacc += 8;
+          }
+          v |= (acc & ((1ULL << take) - 1)) << shift;
+          acc >>= take;
+          nacc -= take;
+          shift += take;
+          left -= take;
+        }
+
+        double &value = databuf[(size_t) i * size_one + j];
+        if ((nextesc < nesc) && (escidx[nextesc] == i)) {
+          value = escval[nextesc++];
+          continue;
+        }
+        prev += (v >> 1) ^ (0 - (v & 1));
+        if (coltype[j] == DumpLossy::COL_DOUBLE) value = (double) (int64_t) prev * step[j];
+        else value = (double) (int64_t) prev;
+      }
+    }
+  }
+
+  if (ptr != end) error->one(FLERR, "Dump file is invalid or corrupted");
+}
+
+/* ----------------------------------------------------------------------
+   chunk sizes are stored as # of bytes, followed by the # of atoms
+------------------------------------------------------------------------- */
+
+bigint ReaderLossy::chunk_atoms(int /*n*/)
+{
+  int natoms;
+  read_buf(&natoms, sizeof(int), 1);
+  seek(tell() - sizeof(int));
+  return natoms;
+}
+
+bigint ReaderLossy::chunk_bytes(int n)
+{
+  return n;
+}
@@ -0,0 +1,43 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef READER_CLASS
+// clang-format off
+ReaderStyle(lossy,ReaderLossy);
+// clang-format on
+#else
+
+#ifndef LMP_READER_LOSSY_H
+#define LMP_READER_LOSSY_H
+
+#include "reader_indexed.h"
+
+namespace LAMMPS_NS {
+
+class ReaderLossy : public ReaderIndexed {
+ public:
+  ReaderLossy(class LAMMPS *);
+
+ private:
+  std::vector<double> step;    // quantization step of each column, 0.0 = lossless
+
+  void read_file_header(const std::string &) override;
+  void next_chunk() override;
+  bigint chunk_atoms(int) override;
+  bigint chunk_bytes(int) override;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -14,6 +14,7 @@
 
 #include "reader_native.h"
 
+#include "comm.h"
 #include "error.h"
 #include "memory.h"
 #include "tokenizer.h"
@@ -22,6 +23,10 @@
 #include <exception>
 #include <utility>
 
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+
 using namespace LAMMPS_NS;
 
 static constexpr int MAXLINE = 1024;        // max line length in dump file
@@ -34,17 +39,48 @@ ReaderNative::ReaderNative(LAMMPS *lmp) : Reader(lmp)
   fieldindex = nullptr;
   maxbuf = 0;
   databuf = nullptr;
+
+  mapbase = nullptr;
+  mapsize = mappos = 0;
+  frameend = -1;
+  nremain = 0;
+  mmap_allow = 1;
 }
 
 /* ---------------------------------------------------------------------- */
 
 ReaderNative::~ReaderNative()
 {
+  close_file();
   delete[] line;
   memory->destroy(fieldindex);
   memory->destroy(databuf);
 }
 
+/* ----------------------------------------------------------------------
+   open file, in mmap mode also map the whole file into memory
+------------------------------------------------------------------------- */
+
+void ReaderNative::open_file(const std::string &file)
+{
+  Reader::open_file(file);
+  if (mmap_flag) map_file(file);
+}
+
+/* ----------------------------------------------------------------------
+   unmap and close current file if open
+------------------------------------------------------------------------- */
+
+void ReaderNative::close_file()
+{
+#if !defined(_WIN32)
+  if (mapbase) munmap(mapbase, mapsize);
+#endif
+  mapbase = nullptr;
+  mapsize = mappos = 0;
+  Reader::close_file();
+}
+
 /* ----------------------------------------------------------------------
    read and return time stamp from dump file
    if first read reaches end-of-file, return 1 so caller can open next file
@@ -59,10 +95,15 @@ int ReaderNative::read_time(bigint &ntimestep)
     magic_string = "";
     unit_style = "";
 
-    auto ret = fread(&ntimestep, sizeof(bigint), 1, fp);
-
     // detect end-of-file
-    if (ret != 1 || feof(fp)) return 1;
+
+    if (mapbase) {
+      if (mappos + (bigint) sizeof(bigint) > mapsize) return 1;
+      read_buf(&ntimestep, sizeof(bigint), 1);
+    } else {
+      auto ret = fread(&ntimestep, sizeof(bigint), 1, fp);
+      if (ret != 1 || feof(fp)) return 1;
+    }
 
     // detect newer format
     if (ntimestep < 0) {
@@ -215,8 +256,14 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
     // extract column labels and match to requested fields
     read_buf(&size_one, sizeof(int), 1);
 
+    // position at first chunk, so read_atoms() can follow directly
+
     if (!fieldinfo) {
       skip_reading_magic_str();
+      read_buf(&nchunk, sizeof(int), 1);
+      ichunk = 0;
+      iatom_chunk = 0;
+      if (mmap_flag) return select_atoms(natoms);
       return natoms;
     }
 
@@ -289,7 +336,25 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
     labelline = line + strlen("ITEM: ATOMS ");
   }
 
-  Tokenizer tokens(std::move(labelline));
+  if (match_fields(labelline, nfield, fieldtype, fieldlabel, scaleflag, wrapflag, fieldflag,
+                   xflag, yflag, zflag)) return 1;
+
+  if (mmap_flag) return select_atoms(natoms);
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   match requested fields to whitespace separated column labels
+   set fieldindex, fieldflag and xyz flags as described for read_header()
+   return 1 if there are no column labels, else 0
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+int ReaderNative::match_fields(const std::string &labelline, int nfield, int *fieldtype,
+                               char **fieldlabel, int scaleflag, int wrapflag, int &fieldflag,
+                               int &xflag, int &yflag, int &zflag)
+{
+  Tokenizer tokens(labelline);
   std::map<std::string, int> labels;
   nwords = 0;
 
@@ -297,10 +362,7 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
     labels[tokens.next()] = nwords++;
   }
 
-
-  if (nwords == 0) {
-    return 1;
-  }
+  if (nwords == 0) return 1;
 
   // match each field with a column of per-atom data
   // if fieldlabel set, match with explicit column
@@ -427,7 +489,7 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
   for (int i = 0; i < nfield; i++)
     if (fieldindex[i] < 0) fieldflag = -1;
 
-  return natoms;
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -440,7 +502,7 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
 void ReaderNative::read_atoms(int n, int nfield, double **fields)
 {
   if (binary) {
-    if (feof(fp)) {
+    if (n && iatom_chunk == 0 && at_eof()) {
       error->one(FLERR,"Unexpected end of dump file");
     }
 
@@ -450,10 +512,8 @@ void ReaderNative::read_atoms(int n, int nfield, double **fields)
     for (int i = 0; i < n; i++) {
       // if the last chunk has finished
       if (iatom_chunk == 0) {
-          read_buf(&natom_chunk, sizeof(int), 1);
-          read_double_chunk(natom_chunk);
-          natom_chunk /= size_one;
-          m = 0;
+        next_chunk();
+        m = 0;
       }
 
       // read one line of atom
@@ -472,6 +532,13 @@ void ReaderNative::read_atoms(int n, int nfield, double **fields)
         ichunk++;
       }
     }
+
+    // in mmap mode, continue after the snapshot once my slice is read
+
+    if (mmap_flag) {
+      nremain -= n;
+      if (nremain <= 0) seek(frameend);
+    }
   } else {
     for (int i = 0; i < n; i++) {
       utils::sfgets(FLERR, line, MAXLINE, fp, nullptr, error);
@@ -518,7 +585,12 @@ void ReaderNative::read_lines(int n)
 
 void ReaderNative::read_buf(void * ptr, size_t size, size_t count)
 {
-  utils::sfread(FLERR, ptr, size, count, fp, nullptr, error);
+  if (mapbase) {
+    bigint nbytes = size*count;
+    if (mappos + nbytes > mapsize) error->one(FLERR,"Unexpected end of dump file");
+    memcpy(ptr, mapbase + mappos, nbytes);
+    mappos += nbytes;
+  } else utils::sfread(FLERR, ptr, size, count, fp, nullptr, error);
 }
 
 std::string ReaderNative::read_binary_str(size_t size)
@@ -540,12 +612,132 @@ void ReaderNative::read_double_chunk(size_t count)
 
 void ReaderNative::skip_buf(size_t size)
 {
-  bigint pos = platform::ftell(fp);
-  pos += size;
-  platform::fseek(fp,pos);
+  seek(tell() + size);
+}
+
+/* ----------------------------------------------------------------------
+   file position helpers, work on the mapped file or on fp
+------------------------------------------------------------------------- */
+
+bigint ReaderNative::tell()
+{
+  if (mapbase) return mappos;
+  return platform::ftell(fp);
+}
+
+void ReaderNative::seek(bigint pos)
+{
+  if (mapbase) mappos = (pos == platform::END_OF_FILE) ? mapsize : pos;
+  else platform::fseek(fp,pos);
+}
+
+bool ReaderNative::at_eof()
+{
+  if (mapbase) return mappos >= mapsize;
+  return feof(fp);
+}
+
+/* ----------------------------------------------------------------------
+   read next chunk of atoms into databuf, set natom_chunk
+------------------------------------------------------------------------- */
+
+void ReaderNative::next_chunk()
+{
+  read_buf(&natom_chunk, sizeof(int), 1);
+  read_double_chunk(natom_chunk);
+  natom_chunk /= size_one;
+}
+
+/* ----------------------------------------------------------------------
+   # of atoms and # of bytes of a chunk with size N as stored in the file
+------------------------------------------------------------------------- */
+
+bigint ReaderNative::chunk_atoms(int n)
+{
+  return n / size_one;
+}
+
+bigint ReaderNative::chunk_bytes(int n)
+{
+  return (bigint) n * sizeof(double);
 }
 
 bool ReaderNative::is_known_magic_str() const
 {
   return magic_string == "DUMPATOM" || magic_string == "DUMPCUSTOM";
 }
+
+/* ----------------------------------------------------------------------
+   map opened binary dump file read-only into memory
+   called by all procs in mmap mode
+------------------------------------------------------------------------- */
+
+void ReaderNative::map_file(const std::string &file)
+{
+  if (compressed || !binary)
+    error->one(FLERR,"Read_dump mmap requires an uncompressed binary dump file, not {}", file);
+
+#if defined(_WIN32)
+  error->one(FLERR,"Read_dump mmap is not supported on Windows");
+#else
+  bigint pos = platform::ftell(fp);
+  platform::fseek(fp,platform::END_OF_FILE);
+  mapsize = platform::ftell(fp);
+  platform::fseek(fp,pos);
+
+  // an empty file is read through fp and reports end-of-file right away
+
+  if (mapsize <= 0) return;
+  void *ptr = mmap(nullptr, mapsize, PROT_READ, MAP_SHARED, fileno(fp), 0);
+  if (ptr == MAP_FAILED)
+    error->one(FLERR,"Cannot mmap dump file {}: {}", file, utils::getsyserror());
+  mapbase = (char *) ptr;
+  mappos = pos;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   select contiguous slice of snapshot atoms read by this proc in mmap mode
+   called after the snapshot header, positioned at its first chunk
+   walks chunk sizes to locate the slice and the end of the snapshot
+   positions file at the first atom of the slice
+   return # of atoms in my slice
+------------------------------------------------------------------------- */
+
+bigint ReaderNative::select_atoms(bigint natoms)
+{
+  bigint first = (bigint) comm->me * natoms / comm->nprocs;
+  bigint last = (bigint) (comm->me+1) * natoms / comm->nprocs;
+
+  bigint ntotal = 0;
+  bigint startpos = -1;
+  bigint startskip = 0;
+  int n;
+
+  for (int i = 0; i < nchunk; i++) {
+    bigint pos = tell();
+    read_buf(&n, sizeof(int), 1);
+    if (n < 0) error->one(FLERR,"Dump file is invalid or corrupted");
+    bigint natoms_chunk = chunk_atoms(n);
+    if ((startpos < 0) && (ntotal + natoms_chunk > first)) {
+      startpos = pos;
+      startskip = first - ntotal;
+    }
+    ntotal += natoms_chunk;
+    skip_buf(chunk_bytes(n));
+  }
+  if (ntotal != natoms) error->one(FLERR,"Dump file is invalid or corrupted");
+
+  frameend = tell();
+  nremain = last - first;
+  if (nremain == 0) return 0;
+
+  // if the slice starts inside a chunk, load that chunk and skip its leading atoms
+
+  seek(startpos);
+  if (startskip) {
+    next_chunk();
+    iatom_chunk = startskip;
+  }
+  return nremain;
+}
@@ -40,7 +40,10 @@ class ReaderNative : public Reader {
                      int &, int &) override;
   void read_atoms(int, int, double **) override;
 
- private:
+  void open_file(const std::string &) override;
+  void close_file() override;
+
+ protected:
   int revision;
 
   std::string magic_string;
@@ -58,12 +61,31 @@ class ReaderNative : public Reader {
   int natom_chunk;    // number of atoms in the current chunks
   int iatom_chunk;    // index of current atom in the current chunk
 
+  char *mapbase;      // memory-mapped dump file, nullptr if read through fp
+  bigint mapsize;     // size of mapped file in bytes
+  bigint mappos;      // current read position in mapped file
+  bigint frameend;    // file position after current snapshot in mmap mode
+  bigint nremain;     // # of atoms of my slice still to read in mmap mode
+
   int find_label(const std::string &label, const std::map<std::string, int> &labels);
+  int match_fields(const std::string &, int, int *, char **, int, int, int &, int &, int &, int &);
   void read_lines(int);
 
   void read_buf(void *, size_t, size_t);
   void read_double_chunk(size_t);
   void skip_buf(size_t);
+  bigint tell();
+  void seek(bigint);
+  bool at_eof();
+  void map_file(const std::string &);
+  bigint select_atoms(bigint);
+
+  // chunk layout, differs between native and derived binary formats
+
+  virtual void next_chunk();
+  virtual bigint chunk_atoms(int);
+  virtual bigint chunk_bytes(int);
+
   void skip_reading_magic_str();
   bool is_known_magic_str() const;
   std::string read_binary_str(size_t);
@@ -285,6 +285,9 @@ void Respa::init()
 {
   Integrate::init();
 
+  if (force->kspace && (force->kspace->nevery > 1))
+    error->all(FLERR,"Kspace_modify every is not supported by run style respa");
+
   // warn if no fixes
 
   if (modify->nfix == 0 && comm->me == 0)
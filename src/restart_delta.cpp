@@ -0,0 +1,241 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "restart_delta.h"
+
+#include "error.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+// encoding of one atom record:
+//   tag, kind, record length, payload length (all as varints), payload
+// FULL payload = the packed record without its length, as raw doubles
+// DELTA payload = each value XORed with the reference value, stored as
+//   # of leading zero bytes followed by the remaining bytes
+// QUANTIZED payload = same as DELTA, except the 3 coords are stored as
+//   zigzag varints of their difference to the reference in units of quantum
+
+enum { FULL, DELTA, QUANTIZED };
+
+static constexpr double MAXQUANT = 4.0e15;    // larger multiples are stored as DELTA
+
+/* ---------------------------------------------------------------------- */
+
+static void put_varint(std::vector<char> &out, uint64_t u)
+{
+  while (u >= 0x80) {
+    out.push_back((char) ((u & 0x7f) | 0x80));
+    u >>= 7;
+  }
+  out.push_back((char) u);
+}
+
+/* ---------------------------------------------------------------------- */
+
+static void put_xor(std::vector<char> &out, double value, double ref)
+{
+  uint64_t a, b;
+  memcpy(&a, &value, sizeof(double));
+  memcpy(&b, &ref, sizeof(double));
+  uint64_t u = a ^ b;
+
+  int lz = 0;
+  while ((lz < 8) && (((u >> (56 - 8 * lz)) & 0xff) == 0)) lz++;
+  out.push_back((char) lz);
+  for (int i = 7 - lz; i >= 0; i--) out.push_back((char) ((u >> (8 * i)) & 0xff));
+}
+
+/* ---------------------------------------------------------------------- */
+
+RestartDelta::RestartDelta(LAMMPS *lmp) : Pointers(lmp) {}
+
+/* ---------------------------------------------------------------------- */
+
+void RestartDelta::clear()
+{
+  refbuf.clear();
+  refindex.clear();
+}
+
+/* ----------------------------------------------------------------------
+   store N doubles of packed atom records as reference state
+   only keep atoms with tag % nmod == imod
+------------------------------------------------------------------------- */
+
+void RestartDelta::add_reference(int n, double *buf, int nmod, int imod)
+{
+  int m = 0;
+  while (m < n) {
+    int len = static_cast<int>(buf[m]);
+    auto tag = (tagint) ubuf(buf[m + 4]).i;
+    if (tag % nmod == imod) {
+      refindex[tag] = refbuf.size();
+      refbuf.insert(refbuf.end(), &buf[m], &buf[m + len]);
+    }
+    m += len;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return reference record of atom tag, or nullptr if there is none
+   if len >= 0, the record must also have that length
+------------------------------------------------------------------------- */
+
+const double *RestartDelta::find(tagint tag, int len)
+{
+  auto it = refindex.find(tag);
+  if (it == refindex.end()) return nullptr;
+  const double *ref = &refbuf[it->second];
+  if ((len >= 0) && (static_cast<int>(ref[0]) != len)) return nullptr;
+  return ref;
+}
+
+/* ----------------------------------------------------------------------
+   encode N doubles of packed atom records relative to the reference state
+   atoms without reference record are stored in full
+------------------------------------------------------------------------- */
+
+void RestartDelta::encode(int n, double *buf, double quantum, std::vector<char> &out)
+{
+  std::vector<char> payload;
+  int64_t k[3];
+
+  out.clear();
+  int m = 0;
+  while (m < n) {
+    double *rec = &buf[m];
+    int len = static_cast<int>(rec[0]);
+    auto tag = (tagint) ubuf(rec[4]).i;
+    const double *ref = find(tag, len);
+
+    int kind = FULL;
+    payload.clear();
+    if (!ref) {
+      payload.resize((len - 1) * sizeof(double));
+      memcpy(payload.data(), &rec[1], payload.size());
+    } else {
+      kind = DELTA;
+      if (quantum > 0.0) {
+        kind = QUANTIZED;
+        for (int j = 0; j < 3; j++) {
+          double d = (rec[1 + j] - ref[1 + j]) / quantum;
+          if (!(fabs(d) < MAXQUANT)) kind = DELTA;
+          else k[j] = llround(d);
+        }
+      }
+      for (int j = 1; j < len; j++) {
+        if ((kind == QUANTIZED) && (j <= 3))
+          put_varint(payload, ((uint64_t) k[j - 1] << 1) ^ (uint64_t) (k[j - 1] >> 63));
+        else
+          put_xor(payload, rec[j], ref[j]);
+      }
+    }
+
+    put_varint(out, tag);
+    out.push_back((char) kind);
+    put_varint(out, len);
+    put_varint(out, payload.size());
+    out.insert(out.end(), payload.begin(), payload.end());
+    m += len;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   decode nbytes of encoded atom records
+   reconstruct records of atoms with tag % nmod == imod and append to out
+   their reference records must have been added with the same nmod, imod
+------------------------------------------------------------------------- */
+
+void RestartDelta::decode(const char *bytes, bigint nbytes, double quantum, int nmod, int imod,
+                          std::vector<double> &out)
+{
+  const char *ptr = bytes;
+  const char *end = bytes + nbytes;
+
+  auto get_varint = [&]() {
+    uint64_t u = 0;
+    int shift = 0;
+    while (true) {
+      if ((ptr >= end) || (shift > 63)) error->one(FLERR, "Delta restart file is corrupted");
+      auto c = (unsigned char) *ptr++;
+      u |= (uint64_t) (c & 0x7f) << shift;
+      if (!(c & 0x80)) break;
+      shift += 7;
+    }
+    return u;
+  };
+
+  while (ptr < end) {
+    auto tag = (tagint) get_varint();
+    if (ptr >= end) error->one(FLERR, "Delta restart file is corrupted");
+    int kind = *ptr++;
+    int len = static_cast<int>(get_varint());
+    auto nskip = (bigint) get_varint();
+    const char *next = ptr + nskip;
+    if ((len < 1) || (nskip > end - ptr)) error->one(FLERR, "Delta restart file is corrupted");
+
+    if (tag % nmod != imod) {
+      ptr = next;
+      continue;
+    }
+
+    bigint m = out.size();
+    out.resize(m + len);
+    double *rec = &out[m];
+    rec[0] = len;
+
+    if (kind == FULL) {
+      if (nskip != (bigint) ((len - 1) * sizeof(double)))
+        error->one(FLERR, "Delta restart file is corrupted");
+      memcpy(&rec[1], ptr, nskip);
+
+    } else {
+      const double *ref = find(tag, len);
+      if (!ref) error->one(FLERR, "Atom {} in delta restart file is missing from base file", tag);
+
+      for (int j = 1; j < len; j++) {
+        if ((kind == QUANTIZED) && (j <= 3)) {
+          uint64_t u = get_varint();
+          auto k = (int64_t) (u >> 1) ^ -(int64_t) (u & 1);
+          rec[j] = ref[j] + k * quantum;
+        } else {
+          if (ptr >= next) error->one(FLERR, "Delta restart file is corrupted");
+          int lz = *ptr++;
+          if ((lz < 0) || (lz > 8) || (next - ptr < 8 - lz))
+            error->one(FLERR, "Delta restart file is corrupted");
+          uint64_t u = 0;
+          for (int i = 7 - lz; i >= 0; i--) u |= (uint64_t) (unsigned char) *ptr++ << (8 * i);
+          uint64_t b;
+          memcpy(&b, &ref[j], sizeof(double));
+          b ^= u;
+          memcpy(&rec[j], &b, sizeof(double));
+        }
+      }
+      if (ptr != next) error->one(FLERR, "Delta restart file is corrupted");
+    }
+    ptr = next;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double RestartDelta::memory_usage()
+{
+  double bytes = (double) refbuf.capacity() * sizeof(double);
+  bytes += (double) refindex.size() * (sizeof(tagint) + sizeof(bigint) + 2 * sizeof(void *));
+  return bytes;
+}
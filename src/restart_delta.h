@@ -0,0 +1,43 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_RESTART_DELTA_H
+#define LMP_RESTART_DELTA_H
+
+#include "pointers.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class RestartDelta : protected Pointers {
+ public:
+  RestartDelta(class LAMMPS *);
+
+  void clear();
+  void add_reference(int, double *, int, int);
+  void encode(int, double *, double, std::vector<char> &);
+  void decode(const char *, bigint, double, int, int, std::vector<double> &);
+  double memory_usage();
+
+ private:
+  std::vector<double> refbuf;                   // packed atom records of reference state
+  std::unordered_map<tagint, bigint> refindex;  // offset of each atom's record in refbuf
+
+  const double *find(tagint, int);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
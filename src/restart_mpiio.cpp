@@ -0,0 +1,175 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "restart_mpiio.h"
+
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+// non-blocking collective file writes were added in MPI 3.1
+
+#if !defined(MPI_STUBS) && defined(MPI_VERSION) && \
+    ((MPI_VERSION > 3) || ((MPI_VERSION == 3) && (MPI_SUBVERSION > 0)))
+#define LMP_MPIIO_ASYNC
+#endif
+
+/* ---------------------------------------------------------------------- */
+
+RestartMPIIO::RestartMPIIO(LAMMPS *lmp) : Pointers(lmp), pending(0), opened(0) {}
+
+/* ---------------------------------------------------------------------- */
+
+RestartMPIIO::~RestartMPIIO()
+{
+  close();
+}
+
+/* ----------------------------------------------------------------------
+   all procs open file for collective writing
+   naggregate > 0 sets # of procs that perform the file I/O
+     for the others, data is gathered to them by the MPI library
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::open_write(const std::string &file, int naggregate)
+{
+#if defined(MPI_STUBS)
+  (void) file;
+  (void) naggregate;
+  error->all(FLERR, "MPI-IO restart files require linking to an MPI library");
+#else
+  filename = file;
+  MPI_Info info;
+  MPI_Info_create(&info);
+  MPI_Info_set(info, "romio_cb_write", "enable");
+  if (naggregate > 0) MPI_Info_set(info, "cb_nodes", std::to_string(naggregate).c_str());
+
+  int rv = MPI_File_open(world, file.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, info, &mpifh);
+  MPI_Info_free(&info);
+  check(rv, "opening");
+  opened = 1;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   all procs open file for collective reading
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::open_read(const std::string &file)
+{
+#if defined(MPI_STUBS)
+  (void) file;
+  error->all(FLERR, "MPI-IO restart files require linking to an MPI library");
+#else
+  filename = file;
+  int rv = MPI_File_open(world, file.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &mpifh);
+  check(rv, "opening");
+  opened = 1;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   all procs write N doubles at their own file offset (in bytes)
+   if async is set and supported, return before the write completes
+     buffer must not be changed or freed until wait() is called
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::write(bigint offset, int n, double *buf, int async)
+{
+#if defined(MPI_STUBS)
+  (void) offset;
+  (void) n;
+  (void) buf;
+  (void) async;
+#else
+#if defined(LMP_MPIIO_ASYNC)
+  if (async) {
+    int rv = MPI_File_iwrite_at_all(mpifh, offset, buf, n, MPI_DOUBLE, &request);
+    check(rv, "writing");
+    pending = 1;
+    return;
+  }
+#else
+  (void) async;
+#endif
+  MPI_Status status;
+  int rv = MPI_File_write_at_all(mpifh, offset, buf, n, MPI_DOUBLE, &status);
+  check(rv, "writing");
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   all procs read N doubles starting at their own file offset (in bytes)
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::read(bigint offset, int n, double *buf)
+{
+#if defined(MPI_STUBS)
+  (void) offset;
+  (void) n;
+  (void) buf;
+#else
+  MPI_Status status;
+  int rv = MPI_File_read_at_all(mpifh, offset, buf, n, MPI_DOUBLE, &status);
+  check(rv, "reading");
+  int count;
+  MPI_Get_count(&status, MPI_DOUBLE, &count);
+  if (count != n) error->one(FLERR, "Unexpected end of restart file {}", filename);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   complete a pending non-blocking write
+   return 1 if it failed, 0 otherwise
+------------------------------------------------------------------------- */
+
+int RestartMPIIO::wait()
+{
+  if (!pending) return 0;
+  pending = 0;
+#if defined(LMP_MPIIO_ASYNC)
+  if (MPI_Wait(&request, MPI_STATUS_IGNORE) != MPI_SUCCESS) return 1;
+#endif
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   complete pending writes and close the file
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::close()
+{
+  wait();
+#if !defined(MPI_STUBS)
+  if (opened) MPI_File_close(&mpifh);
+#endif
+  opened = 0;
+}
+
+/* ----------------------------------------------------------------------
+   abort on an error code returned by an MPI-IO call
+------------------------------------------------------------------------- */
+
+void RestartMPIIO::check(int rv, const char *what)
+{
+#if defined(MPI_STUBS)
+  (void) rv;
+  (void) what;
+#else
+  if (rv == MPI_SUCCESS) return;
+  char str[MPI_MAX_ERROR_STRING];
+  int len;
+  MPI_Error_string(rv, str, &len);
+  error->one(FLERR, "Error {} restart file {} with MPI-IO: {}", what, filename, str);
+#endif
+}
@@ -0,0 +1,49 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_RESTART_MPIIO_H
+#define LMP_RESTART_MPIIO_H
+
+#include "pointers.h"
+
+namespace LAMMPS_NS {
+
+class RestartMPIIO : protected Pointers {
+ public:
+  RestartMPIIO(class LAMMPS *);
+  ~RestartMPIIO() override;
+
+  void open_write(const std::string &, int);
+  void open_read(const std::string &);
+  void write(bigint, int, double *, int);
+  void read(bigint, int, double *);
+  int wait();
+  void close();
+
+  int pending;    // 1 if a non-blocking write is in progress
+
+ private:
+  std::string filename;
+  int opened;
+
+#if !defined(MPI_STUBS)
+  MPI_File mpifh;
+  MPI_Request request;
+#endif
+
+  void check(int, const char *);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
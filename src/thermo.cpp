@@ -40,6 +40,7 @@
 #include "neighbor.h"
 #include "output.h"
 #include "pair.h"
+#include "profiler.h"
 #include "timer.h"
 #include "tokenizer.h"
 #include "universe.h"
@@ -394,16 +395,19 @@ void Thermo::compute(int flag)
   for (i = 0; i < ncompute; i++)
     if (compute_which[i] == SCALAR) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_SCALAR)) {
+        ProfileScope prof(timer->profiler, computes[i]);
         computes[i]->compute_scalar();
         computes[i]->invoked_flag |= Compute::INVOKED_SCALAR;
       }
     } else if (compute_which[i] == VECTOR) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_VECTOR)) {
+        ProfileScope prof(timer->profiler, computes[i]);
         computes[i]->compute_vector();
         computes[i]->invoked_flag |= Compute::INVOKED_VECTOR;
       }
     } else if (compute_which[i] == ARRAY) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_ARRAY)) {
+        ProfileScope prof(timer->profiler, computes[i]);
         computes[i]->compute_array();
         computes[i]->invoked_flag |= Compute::INVOKED_ARRAY;
       }
@@ -1185,6 +1189,7 @@ void Thermo::check_temp(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(temperature->invoked_flag & Compute::INVOKED_SCALAR)) {
+    ProfileScope prof(timer->profiler, temperature);
     temperature->compute_scalar();
     temperature->invoked_flag |= Compute::INVOKED_SCALAR;
   }
@@ -1205,6 +1210,7 @@ void Thermo::check_pe(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(pe->invoked_flag & Compute::INVOKED_SCALAR)) {
+    ProfileScope prof(timer->profiler, pe);
     pe->compute_scalar();
     pe->invoked_flag |= Compute::INVOKED_SCALAR;
   }
@@ -1222,6 +1228,7 @@ void Thermo::check_press_scalar(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(pressure->invoked_flag & Compute::INVOKED_SCALAR)) {
+    ProfileScope prof(timer->profiler, pressure);
     pressure->compute_scalar();
     pressure->invoked_flag |= Compute::INVOKED_SCALAR;
   }
@@ -1239,6 +1246,7 @@ void Thermo::check_press_vector(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(pressure->invoked_flag & Compute::INVOKED_VECTOR)) {
+    ProfileScope prof(timer->profiler, pressure);
     pressure->compute_vector();
     pressure->invoked_flag |= Compute::INVOKED_VECTOR;
 
@@ -16,6 +16,7 @@
 #include "comm.h"
 #include "error.h"
 #include "fmt/chrono.h"
+#include "profiler.h"
 
 #include <cstring>
 #include <ctime>
@@ -24,7 +25,7 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp)
+Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp), profiler(nullptr)
 {
   _level = NORMAL;
   _sync = OFF;
@@ -37,6 +38,13 @@ Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp)
 
 /* ---------------------------------------------------------------------- */
 
+Timer::~Timer()
+{
+  delete profiler;
+}
+
+/* ---------------------------------------------------------------------- */
+
 void Timer::init()
 {
   for (int i = 0; i < NUM_TIMER; i++) {
@@ -93,6 +101,7 @@ void Timer::barrier_start()
 
   MPI_Barrier(world);
 
+  if (profiler) profiler->reset();
   if (_level < LOOP) return;
 
   current_cpu = platform::cputime();
@@ -241,6 +250,24 @@ void Timer::modify_params(int narg, char **arg)
         if (_checkfreq <= 0) error->all(FLERR, "Illegal timer command");
       } else
         error->all(FLERR, "Illegal timer command");
+    } else if (strcmp(arg[iarg], "profile") == 0) {
+      ++iarg;
+      if (iarg >= narg) utils::missing_cmd_args(FLERR, "timer profile", error);
+      delete profiler;
+      profiler = nullptr;
+      if (strcmp(arg[iarg], "counters") == 0)
+        profiler = new Profiler(lmp, 1);
+      else if (utils::logical(FLERR, arg[iarg], false, lmp))
+        profiler = new Profiler(lmp, 0);
+      if (profiler) profiler->json_file = profile_json;
+    } else if (strcmp(arg[iarg], "profile/json") == 0) {
+      ++iarg;
+      if (iarg >= narg) utils::missing_cmd_args(FLERR, "timer profile/json", error);
+      if (strcmp(arg[iarg], "none") == 0)
+        profile_json.clear();
+      else
+        profile_json = arg[iarg];
+      if (profiler) profiler->json_file = profile_json;
     } else
       error->all(FLERR, "Illegal timer command");
     ++iarg;
@@ -256,7 +283,9 @@ void Timer::modify_params(int narg, char **arg)
       timeout = fmt::format("{:02d}:{:%M:%S}", tv.tm_yday * 24 + tv.tm_hour, tv);
     }
 
-    utils::logmesg(lmp, "New timer settings: style={}  mode={}  timeout={}\n", timer_style[_level],
-                   timer_mode[_sync], timeout);
+    std::string profile = "off";
+    if (profiler) profile = profiler->has_counters() ? "counters" : "on";
+    utils::logmesg(lmp, "New timer settings: style={}  mode={}  timeout={}  profile={}\n",
+                   timer_style[_level], timer_mode[_sync], timeout, profile);
   }
 }
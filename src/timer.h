@@ -44,6 +44,7 @@ class Timer : protected Pointers {
   enum tlevel { OFF = 0, LOOP, NORMAL, FULL };
 
   Timer(class LAMMPS *);
+  ~Timer() override;
 
   void init();
 
@@ -104,6 +105,8 @@ class Timer : protected Pointers {
 
   void modify_params(int, char **);
 
+  class Profiler *profiler;    // per-instance profiler, nullptr if not enabled
+
  private:
   double cpu_array[NUM_TIMER];
   double wall_array[NUM_TIMER];
@@ -116,6 +119,7 @@ class Timer : protected Pointers {
   int _s_timeout;    // copy of timeout for restoring after a forced timeout
   int _checkfreq;    // frequency of timeout checking
   int _nextcheck;    // loop number of next timeout check
+  std::string profile_json;    // JSON file for profiler results, empty if none
 
   // update one specific timer array
   void _stamp(enum ttype);
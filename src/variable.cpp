@@ -31,9 +31,11 @@
 #include "memory.h"
 #include "modify.h"
 #include "output.h"
+#include "profiler.h"
 #include "random_mars.h"
 #include "region.h"
 #include "thermo.h"
+#include "timer.h"
 #include "tokenizer.h"
 #include "universe.h"
 #include "update.h"
@@ -55,6 +57,7 @@ static constexpr int MAXLEVEL = 4;
 static constexpr int MAXLINE = 256;
 static constexpr int CHUNK = 1024;
 static constexpr int MAXFUNCARG = 6;
+static constexpr int ATOMBLOCK = 256;    // # of atoms per block in compiled atom-style vars
 
 // must match enumerator in variable.h
 const std::vector<std::string> Variable::varstyles = {
@@ -77,7 +80,8 @@ enum{DONE,ADD,SUBTRACT,MULTIPLY,DIVIDE,CARAT,MODULO,UNARY,
      RAMP,STAGGER,LOGFREQ,LOGFREQ2,LOGFREQ3,STRIDE,STRIDE2,
      VDISPLACE,SWIGGLE,CWIGGLE,GMASK,RMASK,
      GRMASK,IS_ACTIVE,IS_DEFINED,IS_AVAILABLE,IS_FILE,EXTRACT_SETTING,
-     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY,BIGINTARRAY,VECTORARRAY};
+     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY,BIGINTARRAY,VECTORARRAY,
+     THERMOKEY,VARSCALAR};
 
 // customize by adding a special function
 
@@ -123,6 +127,7 @@ Variable::Variable(LAMMPS *lmp) : Pointers(lmp)
   data = nullptr;
   dvalue = nullptr;
   vecs = nullptr;
+  program = nullptr;
 
   eval_in_progress = nullptr;
 
@@ -157,6 +162,7 @@ Variable::~Variable()
     else for (int j = 0; j < num[i]; j++) delete[] data[i][j];
     delete[] data[i];
     if (style[i] == VECTOR) memory->destroy(vecs[i].values);
+    delete program[i];
   }
   memory->sfree(names);
   memory->destroy(style);
@@ -167,6 +173,7 @@ Variable::~Variable()
   memory->sfree(data);
   memory->sfree(dvalue);
   memory->sfree(vecs);
+  memory->sfree(program);
 
   memory->destroy(eval_in_progress);
 
@@ -451,6 +458,8 @@ void Variable::set(int narg, char **arg)
         error->all(FLERR,"Cannot redefine variable as a different style");
       delete[] data[ivar][0];
       data[ivar][0] = utils::strdup(arg[2]);
+      delete program[ivar];
+      program[ivar] = nullptr;
       replaceflag = 1;
     } else {
       if (nvar == maxvar) grow();
@@ -477,6 +486,8 @@ void Variable::set(int narg, char **arg)
         error->all(FLERR,"Cannot redefine variable as a different style");
       delete[] data[ivar][0];
       data[ivar][0] = utils::strdup(arg[2]);
+      delete program[ivar];
+      program[ivar] = nullptr;
       replaceflag = 1;
     } else {
       if (nvar == maxvar) grow();
@@ -1000,7 +1011,9 @@ char *Variable::retrieve(const char *name)
     str = data[ivar][0] = utils::strdup(result);
 
   } else if (style[ivar] == EQUAL) {
-    double answer = evaluate(data[ivar][0],nullptr,ivar);
+    double answer;
+    if (compile(ivar)) answer = eval_program(ivar);
+    else answer = evaluate(data[ivar][0],nullptr,ivar);
     delete[] data[ivar][1];
     data[ivar][1] = utils::strdup(fmt::format("{:.15g}",answer));
     str = data[ivar][1];
@@ -1095,7 +1108,10 @@ double Variable::compute_equal(int ivar)
   eval_in_progress[ivar] = 1;
 
   double value = 0.0;
-  if (style[ivar] == EQUAL) value = evaluate(data[ivar][0],nullptr,ivar);
+  if (style[ivar] == EQUAL) {
+    if (compile(ivar)) value = eval_program(ivar);
+    else value = evaluate(data[ivar][0],nullptr,ivar);
+  }
   else if (style[ivar] == TIMER) value = dvalue[ivar];
   else if (style[ivar] == INTERNAL) value = dvalue[ivar];
   else if (style[ivar] == PYTHON) {
@@ -1141,6 +1157,14 @@ void Variable::compute_atom(int ivar, int igroup, double *result, int stride, in
 
   eval_in_progress[ivar] = 1;
 
+  // use compiled formula if possible, see compile()
+
+  if (style[ivar] == ATOM && compile(ivar)) {
+    eval_program_atom(ivar,igroup,result,stride,sumflag);
+    eval_in_progress[ivar] = 0;
+    return;
+  }
+
   if (style[ivar] == ATOM) {
     treetype = ATOM;
     evaluate(data[ivar][0],&tree,ivar);
@@ -1280,6 +1304,7 @@ void Variable::remove(int n)
   else for (int i = 0; i < num[n]; i++) delete[] data[n][i];
   delete[] data[n];
   delete reader[n];
+  delete program[n];
 
   for (int i = n+1; i < nvar; i++) {
     names[i-1] = names[i];
@@ -1290,6 +1315,7 @@ void Variable::remove(int n)
     reader[i-1] = reader[i];
     data[i-1] = data[i];
     dvalue[i-1] = dvalue[i];
+    program[i-1] = program[i];
 
     // copy VecVar struct from vecs[i] to vecs[i-1]
 
@@ -1300,6 +1326,7 @@ void Variable::remove(int n)
   data[nvar] = nullptr;
   reader[nvar] = nullptr;
   names[nvar] = nullptr;
+  program[nvar] = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -1331,6 +1358,9 @@ void Variable::grow()
     vecs[i].values = nullptr;
   }
 
+  program = (Program **) memory->srealloc(program,maxvar*sizeof(Program *),"var:program");
+  for (int i = old; i < maxvar; i++) program[i] = nullptr;
+
   memory->grow(eval_in_progress,maxvar,"var:eval_in_progress");
   for (int i = 0; i < maxvar; i++) eval_in_progress[i] = 0;
 }
@@ -1531,6 +1561,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_SCALAR)) {
+              ProfileScope prof(timer->profiler, compute);
               compute->compute_scalar();
               compute->invoked_flag |= Compute::INVOKED_SCALAR;
             }
@@ -1548,6 +1579,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
+              ProfileScope prof(timer->profiler, compute);
               compute->compute_vector();
               compute->invoked_flag |= Compute::INVOKED_VECTOR;
             }
@@ -1573,6 +1605,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
+              ProfileScope prof(timer->profiler, compute);
               compute->compute_array();
               compute->invoked_flag |= Compute::INVOKED_ARRAY;
             }
@@ -1598,6 +1631,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+              ProfileScope prof(timer->profiler, compute);
               compute->compute_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
@@ -1619,6 +1653,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+              ProfileScope prof(timer->profiler, compute);
               compute->compute_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
@@ -1649,6 +1684,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
+              ProfileScope prof(timer->profiler, compute);
               compute->compute_vector();
               compute->invoked_flag |= Compute::INVOKED_VECTOR;
             }
@@ -1678,6 +1714,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
             if (index1 > compute->size_array_cols)
               print_var_error(FLERR,"Variable formula compute array is accessed out-of-range",ivar,0);
             if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
+              ProfileScope prof(timer->profiler, compute);
               compute->compute_array();
               compute->invoked_flag |= Compute::INVOKED_ARRAY;
             }
@@ -1715,6 +1752,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+              ProfileScope prof(timer->profiler, compute);
               compute->compute_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
@@ -1739,6 +1777,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
+              ProfileScope prof(timer->profiler, compute);
               compute->compute_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
@@ -3484,6 +3523,714 @@ void Variable::free_tree(Tree *tree)
   delete tree;
 }
 
+/* ----------------------------------------------------------------------
+   compiled formulas for equal-style and atom-style variables
+   the formula string is parsed once into a list of instructions,
+     which is then re-used for every evaluation until the variable is
+     redefined or deleted
+   only a subset of formula items is compiled:
+     numbers, constants, thermo keywords, math operators, parenthesis,
+     math functions below, v_name of variables with a scalar value,
+     atom vectors for atom-style variables
+   all other formulas are always evaluated by evaluate()
+   customize by adding a math function that has no internal state
+------------------------------------------------------------------------- */
+
+namespace {
+struct CompiledFunction {
+  const char *name;
+  int op, narg;
+};
+const CompiledFunction compiled_functions[] = {
+  {"sqrt",SQRT,1}, {"exp",EXP,1}, {"ln",LN,1}, {"log",LOG,1}, {"abs",ABS,1},
+  {"sin",SIN,1}, {"cos",COS,1}, {"tan",TAN,1}, {"asin",ASIN,1}, {"acos",ACOS,1},
+  {"atan",ATAN,1}, {"atan2",ATAN2,2}, {"ceil",CEIL,1}, {"floor",FLOOR,1},
+  {"round",ROUND,1}, {"ternary",TERNARY,3}, {"ramp",RAMP,2}};
+
+// must be in the same order as in is_atom_vector()
+
+const std::vector<std::string> compiled_atom_vectors = {
+  "id", "mass", "type", "mol", "radius", "q", "x", "y", "z",
+  "vx", "vy", "vz", "fx", "fy", "fz"};
+enum{AV_ID,AV_MASS,AV_TYPE,AV_MOL,AV_RADIUS,AV_Q,AV_X,AV_Y,AV_Z,
+     AV_VX,AV_VY,AV_VZ,AV_FX,AV_FY,AV_FZ};
+}    // namespace
+
+/* ----------------------------------------------------------------------
+   compile formula of equal-style or atom-style variable ivar on first use
+   return 1 if compiled formula can be used for the current evaluation
+   return 0 if evaluate() must be used instead, either because the formula
+     cannot be compiled or so that evaluate() reports an error
+------------------------------------------------------------------------- */
+
+int Variable::compile(int ivar)
+{
+  if (!program[ivar]) {
+    auto prog = new Program();
+    program[ivar] = prog;
+    prog->result = compile_formula(data[ivar][0],prog,style[ivar] == ATOM);
+    if (prog->result >= 0) {
+      prog->valid = 1;
+      prog->values.resize(prog->code.size());
+      if (style[ivar] == ATOM) prog->block.resize(prog->code.size()*ATOMBLOCK);
+    } else {
+      prog->code.clear();
+      prog->words.clear();
+    }
+  }
+
+  Program *prog = program[ivar];
+  if (!prog->valid) return 0;
+  if (prog->needbox && domain->box_exist == 0) return 0;
+
+  // referenced variables must exist and have a scalar value
+
+  for (auto &instr : prog->code) {
+    if (instr.op != VARSCALAR) continue;
+    instr.jvar = find(prog->words[instr.index].c_str());
+    if (instr.jvar < 0) return 0;
+    if (style[instr.jvar] == ATOM || style[instr.jvar] == ATOMFILE ||
+        style[instr.jvar] == VECTOR) return 0;
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   recursively compile formula str into instructions appended to prog
+   follows the parsing in evaluate() so that operator precedence
+     and the order in which items are evaluated are the same
+   atomflag = 1 for atom-style variable, else 0
+   return index of instruction that produces the value of str
+   return -1 if str contains items that are not compiled or invalid syntax
+------------------------------------------------------------------------- */
+
+int Variable::compile_formula(const std::string &str, Program *prog, int atomflag)
+{
+  int argstack[MAXLEVEL];
+  int opstack[MAXLEVEL];
+  int nargstack = 0;
+  int nopstack = 0;
+  int op,opprevious,args[3];
+
+  const char *ptr = str.c_str();
+  int i = 0;
+  int expect = ARG;
+
+  while (true) {
+    char onechar = ptr[i];
+
+    if (isspace(onechar)) i++;
+
+    // parentheses: recursively compile contents of parens
+
+    else if (onechar == '(') {
+      if (expect == OP) return -1;
+      expect = OP;
+
+      int istop = i;
+      int ilevel = 0;
+      while (true) {
+        istop++;
+        if (!ptr[istop]) return -1;
+        if (ptr[istop] == '(') ilevel++;
+        else if (ptr[istop] == ')' && ilevel) ilevel--;
+        else if (ptr[istop] == ')') break;
+      }
+
+      int iarg = compile_formula(str.substr(i+1,istop-i-1),prog,atomflag);
+      if (iarg < 0 || nargstack == MAXLEVEL) return -1;
+      argstack[nargstack++] = iarg;
+      i = istop+1;
+
+    // number
+
+    } else if (isdigit(onechar) || onechar == '.') {
+      if (expect == OP) return -1;
+      expect = OP;
+
+      int istart = i;
+      while (isdigit(ptr[i]) || ptr[i] == '.') i++;
+      if (ptr[i] == 'e' || ptr[i] == 'E') {
+        i++;
+        if (ptr[i] == '+' || ptr[i] == '-') i++;
+        while (isdigit(ptr[i])) i++;
+      }
+
+      if (nargstack == MAXLEVEL) return -1;
+      argstack[nargstack++] =
+        add_instr(prog,VALUE,0,nullptr,0,atof(str.substr(istart,i-istart).c_str()));
+
+    // word
+
+    } else if (isalpha(onechar)) {
+      if (expect == OP) return -1;
+      expect = OP;
+
+      int istart = i;
+      while (isalnum(ptr[i]) || ptr[i] == '_') i++;
+      std::string word = str.substr(istart,i-istart);
+      int iarg;
+
+      // computes, fixes, custom atom properties are not compiled
+
+      if (utils::strmatch(word,"^[CcFf]_") || utils::strmatch(word,"^[id]2?_")) return -1;
+
+      // variable with a scalar value, checked in compile(int)
+
+      if (utils::strmatch(word,"^v_")) {
+        if (ptr[i] == '[') return -1;
+        prog->words.push_back(word.substr(2));
+        iarg = add_instr(prog,VARSCALAR,0,nullptr,prog->words.size()-1,0.0);
+
+      // math function
+
+      } else if (ptr[i] == '(') {
+        int istop = i;
+        int ilevel = 0;
+        while (true) {
+          istop++;
+          if (!ptr[istop]) return -1;
+          if (ptr[istop] == '(') ilevel++;
+          else if (ptr[istop] == ')' && ilevel) ilevel--;
+          else if (ptr[istop] == ')') break;
+        }
+        std::string contents = str.substr(i+1,istop-i-1);
+        i = istop+1;
+
+        const CompiledFunction *func = nullptr;
+        for (const auto &f : compiled_functions)
+          if (word == f.name) func = &f;
+        if (!func) return -1;
+
+        // collapse_tree() folds ternary() with constant first argument
+
+        if (atomflag && func->op == TERNARY) return -1;
+
+        std::vector<std::string> fargs;
+        std::size_t first = 0;
+        ilevel = 0;
+        for (std::size_t k = 0; k < contents.size(); k++) {
+          if (contents[k] == '(') ilevel++;
+          else if (contents[k] == ')') ilevel--;
+          else if (contents[k] == ',' && !ilevel) {
+            fargs.push_back(utils::trim(contents.substr(first,k-first)));
+            first = k+1;
+          }
+        }
+        fargs.push_back(utils::trim(contents.substr(first)));
+        if ((int) fargs.size() != func->narg) return -1;
+
+        for (int m = 0; m < func->narg; m++) {
+          args[m] = compile_formula(fargs[m],prog,atomflag);
+          if (args[m] < 0) return -1;
+        }
+        iarg = add_instr(prog,func->op,func->narg,args,0,0.0);
+
+      // atom value is not compiled
+
+      } else if (ptr[i] == '[') {
+        return -1;
+
+      // atom vector, only for atom-style variables
+
+      } else if (is_atom_vector((char *) word.c_str())) {
+        if (!atomflag) return -1;
+        int which = std::find(compiled_atom_vectors.begin(),compiled_atom_vectors.end(),word) -
+          compiled_atom_vectors.begin();
+        if (which == AV_MASS && !atom->rmass && !atom->mass) return -1;
+        if (which == AV_MOL && !atom->molecule_flag) return -1;
+        if (which == AV_RADIUS && !atom->radius_flag) return -1;
+        if (which == AV_Q && !atom->q_flag) return -1;
+        iarg = add_instr(prog,ATOMARRAY,0,nullptr,which,0.0);
+
+      // constant
+
+      } else if (constants.find(word) != constants.end()) {
+        iarg = add_instr(prog,VALUE,0,nullptr,0,constants[word]);
+
+      // thermo keyword
+
+      } else {
+        prog->words.push_back(word);
+        iarg = add_instr(prog,THERMOKEY,0,nullptr,prog->words.size()-1,0.0);
+      }
+
+      if (nargstack == MAXLEVEL) return -1;
+      argstack[nargstack++] = iarg;
+
+    // math operator, including end-of-string
+
+    } else if (strchr("+-*/^<>=!&|%\0",onechar)) {
+      if (onechar == '+') op = ADD;
+      else if (onechar == '-') op = SUBTRACT;
+      else if (onechar == '*') op = MULTIPLY;
+      else if (onechar == '/') op = DIVIDE;
+      else if (onechar == '%') op = MODULO;
+      else if (onechar == '^') op = CARAT;
+      else if (onechar == '=') {
+        if (ptr[i+1] != '=') return -1;
+        op = EQ;
+        i++;
+      } else if (onechar == '!') {
+        if (ptr[i+1] == '=') {
+          op = NE;
+          i++;
+        } else op = NOT;
+      } else if (onechar == '<') {
+        if (ptr[i+1] != '=') op = LT;
+        else {
+          op = LE;
+          i++;
+        }
+      } else if (onechar == '>') {
+        if (ptr[i+1] != '=') op = GT;
+        else {
+          op = GE;
+          i++;
+        }
+      } else if (onechar == '&') {
+        if (ptr[i+1] != '&') return -1;
+        op = AND;
+        i++;
+      } else if (onechar == '|') {
+        if (ptr[i+1] == '|') op = OR;
+        else if (ptr[i+1] == '^') op = XOR;
+        else return -1;
+        i++;
+      } else op = DONE;
+
+      i++;
+
+      if ((op == SUBTRACT || op == NOT) && expect == ARG) {
+        if (nopstack == MAXLEVEL) return -1;
+        opstack[nopstack++] = (op == SUBTRACT) ? UNARY : NOT;
+        continue;
+      }
+
+      if (expect == ARG) return -1;
+      expect = ARG;
+
+      // emit instructions as deep as possible while respecting precedence
+      // before pushing current op onto stack
+
+      while (nopstack && precedence[opstack[nopstack-1]] >= precedence[op]) {
+        opprevious = opstack[--nopstack];
+        if (opprevious == UNARY || opprevious == NOT) {
+          args[0] = argstack[--nargstack];
+          argstack[nargstack++] = add_instr(prog,opprevious,1,args,0,0.0);
+        } else {
+          args[1] = argstack[--nargstack];
+          args[0] = argstack[--nargstack];
+          argstack[nargstack++] = add_instr(prog,opprevious,2,args,0,0.0);
+        }
+      }
+
+      if (op == DONE) break;
+
+      if (nopstack == MAXLEVEL) return -1;
+      opstack[nopstack++] = op;
+
+    } else return -1;
+  }
+
+  if (nopstack || nargstack != 1) return -1;
+  return argstack[0];
+}
+
+/* ----------------------------------------------------------------------
+   append one instruction to prog and return its index
+------------------------------------------------------------------------- */
+
+int Variable::add_instr(Program *prog, int op, int narg, int *args, int index, double value)
+{
+  Instr instr;
+  instr.op = op;
+  instr.narg = narg;
+  instr.index = index;
+  instr.jvar = -1;
+  instr.value = value;
+  instr.peratom = (op == ATOMARRAY) ? 1 : 0;
+  for (int m = 0; m < narg; m++) {
+    instr.arg[m] = args[m];
+    if (prog->code[args[m]].peratom) instr.peratom = 1;
+  }
+  if (op == ATOMARRAY || op == THERMOKEY) prog->needbox = 1;
+
+  prog->code.push_back(instr);
+  return (int) prog->code.size() - 1;
+}
+
+/* ----------------------------------------------------------------------
+   evaluate a single instruction k of prog with a scalar result
+   operands are taken from prog->values
+   atomflag = 0: same as evaluate() for equal-style variable ivar
+   atomflag = 1: same as collapse_tree() for atom-style variable
+------------------------------------------------------------------------- */
+
+double Variable::eval_instr(Program *prog, int k, int ivar, int atomflag)
+{
+  const Instr &instr = prog->code[k];
+  const double *val = prog->values.data();
+  double value1 = (instr.narg > 0) ? val[instr.arg[0]] : 0.0;
+  double value2 = (instr.narg > 1) ? val[instr.arg[1]] : 0.0;
+
+  auto invalid = [&](const std::string &mesg) {
+    if (atomflag) error->one(FLERR,mesg);
+    else print_var_error(FLERR,mesg,ivar,0);
+  };
+
+  switch (instr.op) {
+  case VALUE:
+    return instr.value;
+
+  case THERMOKEY: {
+    const std::string &word = prog->words[instr.index];
+    if (output->thermo->evaluate_keyword(word,&value1))
+      print_var_error(FLERR,fmt::format("Invalid thermo keyword '{}' in variable formula",word),ivar);
+    return value1;
+  }
+
+  case VARSCALAR: {
+    int jvar = instr.jvar;
+    if (eval_in_progress[jvar])
+      print_var_error(FLERR,"has a circular dependency",jvar);
+    if (style[jvar] == INTERNAL) return dvalue[jvar];
+    char *var = retrieve(names[jvar]);
+    if (var == nullptr)
+      print_var_error(FLERR,"Invalid variable evaluation in variable formula",jvar);
+    if (!utils::is_double(var))
+      print_var_error(FLERR,"Non-numeric variable value in variable formula",jvar);
+    return atof(var);
+  }
+
+  case ADD: return value1 + value2;
+  case SUBTRACT: return value1 - value2;
+  case MULTIPLY: return value1 * value2;
+  case DIVIDE:
+    if (value2 == 0.0) invalid("Divide by 0 in variable formula");
+    return value1 / value2;
+  case MODULO:
+    if (value2 == 0.0) invalid("Modulo 0 in variable formula");
+    return fmod(value1,value2);
+  case CARAT:
+    if (atomflag) {
+      if (value2 == 0.0) invalid("Power by 0 in variable formula");
+    } else {
+      if (value2 == 0.0) return 1.0;
+      if ((value1 == 0.0) && (value2 < 0.0))
+        invalid("Invalid power expression in variable formula");
+    }
+    return pow(value1,value2);
+  case UNARY: return -value1;
+  case NOT: return (value1 == 0.0) ? 1.0 : 0.0;
+  case EQ: return (value1 == value2) ? 1.0 : 0.0;
+  case NE: return (value1 != value2) ? 1.0 : 0.0;
+  case LT: return (value1 < value2) ? 1.0 : 0.0;
+  case LE: return (value1 <= value2) ? 1.0 : 0.0;
+  case GT: return (value1 > value2) ? 1.0 : 0.0;
+  case GE: return (value1 >= value2) ? 1.0 : 0.0;
+  case AND: return (value1 != 0.0 && value2 != 0.0) ? 1.0 : 0.0;
+  case OR: return (value1 != 0.0 || value2 != 0.0) ? 1.0 : 0.0;
+  case XOR:
+    return ((value1 == 0.0 && value2 != 0.0) || (value1 != 0.0 && value2 == 0.0)) ? 1.0 : 0.0;
+
+  case SQRT:
+    if (value1 < 0.0) invalid("Sqrt of negative value in variable formula");
+    return sqrt(value1);
+  case EXP: return exp(value1);
+  case LN:
+    if (value1 <= 0.0) invalid("Log of zero/negative value in variable formula");
+    return log(value1);
+  case LOG:
+    if (value1 <= 0.0) invalid("Log of zero/negative value in variable formula");
+    return log10(value1);
+  case ABS: return fabs(value1);
+  case SIN: return sin(value1);
+  case COS: return cos(value1);
+  case TAN: return tan(value1);
+  case ASIN:
+    if (value1 < -1.0 || value1 > 1.0) invalid("Arcsin of invalid value in variable formula");
+    return asin(value1);
+  case ACOS:
+    if (value1 < -1.0 || value1 > 1.0) invalid("Arccos of invalid value in variable formula");
+    return acos(value1);
+  case ATAN: return atan(value1);
+  case ATAN2: return atan2(value1,value2);
+  case CEIL: return ceil(value1);
+  case FLOOR: return floor(value1);
+  case ROUND: return MYROUND(value1);
+  case TERNARY: return value1 ? value2 : val[instr.arg[2]];
+  case RAMP:
+    if (update->whichflag == 0) return value1;
+    else {
+      double delta = update->ntimestep - update->beginstep;
+      if ((delta != 0.0) && (update->beginstep != update->endstep))
+        delta /= update->endstep - update->beginstep;
+      return value1 + delta*(value2-value1);
+    }
+  }
+  return 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   evaluate compiled formula of equal-style variable ivar
+------------------------------------------------------------------------- */
+
+double Variable::eval_program(int ivar)
+{
+  Program *prog = program[ivar];
+  int ncode = prog->code.size();
+  for (int k = 0; k < ncode; k++) prog->values[k] = eval_instr(prog,k,ivar,0);
+  return prog->values[prog->result];
+}
+
+/* ----------------------------------------------------------------------
+   evaluate compiled formula of atom-style variable ivar
+   same result and error checks as evaluate() + collapse_tree() + eval_tree()
+   first all instructions that are the same for every atom are evaluated once,
+     thermo keywords and variables first as they are during parsing
+   then the remaining instructions are evaluated for blocks of ATOMBLOCK atoms
+     at a time, each instruction over the whole block
+------------------------------------------------------------------------- */
+
+void Variable::eval_program_atom(int ivar, int igroup, double *result, int stride, int sumflag)
+{
+  Program *prog = program[ivar];
+  int ncode = prog->code.size();
+
+  for (int k = 0; k < ncode; k++) {
+    const Instr &instr = prog->code[k];
+    if (instr.op == THERMOKEY || instr.op == VARSCALAR)
+      prog->values[k] = eval_instr(prog,k,ivar,1);
+  }
+  for (int k = 0; k < ncode; k++) {
+    const Instr &instr = prog->code[k];
+    if (!instr.peratom && instr.op != THERMOKEY && instr.op != VARSCALAR)
+      prog->values[k] = eval_instr(prog,k,ivar,1);
+  }
+
+  if (result == nullptr) return;
+
+  // broadcast values of non per-atom instructions to entire block
+
+  double *block = prog->block.data();
+  for (int k = 0; k < ncode; k++)
+    if (!prog->code[k].peratom)
+      for (int m = 0; m < ATOMBLOCK; m++) block[k*ATOMBLOCK+m] = prog->values[k];
+
+  int groupbit = group->bitmask[igroup];
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+  int active[ATOMBLOCK];
+  const double *answer = &block[prog->result*ATOMBLOCK];
+
+  for (int ifirst = 0; ifirst < nlocal; ifirst += ATOMBLOCK) {
+    int n = MIN(ATOMBLOCK,nlocal-ifirst);
+    for (int m = 0; m < n; m++) active[m] = mask[ifirst+m] & groupbit;
+
+    for (int k = 0; k < ncode; k++)
+      if (prog->code[k].peratom) eval_block(prog,k,ifirst,n,active);
+
+    int j = ifirst*stride;
+    if (sumflag == 0) {
+      for (int m = 0; m < n; m++) {
+        if (active[m]) result[j] = answer[m];
+        else result[j] = 0.0;
+        j += stride;
+      }
+    } else {
+      for (int m = 0; m < n; m++) {
+        if (active[m]) result[j] += answer[m];
+        j += stride;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   evaluate per-atom instruction k of prog for n atoms starting at ifirst
+   operands and result are ATOMBLOCK long slices of prog->block
+   errors are only checked for atoms with active set, as in eval_tree()
+------------------------------------------------------------------------- */
+
+void Variable::eval_block(Program *prog, int k, int ifirst, int n, int *active)
+{
+  const Instr &instr = prog->code[k];
+  double *block = prog->block.data();
+  double *out = &block[k*ATOMBLOCK];
+  const double *a = (instr.narg > 0) ? &block[instr.arg[0]*ATOMBLOCK] : nullptr;
+  const double *b = (instr.narg > 1) ? &block[instr.arg[1]*ATOMBLOCK] : nullptr;
+  int m;
+
+  switch (instr.op) {
+  case ATOMARRAY: {
+    if (instr.index == AV_ID) {
+      tagint *tag = atom->tag + ifirst;
+      for (m = 0; m < n; m++) out[m] = (double) tag[m];
+    } else if (instr.index == AV_MASS) {
+      if (atom->rmass) {
+        double *rmass = atom->rmass + ifirst;
+        for (m = 0; m < n; m++) out[m] = rmass[m];
+      } else {
+        double *mass = atom->mass;
+        int *type = atom->type + ifirst;
+        for (m = 0; m < n; m++) out[m] = mass[type[m]];
+      }
+    } else if (instr.index == AV_TYPE) {
+      int *type = atom->type + ifirst;
+      for (m = 0; m < n; m++) out[m] = (double) type[m];
+    } else if (instr.index == AV_MOL) {
+      tagint *molecule = atom->molecule + ifirst;
+      for (m = 0; m < n; m++) out[m] = (double) molecule[m];
+    } else if (instr.index == AV_RADIUS) {
+      double *radius = atom->radius + ifirst;
+      for (m = 0; m < n; m++) out[m] = radius[m];
+    } else if (instr.index == AV_Q) {
+      double *q = atom->q + ifirst;
+      for (m = 0; m < n; m++) out[m] = q[m];
+    } else {
+      double **array;
+      int dim = (instr.index - AV_X) % 3;
+      if (instr.index <= AV_Z) array = atom->x;
+      else if (instr.index <= AV_VZ) array = atom->v;
+      else array = atom->f;
+      for (m = 0; m < n; m++) out[m] = array[ifirst+m][dim];
+    }
+    break;
+  }
+
+  case ADD:
+    for (m = 0; m < n; m++) out[m] = a[m] + b[m];
+    break;
+  case SUBTRACT:
+    for (m = 0; m < n; m++) out[m] = a[m] - b[m];
+    break;
+  case MULTIPLY:
+    for (m = 0; m < n; m++) out[m] = a[m] * b[m];
+    break;
+  case DIVIDE:
+    for (m = 0; m < n; m++)
+      if (active[m] && b[m] == 0.0) error->one(FLERR,"Divide by 0 in variable formula");
+    for (m = 0; m < n; m++) out[m] = a[m] / b[m];
+    break;
+  case MODULO:
+    for (m = 0; m < n; m++)
+      if (active[m] && b[m] == 0.0) error->one(FLERR,"Modulo 0 in variable formula");
+    for (m = 0; m < n; m++) out[m] = fmod(a[m],b[m]);
+    break;
+  case CARAT:
+    for (m = 0; m < n; m++)
+      if (active[m] && b[m] == 0.0) error->one(FLERR,"Power by 0 in variable formula");
+    for (m = 0; m < n; m++) out[m] = pow(a[m],b[m]);
+    break;
+  case UNARY:
+    for (m = 0; m < n; m++) out[m] = -a[m];
+    break;
+  case NOT:
+    for (m = 0; m < n; m++) out[m] = (a[m] == 0.0) ? 1.0 : 0.0;
+    break;
+  case EQ:
+    for (m = 0; m < n; m++) out[m] = (a[m] == b[m]) ? 1.0 : 0.0;
+    break;
+  case NE:
+    for (m = 0; m < n; m++) out[m] = (a[m] != b[m]) ? 1.0 : 0.0;
+    break;
+  case LT:
+    for (m = 0; m < n; m++) out[m] = (a[m] < b[m]) ? 1.0 : 0.0;
+    break;
+  case LE:
+    for (m = 0; m < n; m++) out[m] = (a[m] <= b[m]) ? 1.0 : 0.0;
+    break;
+  case GT:
+    for (m = 0; m < n; m++) out[m] = (a[m] > b[m]) ? 1.0 : 0.0;
+    break;
+  case GE:
+    for (m = 0; m < n; m++) out[m] = (a[m] >= b[m]) ? 1.0 : 0.0;
+    break;
+  case AND:
+    for (m = 0; m < n; m++) out[m] = (a[m] != 0.0 && b[m] != 0.0) ? 1.0 : 0.0;
+    break;
+  case OR:
+    for (m = 0; m < n; m++) out[m] = (a[m] != 0.0 || b[m] != 0.0) ? 1.0 : 0.0;
+    break;
+  case XOR:
+    for (m = 0; m < n; m++)
+      out[m] = ((a[m] == 0.0 && b[m] != 0.0) || (a[m] != 0.0 && b[m] == 0.0)) ? 1.0 : 0.0;
+    break;
+
+  case SQRT:
+    for (m = 0; m < n; m++)
+      if (active[m] && a[m] < 0.0)
+        error->one(FLERR,"Sqrt of negative value in variable formula");
+    for (m = 0; m < n; m++) out[m] = sqrt(a[m]);
+    break;
+  case EXP:
+    for (m = 0; m < n; m++) out[m] = exp(a[m]);
+    break;
+  case LN:
+    for (m = 0; m < n; m++)
+      if (active[m] && a[m] <= 0.0)
+        error->one(FLERR,"Log of zero/negative value in variable formula");
+    for (m = 0; m < n; m++) out[m] = log(a[m]);
+    break;
+  case LOG:
+    for (m = 0; m < n; m++)
+      if (active[m] && a[m] <= 0.0)
+        error->one(FLERR,"Log of zero/negative value in variable formula");
+    for (m = 0; m < n; m++) out[m] = log10(a[m]);
+    break;
+  case ABS:
+    for (m = 0; m < n; m++) out[m] = fabs(a[m]);
+    break;
+  case SIN:
+    for (m = 0; m < n; m++) out[m] = sin(a[m]);
+    break;
+  case COS:
+    for (m = 0; m < n; m++) out[m] = cos(a[m]);
+    break;
+  case TAN:
+    for (m = 0; m < n; m++) out[m] = tan(a[m]);
+    break;
+  case ASIN:
+    for (m = 0; m < n; m++)
+      if (active[m] && (a[m] < -1.0 || a[m] > 1.0))
+        error->one(FLERR,"Arcsin of invalid value in variable formula");
+    for (m = 0; m < n; m++) out[m] = asin(a[m]);
+    break;
+  case ACOS:
+    for (m = 0; m < n; m++)
+      if (active[m] && (a[m] < -1.0 || a[m] > 1.0))
+        error->one(FLERR,"Arccos of invalid value in variable formula");
+    for (m = 0; m < n; m++) out[m] = acos(a[m]);
+    break;
+  case ATAN:
+    for (m = 0; m < n; m++) out[m] = atan(a[m]);
+    break;
+  case ATAN2:
+    for (m = 0; m < n; m++) out[m] = atan2(a[m],b[m]);
+    break;
+  case CEIL:
+    for (m = 0; m < n; m++) out[m] = ceil(a[m]);
+    break;
+  case FLOOR:
+    for (m = 0; m < n; m++) out[m] = floor(a[m]);
+    break;
+  case ROUND:
+    for (m = 0; m < n; m++) out[m] = MYROUND(a[m]);
+    break;
+  case RAMP:
+    if (update->whichflag == 0) {
+      for (m = 0; m < n; m++) out[m] = a[m];
+    } else {
+      double delta = update->ntimestep - update->beginstep;
+      if ((delta != 0.0) && (update->beginstep != update->endstep))
+        delta /= update->endstep - update->beginstep;
+      for (m = 0; m < n; m++) out[m] = a[m] + delta*(b[m]-a[m]);
+    }
+    break;
+  }
+}
+
 /* ----------------------------------------------------------------------
    find matching parenthesis in str, allocate contents = str between parens
    i = left paren
@@ -4386,6 +5133,7 @@ int Variable::special_function(const std::string &word, char *contents, Tree **t
           print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                           "initialization by a run",ivar);
         if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
+          ProfileScope prof(timer->profiler, compute);
           compute->compute_vector();
           compute->invoked_flag |= Compute::INVOKED_VECTOR;
         }
@@ -4398,6 +5146,7 @@ int Variable::special_function(const std::string &word, char *contents, Tree **t
           print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                           "initialization by a run",ivar);
         if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
+          ProfileScope prof(timer->profiler, compute);
           compute->compute_array();
           compute->invoked_flag |= Compute::INVOKED_ARRAY;
         }
@@ -4881,7 +5630,8 @@ void Variable::peratom2global(int flag, char *word, double *vector, int nstride,
         mine = atom->tag[index];
       } else if (strcmp(word,"mass") == 0) {
         if (atom->rmass) mine = atom->rmass[index];
-        else mine = atom->mass[atom->type[index]];
+        else if (atom->mass) mine = atom->mass[atom->type[index]];
+        else error->one(FLERR,"Variable uses atom property that isn't allocated");
       } else if (strcmp(word,"type") == 0) {
         mine = atom->type[index];
       } else if (strcmp(word,"mol") == 0) {
@@ -5027,6 +5777,8 @@ void Variable::atom_vector(char *word, Tree **tree, Tree **treestack, int &ntree
       newtree->nstride = 1;
       newtree->array = atom->rmass;
     } else {
+      if (!atom->mass)
+        error->one(FLERR,"Variable uses atom property 'mass' that isn't allocated");
       newtree->type = TYPEARRAY;
       newtree->array = atom->mass;
     }
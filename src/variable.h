@@ -129,6 +129,29 @@ class Variable : protected Pointers {
     }
   };
 
+  struct Instr {      // one instruction of a compiled formula
+    int op;           // operation, see enum{} in variable.cpp
+    int narg;         // # of operands
+    int arg[3];       // instructions that produce the operands
+    int index;        // atom vector or index into Program::words
+    int jvar;         // referenced variable, resolved before each evaluation
+    int peratom;      // 1 if result differs from atom to atom
+    double value;     // constant value
+  };
+
+  struct Program {                     // compiled equal-style or atom-style formula
+    int valid;                         // 1 if compiled, 0 if formula needs evaluate()
+    int result;                        // instruction that produces the final value
+    int needbox;                       // 1 if simulation box must exist
+    std::vector<Instr> code;           // instructions in evaluation order
+    std::vector<std::string> words;    // thermo keywords and variable names
+    std::vector<double> values;        // scalar result of each instruction
+    std::vector<double> block;         // per-atom results for one block of atoms
+
+    Program() : valid(0), result(-1), needbox(0) {}
+  };
+  Program **program;    // compiled formula of each variable, nullptr until first use
+
   int compute_python(int);
   void remove(int);
   void grow();
@@ -139,6 +162,13 @@ class Variable : protected Pointers {
   int size_tree_vector(Tree *);
   int compare_tree_vector(int, int);
   void free_tree(Tree *);
+  int compile(int);
+  int compile_formula(const std::string &, Program *, int);
+  int add_instr(Program *, int, int, int *, int, double);
+  double eval_instr(Program *, int, int, int);
+  double eval_program(int);
+  void eval_program_atom(int, int, double *, int, int);
+  void eval_block(Program *, int, int, int, int *);
   int find_matching_paren(char *, int, char *&, int);
   int math_function(char *, char *, Tree **, Tree **, int &, double *, int &, int);
   int group_function(char *, char *, Tree **, Tree **, int &, double *, int &, int);
@@ -81,9 +81,38 @@ void Verlet::init()
   if (atom->torque_flag) torqueflag = 1;
   if (atom->avec->forceclearflag) extraflag = 1;
 
+  // multiple time stepping of kspace forces is not supported by verlet/kk
+
+  if (lmp->kokkos && force->kspace && (force->kspace->nevery > 1))
+    error->all(FLERR,"Kspace_modify every is not supported by run style {}",
+               update->integrate_style);
+
   // orthogonal vs triclinic simulation box
 
   triclinic = domain->triclinic;
+
+  // overlap of forward comm with pair compute, if requested
+  // pair style must be able to run compute() on parts of its list
+  // no fix may need ghost coords before the pair compute,
+  //   and no neighbor list rows may be rebuilt between comm and pair
+  // kspace must not communicate while ghost coords are in flight,
+  //   which it does in compute_begin() with FFTs on a subset of procs
+
+  overlap = 0;
+  if (comm->overlap_flag) {
+    Pair *pair = force->pair;
+    KSpace *kspace = force->kspace;
+    int kspace_begin = 0;
+    if (kspace_compute_flag && (kspace->fft_nranks > 0) && (kspace->fft_nranks < comm->nprocs))
+      kspace_begin = 1;
+    if (pair && pair_compute_flag && pair->overlap_enable && !pair->cluster_flag &&
+        (pair->precision == Pair::PREC_DOUBLE) && !atom->soa_flag &&
+        !neighbor->partial_flag && !modify->n_pre_force && !kspace_begin)
+      overlap = 1;
+    else if (comm->me == 0)
+      error->warning(FLERR,"Comm_modify overlap is not supported with this pair style "
+                     "or these settings and is ignored");
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -149,8 +178,9 @@ void Verlet::setup(int flag)
 
   if (force->kspace) {
     force->kspace->setup();
-    if (kspace_compute_flag) force->kspace->compute(eflag,vflag);
-    else force->kspace->compute_dummy(eflag,vflag);
+    if (!kspace_compute_flag) force->kspace->compute_dummy(eflag,vflag);
+    else if (force->kspace->nevery > 1) force->kspace->compute_every(eflag,vflag,1);
+    else force->kspace->compute(eflag,vflag);
   }
 
   modify->setup_pre_reverse(eflag,vflag);
@@ -211,8 +241,9 @@ void Verlet::setup_minimal(int flag)
 
   if (force->kspace) {
     force->kspace->setup();
-    if (kspace_compute_flag) force->kspace->compute(eflag,vflag);
-    else force->kspace->compute_dummy(eflag,vflag);
+    if (!kspace_compute_flag) force->kspace->compute_dummy(eflag,vflag);
+    else if (force->kspace->nevery > 1) force->kspace->compute_every(eflag,vflag,1);
+    else force->kspace->compute(eflag,vflag);
   }
 
   modify->setup_pre_reverse(eflag,vflag);
@@ -265,8 +296,13 @@ void Verlet::run(int n)
 
     if (nflag == 0) {
       timer->stamp();
-      comm->forward_comm();
+      if (overlap) comm->forward_comm_start();
+      else comm->forward_comm();
       timer->stamp(Timer::COMM);
+      if (neighbor->partial_flag) {
+        neighbor->build_partial();
+        timer->stamp(Timer::NEIGH);
+      }
     } else {
       if (n_pre_exchange) {
         timer->stamp();
@@ -312,8 +348,28 @@ void Verlet::run(int n)
       timer->stamp(Timer::MODIFY);
     }
 
+    // kspace may start its solve here, so that it can proceed on
+    //   a subset of procs while the other procs compute pair forces
+    // with kspace_modify every, only on steps with kspace forces, which
+    //   always need global energy/virial, see KSpace::compute_every()
+
+    if (kspace_compute_flag && (ntimestep % force->kspace->nevery == 0)) {
+      if (force->kspace->nevery > 1)
+        force->kspace->compute_begin(eflag | ENERGY_GLOBAL,vflag | VIRIAL_PAIR);
+      else force->kspace->compute_begin(eflag,vflag);
+      timer->stamp(Timer::KSPACE);
+    }
+
+    // with overlap, interior atoms are computed while ghost coords are in flight
+
     if (pair_compute_flag) {
-      force->pair->compute(eflag,vflag);
+      if (overlap && nflag == 0) {
+        force->pair->compute_interior(eflag,vflag);
+        timer->stamp(Timer::PAIR);
+        comm->forward_comm_finish();
+        timer->stamp(Timer::COMM);
+        force->pair->compute_boundary(eflag,vflag);
+      } else force->pair->compute(eflag,vflag);
       timer->stamp(Timer::PAIR);
     }
 
@@ -326,7 +382,8 @@ void Verlet::run(int n)
     }
 
     if (kspace_compute_flag) {
-      force->kspace->compute(eflag,vflag);
+      if (force->kspace->nevery > 1) force->kspace->compute_every(eflag,vflag,0);
+      else force->kspace->compute(eflag,vflag);
       timer->stamp(Timer::KSPACE);
     }
 
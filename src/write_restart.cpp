@@ -32,10 +32,13 @@
 #include "neighbor.h"
 #include "output.h"
 #include "pair.h"
+#include "restart_delta.h"
+#include "restart_mpiio.h"
 #include "thermo.h"
 #include "update.h"
 
 #include <cstring>
+#include <vector>
 
 #include "lmprestart.h"
 
@@ -50,6 +53,27 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
   multiproc = 0;
   noinit = 0;
   fp = nullptr;
+
+  mpiioflag = asyncflag = 0;
+  naggregate = 0;
+  mpiio = nullptr;
+  iobuf = nullptr;
+  ioend = 0;
+
+  delta_every = 0;
+  quantum = 0.0;
+  deltawrite = 0;
+  nwrite = 0;
+  delta = nullptr;
+  baseoffset = basesize = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+WriteRestart::~WriteRestart()
+{
+  if (mpiio) finish_mpiio(0);
+  delete delta;
 }
 
 /* ----------------------------------------------------------------------
@@ -80,6 +104,8 @@ void WriteRestart::command(int narg, char **arg)
   // also called by Output class for periodic restart files
 
   multiproc_options(multiproc,narg-1,&arg[1]);
+  if (delta_every)
+    error->all(FLERR,"Write_restart delta can only be used with the restart command");
 
   // init entire system since comm->exchange is done
   // comm::init needs neighbor::init needs pair::init needs kspace::init, etc
@@ -109,8 +135,11 @@ void WriteRestart::command(int narg, char **arg)
   }
 
   // write single restart file
+  // an asynchronous MPI-IO write is completed right away, since
+  //   there is no run that could continue while it is in progress
 
   write(file);
+  if (mpiio) finish_mpiio(1);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -176,11 +205,53 @@ void WriteRestart::multiproc_options(int multiproc_caller, int narg, char **arg)
       else filewriter = 0;
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"mpiio") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "write_restart mpiio", error);
+      mpiioflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+
+    } else if (strcmp(arg[iarg],"aggregators") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "write_restart aggregators", error);
+      naggregate = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (naggregate <= 0)
+        error->all(FLERR,"Invalid write_restart aggregators value {}", naggregate);
+      iarg += 2;
+
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "write_restart async", error);
+      asyncflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+
+    } else if (strcmp(arg[iarg],"delta") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "write_restart delta", error);
+      delta_every = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (delta_every <= 0)
+        error->all(FLERR,"Invalid write_restart delta value {}", delta_every);
+      iarg += 2;
+
+    } else if (strcmp(arg[iarg],"quantize") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "write_restart quantize", error);
+      quantum = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      if (quantum <= 0.0)
+        error->all(FLERR,"Invalid write_restart quantize value {}", quantum);
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"noinit") == 0) {
       noinit = 1;
       iarg++;
     } else error->all(FLERR,"Unknown write_restart keyword: {}", arg[iarg]);
   }
+
+  if (mpiioflag && multiproc)
+    error->all(FLERR,"Cannot use write_restart mpiio with % in restart file name");
+  if ((naggregate || asyncflag) && !mpiioflag)
+    error->all(FLERR,"Write_restart aggregators and async require mpiio yes");
+  if (delta_every && (multiproc || mpiioflag))
+    error->all(FLERR,"Write_restart delta cannot be used with % in file name or mpiio");
+  if (delta_every && !atom->tag_enable)
+    error->all(FLERR,"Write_restart delta requires atom IDs");
+  if ((quantum > 0.0) && !delta_every)
+    error->all(FLERR,"Write_restart quantize requires delta");
 }
 
 /* ----------------------------------------------------------------------
@@ -199,6 +270,19 @@ void WriteRestart::write(const std::string &file)
 
   if (neighbor->build_once) domain->reset_box();
 
+  // a previous asynchronous write must be complete before starting a new one
+
+  if (mpiio) finish_mpiio(1);
+
+  // with delta, write a full base file every delta_every writes
+  // in between write files with atom data relative to the last base file
+
+  deltawrite = 0;
+  if (delta_every) {
+    if (nwrite % delta_every) deltawrite = 1;
+    nwrite++;
+  }
+
   // natoms = sum of nlocal = value to write into restart file
   // if unequal and thermo lostflag is "error", don't write restart file
 
@@ -259,12 +343,24 @@ void WriteRestart::write(const std::string &file)
   file_layout(send_size);
 
   // header info is complete
+  // if MPI-IO output:
+  //   close header file, per-proc data is written directly after it
   // if multiproc output:
   //   close header file, open multiname file on each writing proc,
   //   write PROCSPERFILE into new file
 
   int io_error = 0;
-  if (multiproc) {
+  bigint headersize = 0;
+  if (mpiioflag) {
+    if (me == 0) {
+      headersize = platform::ftell(fp);
+      if (ferror(fp)) io_error = 1;
+      fclose(fp);
+      fp = nullptr;
+    }
+    MPI_Bcast(&headersize,1,MPI_LMP_BIGINT,0,world);
+
+  } else if (multiproc) {
     if (me == 0 && fp) {
       magic_string();
       if (ferror(fp)) io_error = 1;
@@ -338,6 +434,38 @@ void WriteRestart::write(const std::string &file)
     }
   }
 
+  // for a base file, keep the packed atom data as reference
+  // for a delta file, encode atom data relative to it
+  //   encoded size is stored in 1st value, followed by the bytes
+
+  if (delta_every) {
+    if (!delta) delta = new RestartDelta(lmp);
+
+    if (!deltawrite) {
+      delta->clear();
+      delta->add_reference(n,buf,1,0);
+      basefile = file;
+      bigint nbig = n;
+      MPI_Allreduce(&nbig,&basesize,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
+    } else {
+      std::vector<char> bytes;
+      delta->encode(n,buf,quantum,bytes);
+      bigint nbytes = bytes.size();
+      send_size = 1 + (nbytes + sizeof(double) - 1) / sizeof(double);
+      MPI_Allreduce(&send_size,&max_size,1,MPI_INT,MPI_MAX,world);
+      memory->destroy(buf);
+      memory->create(buf,max_size,"write_restart:buf");
+      memset(buf,0,max_size*sizeof(double));
+      buf[0] = ubuf(nbytes).d;
+      if (nbytes) memcpy(&buf[1],bytes.data(),nbytes);
+    }
+  }
+
+  // output of single MPI-IO file
+  // all procs write their data at offsets following the header
+  // with async, keep buffer until write completes at next write or deletion
+  // else
   // output of one or more native files
   // filewriter = 1 = this proc writes to file
   // ping each proc in my cluster, receive its data, write data to file
@@ -345,7 +473,25 @@ void WriteRestart::write(const std::string &file)
 
   int tmp,recv_size;
 
-  if (filewriter) {
+  if (mpiioflag) {
+    bigint nbig = send_size;
+    bigint nbefore,ntotal;
+    MPI_Scan(&nbig,&nbefore,1,MPI_LMP_BIGINT,MPI_SUM,world);
+    MPI_Allreduce(&nbig,&ntotal,1,MPI_LMP_BIGINT,MPI_SUM,world);
+    nbefore -= nbig;
+
+    iofile = file;
+    ioend = headersize + ntotal*sizeof(double);
+    mpiio = new RestartMPIIO(lmp);
+    mpiio->open_write(file,naggregate);
+    mpiio->write(headersize + nbefore*sizeof(double),send_size,buf,asyncflag);
+
+    if (mpiio->pending) {
+      iobuf = buf;
+      buf = nullptr;
+    } else finish_mpiio(1);
+
+  } else if (filewriter) {
     MPI_Status status;
     MPI_Request request;
     for (int iproc = 0; iproc < nclusterprocs; iproc++) {
@@ -549,15 +695,87 @@ void WriteRestart::force_fields()
    all procs call this method, only proc 0 writes to file
 ------------------------------------------------------------------------- */
 
-void WriteRestart::file_layout(int /*send_size*/)
+void WriteRestart::file_layout(int send_size)
 {
   if (me == 0) write_int(MULTIPROC,multiproc);
 
+  // with MPI-IO, per-proc data follows the header without flags
+  // so store the size of each proc's chunk, which allows a
+  //   different # of procs to compute file offsets and read it in parallel
+
+  if (mpiioflag) {
+    int *sizes = nullptr;
+    if (me == 0) {
+      memory->create(sizes,nprocs,"write_restart:sizes");
+      write_int(MPIIO,mpiioflag);
+    }
+    MPI_Gather(&send_size,1,MPI_INT,sizes,1,MPI_INT,0,world);
+    if (me == 0) fwrite(sizes,sizeof(int),nprocs,fp);
+    memory->destroy(sizes);
+  }
+
+  // for a delta file, store name of base file and where its atom data is
+  // for a base file, per-proc data will start after the end of the layout
+
+  if (me == 0 && deltawrite) {
+    write_string(DELTA,basefile);
+    fwrite(&baseoffset,sizeof(bigint),1,fp);
+    fwrite(&basesize,sizeof(bigint),1,fp);
+    fwrite(&quantum,sizeof(double),1,fp);
+  }
+
   // -1 flag signals end of file layout info
 
   if (me == 0) {
     int flag = -1;
     fwrite(&flag,sizeof(int),1,fp);
+    if (delta_every && !deltawrite) baseoffset = platform::ftell(fp);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   complete a pending asynchronous MPI-IO write
+   called at the end of a run, so the file is complete when it returns
+------------------------------------------------------------------------- */
+
+void WriteRestart::finish()
+{
+  if (mpiio) finish_mpiio(1);
+}
+
+/* ----------------------------------------------------------------------
+   complete MPI-IO output of per-proc data and close the file
+   proc 0 then appends the magic string, so that a file with
+     missing data is detected as incomplete by read_restart
+   report = 0 when called from destructor, then do not raise errors
+------------------------------------------------------------------------- */
+
+void WriteRestart::finish_mpiio(int report)
+{
+  int io_error = mpiio->wait();
+  mpiio->close();
+  delete mpiio;
+  mpiio = nullptr;
+  memory->destroy(iobuf);
+
+  int io_all = 0;
+  MPI_Allreduce(&io_error,&io_all,1,MPI_INT,MPI_MAX,world);
+  if (io_all) {
+    if (report) error->all(FLERR,"I/O error while writing restart");
+    return;
+  }
+
+  if (me == 0) {
+    fp = fopen(iofile.c_str(),"r+b");
+    if (fp) {
+      platform::fseek(fp,ioend);
+      magic_string();
+      if (ferror(fp)) io_error = 1;
+      fclose(fp);
+      fp = nullptr;
+    } else io_error = 1;
+    if (io_error && report)
+      error->one(FLERR,"Cannot complete restart file {}: {}",iofile,utils::getsyserror());
   }
 }
 
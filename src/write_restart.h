@@ -27,9 +27,13 @@ namespace LAMMPS_NS {
 class WriteRestart : public Command {
  public:
   WriteRestart(class LAMMPS *);
+  ~WriteRestart() override;
   void command(int, char **) override;
   void multiproc_options(int, int, char **);
   void write(const std::string &);
+  void finish();    // complete a pending asynchronous MPI-IO write
+
+  int delta_every;    // write a full base file every this many files, 0 = always
 
  private:
   int me, nprocs;
@@ -44,10 +48,27 @@ class WriteRestart : public Command {
   int fileproc;         // ID of proc in my cluster who writes to file
   int icluster;         // which cluster I am in
 
+  int mpiioflag;                 // 1 = write single file with collective MPI-IO
+  int naggregate;                // # of procs doing MPI-IO file access, 0 = default
+  int asyncflag;                 // 1 = MPI-IO write completes while run continues
+  class RestartMPIIO *mpiio;     // pending MPI-IO output, nullptr if none
+  double *iobuf;                 // data of pending asynchronous write
+  std::string iofile;            // name of file being written with MPI-IO
+  bigint ioend;                  // file offset after per-proc data
+
+  double quantum;                // precision of coords in delta files, 0.0 = exact
+  int deltawrite;                // 1 if file being written is a delta file
+  int nwrite;                    // # of files written with delta settings
+  class RestartDelta *delta;     // atom data of last base file
+  std::string basefile;          // name of last base file
+  bigint baseoffset;             // file offset of per-proc data in base file
+  bigint basesize;               // # of values in per-proc data of base file
+
   void header();
   void type_arrays();
   void force_fields();
   void file_layout(int);
+  void finish_mpiio(int);
 
   void magic_string();
   void endian();
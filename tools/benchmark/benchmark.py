@@ -0,0 +1,308 @@
+#!/usr/bin/env python3
+# Utility for running a matrix of LAMMPS benchmarks and detecting
+# performance regressions by comparing against stored baselines
+#
+# Run "benchmark.py -h" for a description of the command line.
+# The matrix of inputs is in benchmarks.yaml next to this script.
+from __future__ import print_function
+import sys
+
+if sys.version_info.major < 3:
+    sys.exit('This script must be run with Python 3.6 or later')
+
+if sys.version_info.minor < 6:
+    sys.exit('This script must be run with Python 3.6 or later')
+
+import os
+import re
+import json
+import shlex
+import shutil
+import argparse
+import datetime
+import platform
+import subprocess
+
+try:
+    import yaml
+except ImportError:
+    sys.exit('This script requires the PyYAML module')
+
+SCRIPT_DIR = os.path.dirname(os.path.realpath(__file__))
+LAMMPS_DIR = os.path.realpath(os.path.join(SCRIPT_DIR, '..', '..'))
+DEFAULT_MATRIX = os.path.join(SCRIPT_DIR, 'benchmarks.yaml')
+
+# sections of the "MPI task timing breakdown" in the log file
+
+SECTIONS = ['Pair', 'Bond', 'Kspace', 'Neigh', 'Comm', 'Output', 'Modify', 'Sync', 'Other']
+
+LOOP_RE = re.compile(r'^Loop time of (\S+) on (\d+) procs for (\d+) steps with (\d+) atoms')
+SECTION_RE = re.compile(r'^(\w+)\s*\|\s*(\S*)\s*\|\s*(\S+)\s*\|')
+
+
+def installed_packages(lmp):
+    """return set of packages installed in the LAMMPS executable"""
+    out = subprocess.run(lmp + ['-h'], stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                         universal_newlines=True).stdout
+    packages = set()
+    found = False
+    for line in out.splitlines():
+        if line.startswith('Installed packages:'):
+            found = True
+            continue
+        if found:
+            if not line.strip():
+                if packages:
+                    break
+                continue
+            packages.update(line.split())
+    return packages
+
+
+def parse_log(logfile):
+    """sum loop time and section times over all runs in a log file"""
+    result = {'loop': 0.0, 'steps': 0, 'atoms': 0, 'procs': 0, 'sections': {}}
+    nruns = 0
+    in_breakdown = False
+    with open(logfile) as f:
+        for line in f:
+            m = LOOP_RE.match(line)
+            if m:
+                nruns += 1
+                result['loop'] += float(m.group(1))
+                result['procs'] = int(m.group(2))
+                result['steps'] += int(m.group(3))
+                result['atoms'] = int(m.group(4))
+                continue
+            if line.startswith('MPI task timing breakdown'):
+                in_breakdown = True
+                continue
+            if in_breakdown:
+                if not line.strip():
+                    in_breakdown = False
+                    continue
+                m = SECTION_RE.match(line)
+                if m and m.group(1) in SECTIONS:
+                    sections = result['sections']
+                    sections[m.group(1)] = sections.get(m.group(1), 0.0) + float(m.group(3))
+    if nruns == 0:
+        return None
+    return result
+
+
+def setup_rundir(args, name, inputfile):
+    """create the folder of a benchmark in the work folder with copies of
+    the files next to its input, which the input may read, so that the
+    files written by a run do not end up in the source tree"""
+    rundir = os.path.join(args.workdir, name)
+    os.makedirs(rundir, exist_ok=True)
+    srcdir = os.path.dirname(inputfile)
+    for entry in os.listdir(srcdir):
+        src = os.path.join(srcdir, entry)
+        dst = os.path.join(rundir, entry)
+        if os.path.isfile(src) and not os.path.exists(dst):
+            shutil.copy(src, dst)
+    return rundir
+
+
+def run_case(args, lmp, name, entry, nprocs, nthreads):
+    """run one benchmark and return the parsed log of its fastest repeat,
+    or None if all repeats failed"""
+    inputfile = os.path.join(LAMMPS_DIR, entry['input'])
+    rundir = setup_rundir(args, name, inputfile)
+    tag = '{}.np{}x{}'.format(name, nprocs, nthreads)
+
+    cmd = []
+    if args.mpiexec:
+        cmd += [args.mpiexec, args.mpiexec_numproc_flag, str(nprocs)]
+        cmd += shlex.split(args.mpiexec_flags)
+    cmd += lmp + ['-in', inputfile, '-screen', 'none', '-echo', 'none', '-nocite']
+    for key, value in entry.get('vars', {}).items():
+        cmd += ['-var', str(key), str(value)]
+    env = dict(os.environ)
+    env['OMP_NUM_THREADS'] = str(nthreads)
+    if nthreads > 1:
+        cmd += ['-sf', 'omp', '-pk', 'omp', str(nthreads)]
+
+    best = None
+    nfailed = 0
+    for i in range(args.repeat):
+        logfile = os.path.join(args.workdir, '{}.{}.log'.format(tag, i))
+        proc = subprocess.run(cmd + ['-log', logfile], cwd=rundir, env=env,
+                              stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                              universal_newlines=True)
+        result = parse_log(logfile) if os.path.exists(logfile) else None
+        if proc.returncode != 0 or result is None:
+            print('{:<28s} FAILED (exit code {}), see {}'.format(tag, proc.returncode, logfile))
+            if proc.stdout:
+                print(proc.stdout.strip()[-2000:])
+            nfailed += 1
+            continue
+        if best is None or result['loop'] < best['loop']:
+            best = result
+
+    # keep the timings of the successful repeats, but record the failures
+
+    if best is not None and nfailed:
+        best['failed_repeats'] = nfailed
+    return best
+
+
+def run_matrix(args):
+    """run all benchmarks of the matrix and return results keyed by case"""
+    # benchmarks run in their own folder in the work folder, so paths must be absolute
+
+    lmp = shlex.split(args.lmp)
+    if os.sep in lmp[0]:
+        lmp[0] = os.path.abspath(lmp[0])
+    args.workdir = os.path.abspath(args.workdir)
+    with open(args.matrix) as f:
+        matrix = yaml.safe_load(f)
+    ranks = args.ranks if args.ranks else matrix.get('ranks', [1])
+    threads = args.threads if args.threads else matrix.get('threads', [1])
+    if args.mpiexec is None and max(ranks) > 1:
+        sys.exit('Runs on more than one MPI rank require the --mpiexec option')
+
+    packages = installed_packages(lmp)
+    if max(threads) > 1 and 'OPENMP' not in packages:
+        print('OPENMP package is not installed, skipping runs with more than 1 thread')
+        threads = [t for t in threads if t == 1]
+
+    os.makedirs(args.workdir, exist_ok=True)
+    results = {}
+    for name, entry in matrix['benchmarks'].items():
+        if args.only and not any(re.search(p, name) for p in args.only):
+            continue
+        missing = [p for p in entry.get('packages', []) if p not in packages]
+        if missing:
+            print('{:<28s} skipped, missing packages: {}'.format(name, ' '.join(missing)))
+            continue
+        missing = [f for f in entry.get('files', [entry['input']])
+                   if not os.path.exists(os.path.join(LAMMPS_DIR, f))]
+        if missing:
+            print('{:<28s} skipped, missing files: {}'.format(name, ' '.join(missing)))
+            continue
+        for nprocs in entry.get('ranks', ranks):
+            for nthreads in threads:
+                if nthreads > 1 and not entry.get('omp', True):
+                    continue
+                tag = '{}.np{}x{}'.format(name, nprocs, nthreads)
+                result = run_case(args, lmp, name, entry, nprocs, nthreads)
+                if result is None:
+                    results[tag] = {'failed': True}
+                    continue
+                print('{:<28s} {:10.4g} s for {} steps with {} atoms'.format(
+                    tag, result['loop'], result['steps'], result['atoms']))
+                if result.get('failed_repeats'):
+                    print('{:<28s} {} of {} repeats FAILED'.format(tag, result['failed_repeats'],
+                                                                  args.repeat))
+                results[tag] = result
+    return results
+
+
+def compare(results, baseline, args):
+    """compare results against baseline, return # of regressions"""
+    nregress = 0
+    print('\n{:<28s} | {:>10s} | {:>10s} | {:>7s} | {}'.format('Case', 'baseline', 'current',
+                                                               'change', 'status'))
+    print('-' * 80)
+    for tag, cur in results.items():
+        ref = baseline.get(tag)
+        if ref is None or ref.get('failed'):
+            print('{:<28s} | {:>10s} | {:>10s} | {:>7s} | no baseline'.format(tag, '', '', ''))
+            continue
+        if cur.get('failed'):
+            print('{:<28s} | {:>10.4g} | {:>10s} | {:>7s} | FAILED'.format(tag, ref['loop'], '',
+                                                                          ''))
+            nregress += 1
+            continue
+        if cur['steps'] != ref['steps'] or cur['atoms'] != ref['atoms']:
+            print('{:<28s} | {:>10.4g} | {:>10.4g} | {:>7s} | different problem size'.format(
+                tag, ref['loop'], cur['loop'], ''))
+            continue
+
+        change = cur['loop'] / ref['loop'] - 1.0 if ref['loop'] > 0.0 else 0.0
+        status = []
+        if cur.get('failed_repeats'):
+            status.append('{} repeats FAILED'.format(cur['failed_repeats']))
+        if change > args.threshold:
+            status.append('REGRESSION')
+
+        # only check sections that take a relevant fraction of the loop time
+
+        for section, reftime in ref['sections'].items():
+            curtime = cur['sections'].get(section)
+            if curtime is None or reftime < args.min_fraction * ref['loop']:
+                continue
+            schange = curtime / reftime - 1.0 if reftime > 0.0 else 0.0
+            if schange > args.section_threshold:
+                status.append('{} {:+.1f}%'.format(section, 100.0 * schange))
+        if status:
+            nregress += 1
+        print('{:<28s} | {:>10.4g} | {:>10.4g} | {:>+6.1f}% | {}'.format(
+            tag, ref['loop'], cur['loop'], 100.0 * change, ' '.join(status) if status else 'ok'))
+    return nregress
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run LAMMPS benchmarks and compare the '
+                                     'timings against a stored baseline')
+    parser.add_argument('--lmp', required=True, help='LAMMPS executable, may include flags')
+    parser.add_argument('--matrix', default=DEFAULT_MATRIX, help='YAML file with benchmarks')
+    parser.add_argument('--mpiexec', default=None, help='MPI launcher for runs with >1 rank')
+    parser.add_argument('--mpiexec-numproc-flag', default='-np', help='flag for # of ranks')
+    parser.add_argument('--mpiexec-flags', default='', help='extra flags for the MPI launcher')
+    parser.add_argument('--ranks', type=int, nargs='+', help='list of MPI rank counts')
+    parser.add_argument('--threads', type=int, nargs='+', help='list of OpenMP thread counts')
+    parser.add_argument('--only', nargs='+', help='only run benchmarks matching these regexes')
+    parser.add_argument('--repeat', type=int, default=1,
+                        help='run each case this many times and keep the fastest')
+    parser.add_argument('--workdir', default=os.path.join(os.getcwd(), 'benchmark'),
+                        help='directory for log files and results')
+    parser.add_argument('--baseline', help='JSON file with baseline results')
+    parser.add_argument('--save-baseline', action='store_true',
+                        help='store results as new baseline instead of comparing')
+    parser.add_argument('--threshold', type=float, default=0.10,
+                        help='max allowed relative increase of the loop time')
+    parser.add_argument('--section-threshold', type=float, default=0.25,
+                        help='max allowed relative increase of a timer section')
+    parser.add_argument('--min-fraction', type=float, default=0.05,
+                        help='only check sections taking at least this fraction of the loop')
+    args = parser.parse_args()
+
+    if args.repeat < 1:
+        sys.exit('Number of repeats must be at least 1')
+
+    results = run_matrix(args)
+
+    data = {'date': datetime.datetime.now().isoformat(timespec='seconds'),
+            'host': platform.node(), 'lmp': args.lmp, 'results': results}
+    outfile = os.path.join(args.workdir, 'results.json')
+    with open(outfile, 'w') as f:
+        json.dump(data, f, indent=2, sort_keys=True)
+    print('Results written to', outfile)
+
+    if not args.baseline:
+        return 0
+
+    if args.save_baseline:
+        with open(args.baseline, 'w') as f:
+            json.dump(data, f, indent=2, sort_keys=True)
+        print('Baseline written to', args.baseline)
+        return 0
+
+    if not os.path.exists(args.baseline):
+        print('Baseline file {} does not exist, nothing to compare'.format(args.baseline))
+        return 0
+    with open(args.baseline) as f:
+        baseline = json.load(f)['results']
+    nregress = compare(results, baseline, args)
+    if nregress:
+        print('\n{} benchmark(s) with performance regressions'.format(nregress))
+        return 1
+    print('\nNo performance regressions')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -4,6 +4,7 @@
 
 #include <cinttypes>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -60,6 +61,55 @@ static void callback(void *handle, step_t timestep, int nlocal, tag_t *, double
     delete[] vatom[0];
     delete[] vatom;
 }
+
+// copy of the data passed to the fix insitu callback on its last invocation
+
+struct insitu_data {
+    std::vector<step_t> steps;
+    int nlocal, groupbit, nview, ngroup;
+    double sublo[3], subhi[3];
+    std::vector<std::string> names;
+    std::vector<int> datatypes, ncols, strides;
+    std::vector<tag_t> ids;
+    std::vector<double> x;
+};
+
+static void insitu_callback(void *ptr, const lammps_insitu_frame *frame)
+{
+    auto data = (insitu_data *)ptr;
+    data->steps.push_back(frame->timestep);
+    data->nlocal   = frame->nlocal;
+    data->groupbit = frame->groupbit;
+    data->nview    = frame->nview;
+    for (int k = 0; k < 3; ++k) {
+        data->sublo[k] = frame->sublo[k];
+        data->subhi[k] = frame->subhi[k];
+    }
+
+    data->names.clear();
+    data->datatypes.clear();
+    data->ncols.clear();
+    data->strides.clear();
+    for (int m = 0; m < frame->nview; ++m) {
+        data->names.emplace_back(frame->views[m].name);
+        data->datatypes.push_back(frame->views[m].datatype);
+        data->ncols.push_back(frame->views[m].ncol);
+        data->strides.push_back(frame->views[m].stride);
+    }
+
+    // views are: id x mask
+
+    auto id   = (const tag_t *)frame->views[0].data;
+    auto x    = (const double *)frame->views[1].data;
+    auto mask = (const int *)frame->views[2].data;
+    data->ids.assign(id, id + frame->nlocal);
+    data->x.clear();
+    data->ngroup = 0;
+    for (int i = 0; i < frame->nlocal; ++i) {
+        data->x.push_back(x[i * frame->views[1].stride + 1]);
+        if (mask[i * frame->views[2].stride] & frame->groupbit) ++data->ngroup;
+    }
+}
 }
 
 TEST(lammps_external, callback)
@@ -198,3 +248,101 @@ TEST(lammps_external, array)
     output = ::testing::internal::GetCapturedStdout();
     if (verbose) std::cout << output;
 }
+
+static void run_insitu(const char *box, insitu_data &data, std::vector<double> &ycoord)
+{
+    const char *args[] = {"liblammps", "-log", "none", "-nocite", nullptr};
+    char **argv        = (char **)args;
+    int argc           = (sizeof(args) / sizeof(char *)) - 1;
+
+    ::testing::internal::CaptureStdout();
+    void *handle       = lammps_open_no_mpi(argc, argv, nullptr);
+    std::string output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+
+    ::testing::internal::CaptureStdout();
+    lammps_command(handle, "lattice sc 1.0");
+    lammps_command(handle, box);
+    lammps_commands_string(handle, "create_box 1 box\n"
+                                   "create_atoms 1 box\n"
+                                   "mass 1 1.0\n"
+                                   "pair_style zero 0.1\n"
+                                   "pair_coeff 1 1\n"
+                                   "velocity all set 0.1 0.2 -0.1\n"
+                                   "group half id <= 4\n"
+                                   "fix 1 all nve\n"
+                                   "fix ins half insitu 5 id x mask\n");
+    lammps_set_fix_insitu_callback(handle, "ins", &insitu_callback, &data);
+    lammps_command(handle, "run 10 post no");
+    output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+
+    // final coords, which the callback saw at step 10
+
+    int nlocal = *(int *)lammps_extract_global(handle, "nlocal");
+    auto x     = (double **)lammps_extract_atom(handle, "x");
+    auto id    = (tag_t *)lammps_extract_atom(handle, "id");
+    ycoord.assign(nlocal, 0.0);
+    for (int i = 0; i < nlocal; ++i)
+        ycoord[id[i] - 1] = x[i][1];
+
+    ::testing::internal::CaptureStdout();
+    lammps_close(handle);
+    output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+}
+
+static void check_insitu(const insitu_data &data, const std::vector<double> &ycoord)
+{
+    ASSERT_EQ(data.steps.size(), 3);
+    EXPECT_EQ(data.steps[0], 0);
+    EXPECT_EQ(data.steps[1], 5);
+    EXPECT_EQ(data.steps[2], 10);
+    EXPECT_EQ(data.nlocal, 8);
+    EXPECT_EQ(data.groupbit, 1 << 1);
+    EXPECT_EQ(data.ngroup, 4);
+
+    ASSERT_EQ(data.nview, 3);
+    EXPECT_EQ(data.names[0], "id");
+    EXPECT_EQ(data.names[1], "x");
+    EXPECT_EQ(data.names[2], "mask");
+    EXPECT_EQ(data.datatypes[0], (sizeof(tag_t) == 8) ? LAMMPS_INT64 : LAMMPS_INT);
+    EXPECT_EQ(data.datatypes[1], LAMMPS_DOUBLE);
+    EXPECT_EQ(data.datatypes[2], LAMMPS_INT);
+    EXPECT_EQ(data.ncols[0], 1);
+    EXPECT_EQ(data.ncols[1], 3);
+    EXPECT_EQ(data.strides[0], 1);
+    EXPECT_EQ(data.strides[1], 3);
+
+    ASSERT_EQ(data.ids.size(), 8);
+    for (int i = 0; i < 8; ++i)
+        EXPECT_DOUBLE_EQ(data.x[i], ycoord[data.ids[i] - 1]);
+}
+
+TEST(lammps_insitu, callback)
+{
+    insitu_data data;
+    std::vector<double> ycoord;
+    run_insitu("region box block -1 1 -1 1 -1 1", data, ycoord);
+    check_insitu(data, ycoord);
+    for (int k = 0; k < 3; ++k) {
+        EXPECT_DOUBLE_EQ(data.sublo[k], -1.0);
+        EXPECT_DOUBLE_EQ(data.subhi[k], 1.0);
+    }
+}
+
+TEST(lammps_insitu, triclinic)
+{
+    // bounds are the bounding box of the subdomain in box coords
+
+    insitu_data data;
+    std::vector<double> ycoord;
+    run_insitu("region box prism -1 1 -1 1 -1 1 0.5 -0.25 0.0", data, ycoord);
+    check_insitu(data, ycoord);
+    EXPECT_DOUBLE_EQ(data.sublo[0], -1.25);
+    EXPECT_DOUBLE_EQ(data.subhi[0], 1.5);
+    EXPECT_DOUBLE_EQ(data.sublo[1], -1.0);
+    EXPECT_DOUBLE_EQ(data.subhi[1], 1.0);
+    EXPECT_DOUBLE_EQ(data.sublo[2], -1.0);
+    EXPECT_DOUBLE_EQ(data.subhi[2], 1.0);
+}
@@ -0,0 +1,243 @@
+// unit tests for comm_modify options that change how ghost atoms are communicated across MPI ranks
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include "variable.h"
+
+#include "fmt/format.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/systems/charged.h"
+#include "../testing/test_mpi_main.h"
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+using TestSystems::by_id;
+
+namespace LAMMPS_NS {
+
+class CommMPITest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+    std::string output;
+
+    void SetUp() override
+    {
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // LJ liquid with a neighbor list rebuild every 10 steps, so that a run
+    // has steps with and without reneighboring
+
+    void lj_system()
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("units lj");
+        command("atom_style atomic");
+        command("atom_modify map array");
+        command("lattice fcc 0.8442");
+        command("region box block 0 6 0 6 0 6");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("neighbor 0.3 bin");
+        command("neigh_modify every 10 delay 0 check no");
+        command("fix 1 all nve");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // salt-like system of charges with PPPM
+
+    void charged_system()
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        TestSystems::charged_system(lmp, "block 0 6 0 6 0 6", 1.0e-4);
+        command("neigh_modify every 10 delay 0 check no");
+        command("fix 1 all nve");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // positions and forces of all atoms ordered by ID, then energy and pressure
+
+    std::vector<double> run(const std::string &modify, int nsteps)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("comm_modify " + modify);
+        command(fmt::format("run {} post no", nsteps));
+        if (!verbose) output = ::testing::internal::GetCapturedStdout();
+
+        auto all = by_id(lmp, lmp->atom->x);
+        auto f   = by_id(lmp, lmp->atom->f);
+        all.insert(all.end(), f.begin(), f.end());
+        all.push_back(lmp->input->variable->compute_equal("pe"));
+        all.push_back(lmp->input->variable->compute_equal("press"));
+        return all;
+    }
+
+    // ghost atom counts of all ranks
+
+    std::vector<int> nghost_all()
+    {
+        std::vector<int> all(lmp->comm->nprocs);
+        MPI_Allgather(&lmp->atom->nghost, 1, MPI_INT, all.data(), 1, MPI_INT, lmp->world);
+        return all;
+    }
+
+    void reset()
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    static void compare(const std::vector<double> &ref, const std::vector<double> &val)
+    {
+        ASSERT_EQ(ref.size(), val.size());
+        for (std::size_t i = 0; i < ref.size(); i++)
+            ASSERT_NEAR(val[i], ref[i], 1.0e-10 * (1.0 + fabs(ref[i])));
+    }
+};
+
+TEST_F(CommMPITest, overlap)
+{
+    // pair lj/cut computes interior atoms while ghost coords are in flight
+
+    lj_system();
+    auto ref = run("overlap no", 25);
+    reset();
+    lj_system();
+    auto val = run("overlap yes", 25);
+    if (!verbose) EXPECT_THAT(output, Not(HasSubstr("Comm_modify overlap is not supported")));
+    compare(ref, val);
+}
+
+TEST_F(CommMPITest, overlap_kspace_begin)
+{
+    if (!Info(lmp).has_style("kspace", "pppm")) GTEST_SKIP();
+
+    // with FFTs on a subset of ranks, PPPM communicates before the pair forces,
+    // so the overlap must be turned off
+
+    charged_system();
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("kspace_modify fft/ranks 2");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    auto ref = run("overlap no", 25);
+    reset();
+    charged_system();
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("kspace_modify fft/ranks 2");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    auto val = run("overlap yes", 25);
+    if (!verbose && (lmp->comm->me == 0) && (lmp->comm->nprocs > 2))
+        EXPECT_THAT(output, HasSubstr("Comm_modify overlap is not supported"));
+    compare(ref, val);
+}
+
+TEST_F(CommMPITest, persistent)
+{
+    // persistent requests are recreated after every reneighboring, first on
+    // fixed steps, then with rebuilds triggered by atom motion
+
+    std::vector<double> ref_fixed, ref_check;
+    for (const auto &modify : {"persistent no", "persistent yes"}) {
+        reset();
+        lj_system();
+        auto fixed = run(modify, 25);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("neigh_modify every 1 delay 0 check yes");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        auto check = run(modify, 25);
+        if (ref_fixed.empty()) {
+            ref_fixed = fixed;
+            ref_check = check;
+        } else {
+            compare(ref_fixed, fixed);
+            compare(ref_check, check);
+        }
+    }
+}
+
+TEST_F(CommMPITest, collective)
+{
+    // rcb tiling of an inhomogeneous system, so that ranks have several
+    // neighbor ranks per swap; with newton on, forces are reverse communicated
+
+    std::vector<double> ref;
+    std::vector<int> ref_ghosts;
+    for (const auto &modify : {"collective no", "collective yes"}) {
+        reset();
+        lj_system();
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("region hole block 0 3 0 3 0 6");
+        command("delete_atoms region hole");
+        command("comm_style tiled");
+        command("balance 1.0 rcb");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        auto val    = run(modify, 25);
+        auto ghosts = nghost_all();
+        if (ref.empty()) {
+            ref        = val;
+            ref_ghosts = ghosts;
+        } else {
+            ASSERT_EQ(ghosts, ref_ghosts);
+            compare(ref, val);
+        }
+    }
+}
+
+TEST_F(CommMPITest, stubs_collective)
+{
+#if !defined(MPI_STUBS)
+    GTEST_SKIP();
+#else
+    // a serial graph has no neighbor ranks, all ghosts are copies of own atoms,
+    // so neighbor collectives must leave the receive buffers alone
+
+    MPI_Comm graph;
+    ASSERT_EQ(MPI_Dist_graph_create_adjacent(MPI_COMM_WORLD, 0, nullptr, MPI_UNWEIGHTED, 0,
+                                             nullptr, MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &graph),
+              MPI_SUCCESS);
+    int sendnum = 1, recvnum = 2;
+    ASSERT_EQ(MPI_Neighbor_alltoall(&sendnum, 1, MPI_INT, &recvnum, 1, MPI_INT, graph),
+              MPI_SUCCESS);
+    ASSERT_EQ(recvnum, 2);
+    double sendbuf = 1.0, recvbuf = 2.0;
+    int count = 0, displ = 0;
+    ASSERT_EQ(MPI_Neighbor_alltoallv(&sendbuf, &count, &displ, MPI_DOUBLE, &recvbuf, &count,
+                                     &displ, MPI_DOUBLE, graph),
+              MPI_SUCCESS);
+    ASSERT_EQ(recvbuf, 2.0);
+    ASSERT_EQ(MPI_Comm_free(&graph), MPI_SUCCESS);
+#endif
+}
+} // namespace LAMMPS_NS
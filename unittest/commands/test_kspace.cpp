@@ -0,0 +1,339 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "lammps.h"
+
+#include "atom.h"
+#include "compute.h"
+#include "fix.h"
+#include "force.h"
+#include "info.h"
+#include "kspace.h"
+#include "modify.h"
+#include "neighbor.h"
+#include "pair.h"
+
+#include "../testing/core.h"
+#include "../testing/systems/charged.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+using TestSystems::by_id;
+
+namespace LAMMPS_NS {
+class KSpaceTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "KSpaceTest";
+        LAMMPSTest::SetUp();
+    }
+
+    // disordered system of charges with a salt-like composition
+
+    void charged_system()
+    {
+        BEGIN_HIDE_OUTPUT();
+        TestSystems::charged_system(lmp, "block 0 6 0 6 0 6", 1.0e-5);
+        END_HIDE_OUTPUT();
+    }
+
+    std::vector<double> forces(const std::string &modify)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("kspace_modify " + modify);
+        command("run 0 post no");
+        END_HIDE_OUTPUT();
+        return by_id(lmp, lmp->atom->f);
+    }
+};
+
+TEST_F(KSpaceTest, every)
+{
+    if (!info->has_style("kspace", "pppm")) GTEST_SKIP();
+    charged_system();
+
+    auto full   = forces("compute yes every 1");
+    auto nok    = forces("compute no");
+    auto every1 = forces("compute yes every 1");
+    for (std::size_t i = 0; i < full.size(); i++)
+        ASSERT_DOUBLE_EQ(every1[i], full[i]);
+
+    // KSpace forces are scaled by N on multiples of N and not applied otherwise
+
+    auto impulse = forces("every 3");
+    for (std::size_t i = 0; i < full.size(); i++)
+        ASSERT_NEAR(impulse[i], nok[i] + 3.0 * (full[i] - nok[i]), 1.0e-12);
+
+    BEGIN_HIDE_OUTPUT();
+    command("reset_timestep 1");
+    END_HIDE_OUTPUT();
+    auto between = forces("every 3");
+    for (std::size_t i = 0; i < full.size(); i++)
+        ASSERT_NEAR(between[i], nok[i], 1.0e-12);
+
+    // kspace forces must differ from the rest for the test to be meaningful
+
+    double diff = 0.0;
+    for (std::size_t i = 0; i < full.size(); i++) diff += fabs(full[i] - nok[i]);
+    ASSERT_GT(diff, 1.0);
+
+    TEST_FAILURE(".*ERROR: Illegal kspace_modify every value.*", command("kspace_modify every 0"););
+}
+
+TEST_F(KSpaceTest, every_run)
+{
+    if (!info->has_style("kspace", "pppm")) GTEST_SKIP();
+
+    // with every 1, a run gives the same trajectory as without the keyword
+
+    charged_system();
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command("run 10 post no");
+    END_HIDE_OUTPUT();
+    auto x0 = by_id(lmp, lmp->atom->x);
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    END_HIDE_OUTPUT();
+    charged_system();
+    BEGIN_HIDE_OUTPUT();
+    command("kspace_modify every 1");
+    command("fix 1 all nve");
+    command("run 10 post no");
+    END_HIDE_OUTPUT();
+    auto x1 = by_id(lmp, lmp->atom->x);
+    for (std::size_t i = 0; i < x0.size(); i++)
+        ASSERT_DOUBLE_EQ(x1[i], x0[i]);
+}
+
+TEST_F(KSpaceTest, every_torque)
+{
+    if (!info->has_style("kspace", "ewald/dipole")) GTEST_SKIP();
+    if (!info->has_style("pair", "lj/cut/dipole/long")) GTEST_SKIP();
+    if (!info->has_style("atom", "sphere")) GTEST_SKIP();
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_style hybrid sphere dipole");
+    command("atom_modify map array");
+    command("lattice sc 1.0");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("set type 1 mass 1.0");
+    command("set type 1 charge 0.0");
+    command("set type 1 dipole/random 3728 1.0");
+    command("displace_atoms all random 0.1 0.1 0.1 2745");
+    command("pair_style lj/cut/dipole/long 2.5");
+    command("pair_coeff * * 1.0 1.0");
+    command("kspace_style ewald/dipole 1.0e-5");
+    END_HIDE_OUTPUT();
+
+    auto full_f = forces("compute yes every 1");
+    auto full_t = by_id(lmp, lmp->atom->torque);
+    auto nok_f  = forces("compute no");
+    auto nok_t  = by_id(lmp, lmp->atom->torque);
+    auto imp_f  = forces("compute yes every 2");
+    auto imp_t  = by_id(lmp, lmp->atom->torque);
+
+    double diff = 0.0;
+    for (std::size_t i = 0; i < full_t.size(); i++) {
+        ASSERT_NEAR(imp_f[i], nok_f[i] + 2.0 * (full_f[i] - nok_f[i]), 1.0e-10);
+        ASSERT_NEAR(imp_t[i], nok_t[i] + 2.0 * (full_t[i] - nok_t[i]), 1.0e-10);
+        diff += fabs(full_t[i] - nok_t[i]);
+    }
+    ASSERT_GT(diff, 1.0e-3);
+}
+
+TEST_F(KSpaceTest, fft_batch)
+{
+    if (!info->has_style("kspace", "pppm")) GTEST_SKIP();
+    charged_system();
+
+    // transforming the three gradients together gives bitwise identical forces
+
+    auto single = forces("fft/batch no");
+    double energy = lmp->force->kspace->energy;
+    auto batch = forces("fft/batch yes");
+    ASSERT_DOUBLE_EQ(lmp->force->kspace->energy, energy);
+    for (std::size_t i = 0; i < single.size(); i++)
+        ASSERT_DOUBLE_EQ(batch[i], single[i]);
+
+    // with collective remaps the batched transform falls back to one field at a time
+
+    auto collective = forces("fft/batch yes collective yes");
+    for (std::size_t i = 0; i < single.size(); i++)
+        ASSERT_NEAR(collective[i], single[i], 1.0e-12);
+}
+
+TEST_F(KSpaceTest, fft_ranks)
+{
+    if (!info->has_style("kspace", "pppm")) GTEST_SKIP();
+    charged_system();
+
+    // on a single rank, FFTs on a subset of ranks reduce to FFTs on all ranks
+
+    auto all = forces("fft/ranks 0");
+    for (const auto &modify : {"fft/ranks 1", "fft/ranks 1 fft/batch yes"}) {
+        auto subset = forces(modify);
+        for (std::size_t i = 0; i < all.size(); i++)
+            ASSERT_DOUBLE_EQ(subset[i], all[i]);
+    }
+
+    TEST_FAILURE(".*ERROR: Illegal kspace_modify fft/ranks value.*",
+                 command("kspace_modify fft/ranks -1"););
+}
+
+TEST_F(KSpaceTest, tune_pppm)
+{
+    if (!info->has_style("fix", "tune/pppm")) GTEST_SKIP();
+    charged_system();
+
+    // a large target ratio grows the cutoff by the maximum change until it reaches the bound
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command("fix 2 all tune/pppm 5 ratio 1000.0 cutoff 2.0 3.0");
+    command("run 30 post no");
+    END_HIDE_OUTPUT();
+    auto fix = lmp->modify->get_fix_by_id("2");
+    ASSERT_DOUBLE_EQ(fix->compute_vector(0), 3.0);
+    int dim;
+    ASSERT_DOUBLE_EQ(*(double *)lmp->force->pair->extract("cut_coul", dim), 3.0);
+    double g_ewald = fix->compute_vector(1);
+
+    // forces after the retune during the run match a full re-initialization
+
+    auto tuned = by_id(lmp, lmp->atom->f);
+    BEGIN_HIDE_OUTPUT();
+    command("unfix 2");
+    END_HIDE_OUTPUT();
+    auto rerun = forces("compute yes");
+    ASSERT_DOUBLE_EQ(lmp->force->kspace->g_ewald, g_ewald);
+    for (std::size_t i = 0; i < tuned.size(); i++)
+        ASSERT_NEAR(tuned[i], rerun[i], 1.0e-10);
+}
+
+TEST_F(KSpaceTest, tune_pppm_default)
+{
+    if (!info->has_style("fix", "tune/pppm")) GTEST_SKIP();
+
+    // charged Lennard-Jones liquid at the usual density with the default cutoff bounds
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_style charge");
+    command("atom_modify map array");
+    command("lattice fcc 0.8442");
+    command("region box block 0 5 0 5 0 5");
+    command("create_box 2 box");
+    command("create_atoms 1 box");
+    command("mass * 1.0");
+    command("set type 1 type/ratio 2 0.5 4817");
+    command("set type 1 charge 1.0");
+    command("set type 2 charge -1.0");
+    command("velocity all create 1.44 87287");
+    command("pair_style lj/cut/coul/long 2.5");
+    command("pair_coeff * * 1.0 1.0");
+    command("kspace_style pppm 1.0e-5");
+    command("fix 1 all nve");
+    command("fix 2 all tune/pppm 5 ratio 1000.0");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+
+    // lists are sized for the current cutoff and follow it
+
+    auto neighbor = lmp->neighbor;
+    ASSERT_DOUBLE_EQ(neighbor->cutneighmax, 2.5 + neighbor->skin);
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 30 post no");
+    END_HIDE_OUTPUT();
+    auto fix = lmp->modify->get_fix_by_id("2");
+    ASSERT_DOUBLE_EQ(fix->compute_vector(0), 3.0);
+    ASSERT_DOUBLE_EQ(neighbor->cutneighmax, 3.0 + neighbor->skin);
+
+    // a small target ratio shrinks the cutoff by the maximum change
+    // the lists follow it down to the Lennard-Jones cutoff
+
+    BEGIN_HIDE_OUTPUT();
+    command("unfix 2");
+    command("fix 2 all tune/pppm 5 ratio 1.0e-6");
+    command("run 10 post no");
+    END_HIDE_OUTPUT();
+    fix = lmp->modify->get_fix_by_id("2");
+    ASSERT_DOUBLE_EQ(fix->compute_vector(0), 3.0 / 1.1 / 1.1);
+    ASSERT_DOUBLE_EQ(neighbor->cutneighmax, 2.5 + neighbor->skin);
+
+    auto tuned = by_id(lmp, lmp->atom->f);
+    BEGIN_HIDE_OUTPUT();
+    command("unfix 2");
+    END_HIDE_OUTPUT();
+    auto rerun = forces("compute yes");
+    for (std::size_t i = 0; i < tuned.size(); i++)
+        ASSERT_NEAR(tuned[i], rerun[i], 1.0e-10);
+}
+
+TEST_F(KSpaceTest, tune_pppm_rdf)
+{
+    if (!info->has_style("fix", "tune/pppm")) GTEST_SKIP();
+    charged_system();
+
+    // compute rdf owns a neighbor list that must survive a retune
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command("fix 2 all tune/pppm 5 ratio 1000.0 cutoff 2.0 3.0");
+    command("compute rdf all rdf 20");
+    command("fix 3 all ave/time 1 1 1 c_rdf[*] mode vector");
+    command("run 30 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_DOUBLE_EQ(lmp->modify->get_fix_by_id("2")->compute_vector(0), 3.0);
+
+    auto rdf   = lmp->modify->get_compute_by_id("rdf");
+    double sum = 0.0;
+    for (int i = 0; i < rdf->size_array_rows; i++) {
+        ASSERT_TRUE(std::isfinite(rdf->array[i][1]));
+        sum += rdf->array[i][2];
+    }
+    ASSERT_GT(sum, 0.0);
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,168 @@
+// unit tests for PPPM options that change how the FFTs are done across MPI ranks
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "fix.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include "modify.h"
+
+#include "fmt/format.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/systems/charged.h"
+#include "../testing/test_mpi_main.h"
+
+using TestSystems::by_id;
+
+namespace LAMMPS_NS {
+
+class KSpaceMPITest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // disordered system of charges in an orthogonal or triclinic box
+    // per-atom energy and virial of the KSpace part are averaged by a fix
+
+    void charged_system(const std::string &region)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        TestSystems::charged_system(lmp, region, 1.0e-4);
+        command("compute pe all pe/atom kspace");
+        command("compute virial all stress/atom NULL kspace");
+        command("fix peratom all ave/atom 1 1 1 c_pe c_virial[*]");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // forces, per-atom energy, and per-atom virial of all atoms ordered by ID
+
+    std::vector<double> solve(const std::string &modify)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("kspace_modify " + modify);
+        command("run 0 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        auto f       = by_id(lmp, lmp->atom->f);
+        auto peratom = by_id(lmp, lmp->modify->get_fix_by_id("peratom")->array_atom, 7);
+        std::vector<double> all;
+        for (std::size_t i = 0; i < f.size() / 3; i++) {
+            all.insert(all.end(), &f[3 * i], &f[3 * i + 3]);
+            all.insert(all.end(), &peratom[7 * i], &peratom[7 * i + 7]);
+        }
+        return all;
+    }
+
+    // per-atom data must be set for the comparison to be meaningful
+
+    static void compare(const std::vector<double> &ref, const std::vector<double> &val)
+    {
+        ASSERT_EQ(ref.size(), val.size());
+        double energy = 0.0, virial = 0.0;
+        for (std::size_t i = 0; i < ref.size(); i += 10) {
+            energy += fabs(ref[i + 3]);
+            virial += fabs(ref[i + 4]);
+        }
+        ASSERT_GT(energy, 0.0);
+        ASSERT_GT(virial, 0.0);
+        for (std::size_t i = 0; i < ref.size(); i++)
+            ASSERT_NEAR(val[i], ref[i], 1.0e-10 * (1.0 + fabs(ref[i])));
+    }
+};
+
+TEST_F(KSpaceMPITest, fft_batch)
+{
+    if (!Info(lmp).has_style("kspace", "pppm")) GTEST_SKIP();
+
+    charged_system("block 0 6 0 6 0 6");
+    auto single = solve("fft/batch no");
+    compare(single, solve("fft/batch yes"));
+    compare(single, solve("fft/batch yes collective yes"));
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("clear");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    charged_system("prism 0 6 0 6 0 6 1.0 0.5 0.0");
+    single = solve("fft/batch no");
+    compare(single, solve("fft/batch yes"));
+}
+
+TEST_F(KSpaceMPITest, fft_ranks)
+{
+    if (!Info(lmp).has_style("kspace", "pppm")) GTEST_SKIP();
+
+    // FFTs on a subset of ranks, with and without batched transforms
+
+    charged_system("block 0 6 0 6 0 6");
+    auto all = solve("fft/ranks 0");
+    for (int nranks = 1; nranks < lmp->comm->nprocs; nranks++)
+        compare(all, solve(fmt::format("fft/ranks {}", nranks)));
+    compare(all, solve("fft/ranks 2 fft/batch yes"));
+    auto ad = solve("fft/ranks 0 fft/batch no diff ad");
+    compare(ad, solve("fft/ranks 2"));
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("clear");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    charged_system("prism 0 6 0 6 0 6 1.0 0.5 0.0");
+    all = solve("fft/ranks 0");
+    compare(all, solve("fft/ranks 2"));
+}
+
+TEST_F(KSpaceMPITest, fft_ranks_run)
+{
+    if (!Info(lmp).has_style("kspace", "pppm")) GTEST_SKIP();
+
+    // without per-atom output, FFTs start before the pair forces during a run
+
+    std::vector<double> ref;
+    for (int nranks = 0; nranks < 3; nranks++) {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        charged_system("block 0 6 0 6 0 6");
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("unfix peratom");
+        command("fix 1 all nve");
+        command(fmt::format("kspace_modify fft/ranks {}", nranks));
+        command("run 20 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        auto all = by_id(lmp, lmp->atom->x);
+        if (nranks == 0) {
+            ref = all;
+        } else {
+            for (std::size_t i = 0; i < ref.size(); i++)
+                ASSERT_NEAR(all[i], ref[i], 1.0e-10);
+        }
+    }
+}
+} // namespace LAMMPS_NS
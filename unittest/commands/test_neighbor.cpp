@@ -0,0 +1,133 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "lammps.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "info.h"
+#include "input.h"
+#include "neighbor.h"
+#include "variable.h"
+
+#include "fmt/format.h"
+
+#include "../testing/core.h"
+#include "../testing/systems/charged.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+using TestSystems::by_id;
+
+namespace LAMMPS_NS {
+class NeighborTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "NeighborTest";
+        LAMMPSTest::SetUp();
+    }
+
+    // hot LJ liquid with neighbor list checks on every step
+
+    void lj_system()
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("units lj");
+        command("atom_style atomic");
+        command("atom_modify map array");
+        command("lattice fcc 0.8442");
+        command("region box block 0 5 0 5 0 5");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("neighbor 0.3 bin");
+        command("neigh_modify every 1 delay 0 check yes");
+        command("fix 1 all nve");
+        END_HIDE_OUTPUT();
+    }
+
+    // positions and forces of all atoms ordered by ID, then energy and pressure
+
+    std::vector<double> run(const std::string &modify, int nsteps)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("neigh_modify " + modify);
+        command(fmt::format("run {} post no", nsteps));
+        END_HIDE_OUTPUT();
+
+        auto all = by_id(lmp, lmp->atom->x);
+        auto f   = by_id(lmp, lmp->atom->f);
+        all.insert(all.end(), f.begin(), f.end());
+        all.push_back(lmp->input->variable->compute_equal("pe"));
+        all.push_back(lmp->input->variable->compute_equal("press"));
+        return all;
+    }
+};
+
+TEST_F(NeighborTest, partial)
+{
+    lj_system();
+    auto full = run("partial no", 200);
+    auto nfull = lmp->neighbor->ncalls;
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    END_HIDE_OUTPUT();
+    lj_system();
+    auto partial = run("partial yes", 200);
+
+    // the run must have both partial and full rebuilds, but fewer full rebuilds,
+    // since the ghost cutoff is widened by another skin
+
+    ASSERT_GT(lmp->neighbor->npartial, 0);
+    ASSERT_GT(lmp->neighbor->ncalls, 1);
+    ASSERT_LT(lmp->neighbor->ncalls, nfull);
+    ASSERT_GE(lmp->comm->get_comm_cutoff(), lmp->neighbor->cutneighmax + lmp->neighbor->skin);
+
+    ASSERT_EQ(full.size(), partial.size());
+    for (std::size_t i = 0; i < full.size(); i++)
+        ASSERT_NEAR(partial[i], full[i], 1.0e-10 * (1.0 + fabs(full[i])));
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,204 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "lammps.h"
+
+#include "atom.h"
+#include "compute.h"
+#include "force.h"
+#include "info.h"
+#include "modify.h"
+#include "pair.h"
+
+#include "../testing/core.h"
+#include "../testing/systems/charged.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+using TestSystems::by_id;
+
+namespace LAMMPS_NS {
+class PackageOMPTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "PackageOMPTest";
+        LAMMPSTest::SetUp();
+    }
+
+    // per-atom forces, per-atom energy and virial, and global energy and
+    // virial for one pair style and thread schedule
+
+    struct Result {
+        std::vector<double> f, x, peatom, stress;
+        double energy, virial[6];
+    };
+
+    // slab of a charged LJ liquid with vacuum above and below, so that
+    // the number of neighbors per atom varies a lot
+
+    void slab_system(const std::string &schedule, const std::string &newton)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        if (!schedule.empty()) command("package omp 4 schedule " + schedule);
+        command("newton " + newton);
+        command("atom_style charge");
+        command("atom_modify map array");
+        command("lattice fcc 0.8442");
+        command("region box block 0 6 0 6 0 8");
+        command("create_box 2 box");
+        command("region slab block INF INF INF INF 2 6");
+        command("create_atoms 1 region slab");
+        TestSystems::assign_charges(lmp, 0.5, 0.05);
+        command("neighbor 0.3 bin");
+        command("neigh_modify every 2 delay 0 check no");
+        command("compute pea all pe/atom pair");
+        command("compute stress all stress/atom NULL pair");
+        command("compute sum all reduce sum c_pea c_stress[1]");
+        command("thermo_style custom step pe c_sum[1] c_sum[2]");
+        END_HIDE_OUTPUT();
+    }
+
+    Result compute(const std::string &pair_style, const std::string &pair_coeff,
+                   const std::string &schedule, const std::string &newton, int nsteps)
+    {
+        slab_system(schedule, newton);
+
+        BEGIN_HIDE_OUTPUT();
+        command("pair_style " + pair_style);
+        command("pair_coeff * * " + pair_coeff);
+        if (nsteps > 0) {
+            command("fix nve all nve");
+            command(fmt::format("run {} post no", nsteps));
+            command("unfix nve");
+        }
+        command("run 0 post no");
+        END_HIDE_OUTPUT();
+
+        Result result;
+        auto atom = lmp->atom;
+        auto pair = lmp->force->pair;
+        result.f  = by_id(lmp, atom->f);
+        result.x  = by_id(lmp, atom->x);
+
+        auto pea = lmp->modify->get_compute_by_id("pea");
+        std::vector<double> peatom(atom->natoms);
+        for (int i = 0; i < atom->nlocal; i++)
+            peatom[atom->tag[i] - 1] = pea->vector_atom[i];
+        result.peatom = peatom;
+        result.stress = by_id(lmp, lmp->modify->get_compute_by_id("stress")->array_atom, 6);
+
+        result.energy = pair->eng_vdwl + pair->eng_coul;
+        for (int k = 0; k < 6; k++)
+            result.virial[k] = pair->virial[k];
+        return result;
+    }
+
+    static void compare(const Result &test, const Result &ref, double eps)
+    {
+        ASSERT_EQ(test.f.size(), ref.f.size());
+        double fsum = 0.0;
+        for (std::size_t i = 0; i < ref.f.size(); i++) {
+            EXPECT_NEAR(test.f[i], ref.f[i], eps * (1.0 + fabs(ref.f[i])));
+            EXPECT_NEAR(test.x[i], ref.x[i], eps * (1.0 + fabs(ref.x[i])));
+            fsum += fabs(ref.f[i]);
+        }
+        ASSERT_GT(fsum, 0.0);
+        for (std::size_t i = 0; i < ref.peatom.size(); i++)
+            EXPECT_NEAR(test.peatom[i], ref.peatom[i], eps * (1.0 + fabs(ref.peatom[i])));
+        for (std::size_t i = 0; i < ref.stress.size(); i++)
+            EXPECT_NEAR(test.stress[i], ref.stress[i], eps * (1.0 + fabs(ref.stress[i])));
+        EXPECT_NEAR(test.energy, ref.energy, eps * (1.0 + fabs(ref.energy)));
+        for (int k = 0; k < 6; k++)
+            EXPECT_NEAR(test.virial[k], ref.virial[k], eps * (1.0 + fabs(ref.virial[k])));
+    }
+};
+
+// the dynamic schedule must give the same forces, energies, and virials
+// as the static schedule and the serial pair style
+
+TEST_F(PackageOMPTest, schedule)
+{
+    if (!Info(lmp).has_style("pair", "lj/cut/omp")) GTEST_SKIP();
+
+    // pair style name, cutoff settings, and coefficients
+
+    const std::vector<std::vector<std::string>> styles = {
+        {"lj/cut", "2.5", "1.0 1.0"},
+        {"lj/cut/coul/cut", "2.5 3.0", "1.0 1.0"},
+        {"morse", "2.5", "1.0 5.0 1.1"}};
+    for (const auto &style : styles) {
+        if (!Info(lmp).has_style("pair", style[0] + "/omp")) continue;
+        for (const auto &newton : {"on", "off"}) {
+            SCOPED_TRACE(style[0] + " newton " + newton);
+            auto ref = compute(style[0] + " " + style[1], style[2], "", newton, 0);
+            auto sta = compute(style[0] + "/omp " + style[1], style[2], "static", newton, 0);
+            auto dyn = compute(style[0] + "/omp " + style[1], style[2], "dynamic", newton, 0);
+            compare(sta, ref, 1.0e-12);
+            compare(dyn, ref, 1.0e-12);
+        }
+    }
+}
+
+// the chunks of the dynamic schedule must be redone after each neighbor
+// list rebuild, while atoms move between the slab and the vacuum
+
+TEST_F(PackageOMPTest, schedule_run)
+{
+    if (!Info(lmp).has_style("pair", "lj/cut/omp")) GTEST_SKIP();
+
+    auto ref = compute("lj/cut 2.5", "1.0 1.0", "", "on", 20);
+    auto sta = compute("lj/cut/omp 2.5", "1.0 1.0", "static", "on", 20);
+    auto dyn = compute("lj/cut/omp 2.5", "1.0 1.0", "dynamic", "on", 20);
+    compare(sta, ref, 1.0e-10);
+    compare(dyn, ref, 1.0e-10);
+}
+
+TEST_F(PackageOMPTest, schedule_error)
+{
+    if (!Info(lmp).has_style("pair", "lj/cut/omp")) GTEST_SKIP();
+
+    TEST_FAILURE(".*ERROR: Illegal package omp schedule value: guided.*",
+                 command("package omp 4 schedule guided"););
+    TEST_FAILURE(".*ERROR: Illegal package omp command.*", command("package omp 4 schedule"););
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
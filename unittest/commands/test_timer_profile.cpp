@@ -0,0 +1,317 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "lammps.h"
+
+#include "comm.h"
+#include "timer.h"
+
+#include "../testing/core.h"
+#include "../testing/utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace {
+// minimal strict JSON reader, sufficient to validate the profile file
+
+struct JsonValue {
+    enum { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT } type = NUL;
+    bool boolean   = false;
+    double number  = 0.0;
+    std::string str;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    const JsonValue &operator[](const std::string &key) const
+    {
+        for (const auto &kv : object)
+            if (kv.first == key) return kv.second;
+        throw std::runtime_error("missing key " + key);
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string &_text) : text(_text), pos(0) {}
+
+    JsonValue parse()
+    {
+        JsonValue value = parse_value();
+        skip_space();
+        if (pos != text.size()) fail("trailing characters");
+        return value;
+    }
+
+private:
+    const std::string &text;
+    std::size_t pos;
+
+    [[noreturn]] void fail(const std::string &msg)
+    {
+        throw std::runtime_error(msg + " at offset " + std::to_string(pos));
+    }
+
+    void skip_space()
+    {
+        while ((pos < text.size()) && isspace(text[pos])) ++pos;
+    }
+
+    void expect(char c)
+    {
+        skip_space();
+        if ((pos >= text.size()) || (text[pos] != c)) fail(std::string("expected ") + c);
+        ++pos;
+    }
+
+    bool next_is(char c)
+    {
+        skip_space();
+        return (pos < text.size()) && (text[pos] == c);
+    }
+
+    std::string parse_string()
+    {
+        expect('"');
+        std::string str;
+        while ((pos < text.size()) && (text[pos] != '"')) {
+            if ((text[pos] == '\\') || iscntrl(text[pos])) fail("unsupported character in string");
+            str += text[pos++];
+        }
+        expect('"');
+        return str;
+    }
+
+    JsonValue parse_value()
+    {
+        JsonValue value;
+        skip_space();
+        if (pos >= text.size()) fail("unexpected end");
+        const char c = text[pos];
+        if (c == '{') {
+            value.type = JsonValue::OBJECT;
+            ++pos;
+            if (next_is('}')) {
+                ++pos;
+                return value;
+            }
+            while (true) {
+                auto key = parse_string();
+                expect(':');
+                value.object.emplace_back(key, parse_value());
+                if (!next_is(',')) break;
+                ++pos;
+            }
+            expect('}');
+        } else if (c == '[') {
+            value.type = JsonValue::ARRAY;
+            ++pos;
+            if (next_is(']')) {
+                ++pos;
+                return value;
+            }
+            while (true) {
+                value.array.push_back(parse_value());
+                if (!next_is(',')) break;
+                ++pos;
+            }
+            expect(']');
+        } else if (c == '"') {
+            value.type = JsonValue::STRING;
+            value.str  = parse_string();
+        } else if (text.compare(pos, 4, "true") == 0) {
+            value.type    = JsonValue::BOOL;
+            value.boolean = true;
+            pos += 4;
+        } else if (text.compare(pos, 5, "false") == 0) {
+            value.type = JsonValue::BOOL;
+            pos += 5;
+        } else if (text.compare(pos, 4, "null") == 0) {
+            pos += 4;
+        } else if ((c == '-') || isdigit(c)) {
+            // strtod() would also accept inf and nan, which are not valid JSON
+            const char *start = text.c_str() + pos;
+            char *end         = nullptr;
+            value.type        = JsonValue::NUMBER;
+            value.number      = strtod(start, &end);
+            if (!isdigit(start[(c == '-') ? 1 : 0])) fail("invalid number");
+            pos += end - start;
+        } else
+            fail("unexpected character");
+        return value;
+    }
+};
+
+JsonValue read_json(const std::string &file)
+{
+    std::ifstream in(file);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    return JsonParser(buffer.str()).parse();
+}
+} // namespace
+
+namespace LAMMPS_NS {
+class TimerProfileTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "TimerProfileTest";
+        LAMMPSTest::SetUp();
+        BEGIN_HIDE_OUTPUT();
+        command("units lj");
+        command("atom_style atomic");
+        command("lattice fcc 0.8442");
+        command("region box block 0 4 0 4 0 4");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("neighbor 0.3 bin");
+        command("neigh_modify every 5 delay 0 check no");
+        command("fix integrate all nve");
+        command("compute mytemp all temp");
+        command("thermo_style custom step c_mytemp pe");
+        command("thermo 5");
+        END_HIDE_OUTPUT();
+    }
+
+    // return the section with this category and name from the profile, or nullptr
+
+    static const JsonValue *find_section(const JsonValue &profile, const std::string &category,
+                                         const std::string &name)
+    {
+        for (const auto &section : profile["sections"].array)
+            if ((section["category"].str == category) && (section["name"].str == name))
+                return &section;
+        return nullptr;
+    }
+};
+
+TEST_F(TimerProfileTest, json)
+{
+    const std::string json_file = "timer_profile_test.json";
+    delete_file(json_file);
+
+    BEGIN_HIDE_OUTPUT();
+    command("timer profile yes profile/json " + json_file);
+    command("run 20");
+    END_HIDE_OUTPUT();
+    ASSERT_FILE_EXISTS(json_file);
+
+    JsonValue profile;
+    try {
+        profile = read_json(json_file);
+    } catch (std::exception &e) {
+        FAIL() << "Cannot parse " << json_file << ": " << e.what();
+    }
+
+    ASSERT_EQ(profile.type, JsonValue::OBJECT);
+    EXPECT_EQ(profile["nprocs"].number, lmp->comm->nprocs);
+    EXPECT_GT(profile["loop_time"].number, 0.0);
+    EXPECT_EQ(profile["counters"].type, JsonValue::BOOL);
+    ASSERT_EQ(profile["sections"].type, JsonValue::ARRAY);
+
+    for (const auto &section : profile["sections"].array) {
+        ASSERT_EQ(section.type, JsonValue::OBJECT);
+        EXPECT_GT(section["calls"].number, 0.0);
+        EXPECT_LE(section["time_min"].number, section["time_avg"].number);
+        EXPECT_LE(section["time_avg"].number, section["time_max"].number);
+        EXPECT_GE(section["time_min"].number, 0.0);
+    }
+
+    auto fix = find_section(profile, "Fix", "integrate");
+    ASSERT_NE(fix, nullptr);
+    EXPECT_EQ((*fix)["style"].str, "nve");
+    // initial_integrate() and final_integrate() on each step
+    EXPECT_EQ((*fix)["calls"].number, 40);
+
+    // invoked for thermo output on steps 5, 10, 15, and 20, step 0 is in the setup
+
+    auto compute = find_section(profile, "Compute", "mytemp");
+    ASSERT_NE(compute, nullptr);
+    EXPECT_EQ((*compute)["style"].str, "temp");
+    EXPECT_EQ((*compute)["calls"].number, 4);
+
+    bool has_npair = false;
+    for (const auto &section : profile["sections"].array)
+        if ((section["category"].str == "NPair") && (section["items"].number > 0.0))
+            has_npair = true;
+    EXPECT_TRUE(has_npair);
+
+    // the file is overwritten by the next run and not written without profile
+
+    BEGIN_HIDE_OUTPUT();
+    command("unfix integrate");
+    command("fix move all nve");
+    command("run 10");
+    END_HIDE_OUTPUT();
+    profile = read_json(json_file);
+    EXPECT_EQ(find_section(profile, "Fix", "integrate"), nullptr);
+    ASSERT_NE(find_section(profile, "Fix", "move"), nullptr);
+    EXPECT_EQ((*find_section(profile, "Fix", "move"))["calls"].number, 20);
+    delete_file(json_file);
+
+    BEGIN_HIDE_OUTPUT();
+    command("timer profile no");
+    command("run 10");
+    END_HIDE_OUTPUT();
+    EXPECT_FALSE(file_exists(json_file));
+}
+
+TEST_F(TimerProfileTest, errors)
+{
+    TEST_FAILURE(".*ERROR: Illegal timer profile command: missing argument.*",
+                 command("timer profile"););
+    TEST_FAILURE(".*ERROR: Illegal timer profile/json command: missing argument.*",
+                 command("timer profile/json"););
+    TEST_FAILURE(".*ERROR: Expected boolean parameter instead of 'maybe'.*",
+                 command("timer profile maybe"););
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
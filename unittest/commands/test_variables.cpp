@@ -394,6 +394,76 @@ TEST_F(VariableTest, Expressions)
                  command("print \"${xxxl}\""););
 }
 
+TEST_F(VariableTest, CompiledFormulas)
+{
+    // formulas of equal- and atom-style variables are compiled on first use,
+    // immediate evaluation of the same formula goes through the parser
+
+    molecular_system();
+    BEGIN_HIDE_OUTPUT();
+    command("variable two equal 2.0");
+    command("velocity all create 1.0 4928459 loop geom");
+    command("group left region left");
+    END_HIDE_OUTPUT();
+
+    const std::vector<std::string> equal_formulas = {
+        "2.5*v_two+sqrt(16)-exp(0.5)",
+        "ln(3.0)/log(10)+abs(-2)",
+        "atan2(1.0,2.0)+ceil(1.2)+floor(-1.5)+round(2.5)",
+        "ternary(1<2,3.5,4.5)*sin(PI/3)+cos(0.3)+tan(0.2)",
+        "asin(0.5)+acos(0.25)+atan(2)",
+        "(1.0/v_two)^3+5%3-((2>1)&&(3<=4))+(1|^0)-!(v_two==2)",
+        "-v_two^2+step+atoms*0.5+vol",
+    };
+
+    int i = 0;
+    for (const auto &formula : equal_formulas) {
+        auto name = fmt::format("eq{}", i++);
+        BEGIN_HIDE_OUTPUT();
+        command(fmt::format("variable {} equal \"{}\"", name, formula));
+        END_HIDE_OUTPUT();
+        int ivar = variable->find(name.c_str());
+        ASSERT_GE(ivar, 0);
+        EXPECT_DOUBLE_EQ(variable->compute_equal(ivar), variable->compute_equal(formula))
+            << formula;
+        // second evaluation re-uses the compiled formula
+        EXPECT_DOUBLE_EQ(variable->compute_equal(ivar), variable->compute_equal(formula))
+            << formula;
+    }
+
+    // count() is not compiled, so the reference formula is evaluated by the parser
+
+    const std::vector<std::string> atom_formulas = {
+        "x*y+z^2-sqrt(abs(x))",
+        "mass*type+id%3+mol-2*q",
+        "ternary(x>0,vx,-x)+v_two*fx+vy*vz",
+        "(x>0)&&(y<0)||(z==0.125)",
+        "exp(-x^2)*cos(PI*y)+atan2(y,x)-v_two",
+    };
+
+    const int nlocal = lmp->atom->nlocal;
+    std::vector<double> compiled(nlocal), parsed(nlocal);
+    for (const auto &formula : atom_formulas) {
+        auto name = fmt::format("at{}", i++);
+        BEGIN_HIDE_OUTPUT();
+        command(fmt::format("variable {} atom \"{}\"", name, formula));
+        command(fmt::format("variable {}ref atom \"{}+0*count(all)\"", name, formula));
+        END_HIDE_OUTPUT();
+        int ivar = variable->find(name.c_str());
+        int iref = variable->find((name + "ref").c_str());
+        ASSERT_GE(ivar, 0);
+        ASSERT_GE(iref, 0);
+
+        for (auto &groupname : {"all", "left"}) {
+            int igroup = group->find(groupname);
+            variable->compute_atom(ivar, igroup, compiled.data(), 1, 0);
+            variable->compute_atom(iref, igroup, parsed.data(), 1, 0);
+            for (int j = 0; j < nlocal; ++j)
+                EXPECT_DOUBLE_EQ(compiled[j], parsed[j]) << formula << " atom " << j;
+        }
+    }
+}
+
 TEST_F(VariableTest, Functions)
 {
     atomic_system();
@@ -477,7 +477,8 @@ TEST(PairStyle, plain)
     EXPECT_FP_LE_WITH_EPS(pair->eng_coul, test_config.init_coul, epsilon);
     if (print_stats) std::cerr << "data_energy stats:" << stats << std::endl;
 
-    if (pair->respa_enable) {
+    // pair_modify cluster yes does not support the rRESPA inner levels
+    if (pair->respa_enable && !pair->cluster_flag) {
         if (!verbose) ::testing::internal::CaptureStdout();
         cleanup_lammps(lmp, test_config);
         lmp = init_lammps(args, test_config, false);
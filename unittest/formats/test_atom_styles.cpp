@@ -19,9 +19,12 @@
 #include "atom_vec_line.h"
 #include "atom_vec_tri.h"
 #include "body.h"
+#include "force.h"
+#include "info.h"
 #include "input.h"
 #include "lammps.h"
 #include "math_const.h"
+#include "pair.h"
 #include "utils.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -5376,6 +5379,72 @@ TEST_F(AtomStyleTest, oxdna)
     END_HIDE_OUTPUT();
 }
 
+TEST_F(AtomStyleTest, sort_order)
+{
+    if (!Info(lmp).has_style("pair", "lj/cut")) GTEST_SKIP();
+
+    // per-atom data must move together when atoms are sorted along a
+    // space-filling curve, and the energy must be the same as with binned order
+
+    std::vector<tagint> binned;
+    double binned_energy = 0.0;
+    for (const auto &order : {"binned", "morton", "hilbert"}) {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        command("units lj");
+        command("atom_modify map array sort 0 0.0");
+        command("lattice fcc 0.8442");
+        command("region cell block 0 4 0 4 0 4");
+        command("create_box 1 cell");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("displace_atoms all random 0.1 0.1 0.1 2745");
+        command("velocity all create 1.0 87287");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0");
+        command("run 0 post no");
+        END_HIDE_OUTPUT();
+
+        auto atom  = lmp->atom;
+        int nlocal = atom->nlocal;
+        std::vector<double> xv(6 * (nlocal + 1));
+        std::vector<tagint> unsorted(nlocal);
+        for (int i = 0; i < nlocal; i++) {
+            unsorted[i] = atom->tag[i];
+            for (int k = 0; k < 3; k++) {
+                xv[6 * atom->tag[i] + k]     = atom->x[i][k];
+                xv[6 * atom->tag[i] + 3 + k] = atom->v[i][k];
+            }
+        }
+
+        BEGIN_HIDE_OUTPUT();
+        command(std::string("atom_modify sort 1 0.8 sort/order ") + order);
+        command("run 0 post no");
+        END_HIDE_OUTPUT();
+
+        ASSERT_EQ(atom->nlocal, nlocal);
+        std::vector<tagint> sorted(nlocal);
+        for (int i = 0; i < nlocal; i++) {
+            sorted[i] = atom->tag[i];
+            ASSERT_EQ(atom->map(atom->tag[i]), i);
+            for (int k = 0; k < 3; k++) {
+                ASSERT_DOUBLE_EQ(atom->x[i][k], xv[6 * atom->tag[i] + k]);
+                ASSERT_DOUBLE_EQ(atom->v[i][k], xv[6 * atom->tag[i] + 3 + k]);
+            }
+        }
+        ASSERT_NE(sorted, unsorted);
+
+        double energy = lmp->force->pair->eng_vdwl;
+        if (std::string("binned") == order) {
+            binned        = sorted;
+            binned_energy = energy;
+        } else {
+            ASSERT_NE(sorted, binned);
+            ASSERT_NEAR(energy, binned_energy, 1.0e-12 * fabs(binned_energy));
+        }
+    }
+}
+
 } // namespace LAMMPS_NS
 
 int main(int argc, char **argv)
@@ -521,6 +521,52 @@ TEST_F(DumpAtomTest, run2)
     delete_file(dump_file);
 }
 
+TEST_F(DumpAtomTest, async_run)
+{
+    HIDE_OUTPUT([&] {
+        command("fix 1 all nve");
+    });
+
+    // the same dump written by the main thread and by a background thread,
+    // with both dumps deleted and redefined between parts of the run
+
+    for (const std::string options : {"", "buffer no"}) {
+        auto sync_file  = dump_filename("sync");
+        auto async_file = dump_filename("async");
+        auto redefine   = [&](const std::string &id, const std::string &file,
+                            const std::string &extra) {
+            return fmt::format("\"undump {0}\" \"dump {0} all atom 1 {1}\" "
+                               "\"dump_modify {0} append yes {2} {3}\"",
+                               id, file, options, extra);
+        };
+
+        BEGIN_HIDE_OUTPUT();
+        command(fmt::format("dump id0 all atom 1 {}", sync_file));
+        command(fmt::format("dump id1 all atom 1 {}", async_file));
+        if (!options.empty()) command(fmt::format("dump_modify id0 {}", options));
+        command(fmt::format("dump_modify id1 async yes {}", options));
+        command(fmt::format("run 6 post no every 2 {} {}", redefine("id0", sync_file, ""),
+                            redefine("id1", async_file, "async yes")));
+        END_HIDE_OUTPUT();
+
+        // files are complete when the run returns, before the dumps are deleted
+
+        auto sync_lines  = read_lines(sync_file);
+        auto async_lines = read_lines(async_file);
+        ASSERT_GE(sync_lines.size(), 7 * 41);
+        ASSERT_EQ(async_lines.size(), sync_lines.size());
+        for (std::size_t i = 0; i < sync_lines.size(); i++)
+            ASSERT_THAT(async_lines[i], Eq(sync_lines[i]));
+
+        BEGIN_HIDE_OUTPUT();
+        command("undump id0");
+        command("undump id1");
+        END_HIDE_OUTPUT();
+        delete_file(sync_file);
+        delete_file(async_file);
+    }
+}
+
 TEST_F(DumpAtomTest, rerun)
 {
     auto dump_file = dump_filename("rerun");
@@ -0,0 +1,267 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "../testing/systems/melt.h"
+#include "../testing/utils.h"
+#include "atom.h"
+#include "fmt/format.h"
+#include "update.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+bool verbose = false;
+
+namespace LAMMPS_NS {
+class DumpIndexedTest : public MeltTest {
+public:
+    // per-atom x, y, z, vx, vy, vz keyed by atom ID
+
+    std::map<tagint, std::vector<double>> snapshot()
+    {
+        std::map<tagint, std::vector<double>> data;
+        auto atom = lmp->atom;
+        for (int i = 0; i < atom->nlocal; i++)
+            data[atom->tag[i]] = {atom->x[i][0], atom->x[i][1], atom->x[i][2],
+                                  atom->v[i][0], atom->v[i][1], atom->v[i][2]};
+        return data;
+    }
+
+    // write one snapshot, scramble the atoms, and read the snapshot back
+
+    std::map<tagint, std::vector<double>> roundtrip(const std::string &style,
+                                                    const std::string &dump_file,
+                                                    const std::string &dump_modify_options)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command(fmt::format("dump id all {} 1 {} id type x y z vx vy vz", style, dump_file));
+        if (!dump_modify_options.empty())
+            command(fmt::format("dump_modify id {}", dump_modify_options));
+        command("run 0 post no");
+        command("undump id");
+        END_HIDE_OUTPUT();
+        auto data = snapshot();
+
+        BEGIN_HIDE_OUTPUT();
+        command("displace_atoms all random 0.5 0.5 0.5 4927 units box");
+        command("velocity all create 1.0 3571");
+        command(fmt::format("read_dump {} 0 x y z vx vy vz box no format {}", dump_file, style));
+        END_HIDE_OUTPUT();
+        return data;
+    }
+};
+
+TEST_F(DumpIndexedTest, indexed_roundtrip)
+{
+    auto dump_file = "dump_indexed_roundtrip.melt";
+    auto data      = roundtrip("indexed", dump_file, "");
+
+    ASSERT_FILE_EXISTS(dump_file);
+    ASSERT_FILE_EXISTS(std::string(dump_file) + ".index");
+    auto reread = snapshot();
+    ASSERT_EQ(reread.size(), data.size());
+    for (const auto &kv : data)
+        for (int k = 0; k < 6; k++)
+            EXPECT_DOUBLE_EQ(reread[kv.first][k], kv.second[k]);
+    delete_file(dump_file);
+    delete_file(std::string(dump_file) + ".index");
+}
+
+TEST_F(DumpIndexedTest, lossy_roundtrip)
+{
+    const double bound = 1.0e-3;
+    auto dump_file     = "dump_lossy_roundtrip.melt";
+    auto data =
+        roundtrip("lossy", dump_file, fmt::format("bound x {0} bound y {0} bound z {0}", bound));
+
+    ASSERT_FILE_EXISTS(dump_file);
+    auto reread = snapshot();
+    ASSERT_EQ(reread.size(), data.size());
+    bool exact = true;
+    for (const auto &kv : data) {
+        for (int k = 0; k < 3; k++) {
+            EXPECT_LE(fabs(reread[kv.first][k] - kv.second[k]), bound * (1.0 + 1.0e-12));
+            if (reread[kv.first][k] != kv.second[k]) exact = false;
+        }
+        for (int k = 3; k < 6; k++)
+            EXPECT_DOUBLE_EQ(reread[kv.first][k], kv.second[k]);
+    }
+    ASSERT_FALSE(exact);
+    delete_file(dump_file);
+    delete_file(std::string(dump_file) + ".index");
+}
+
+TEST_F(DumpIndexedTest, lossy_lossless)
+{
+    auto dump_file = "dump_lossy_lossless.melt";
+    auto data      = roundtrip("lossy", dump_file, "");
+
+    ASSERT_FILE_EXISTS(dump_file);
+    auto reread = snapshot();
+    ASSERT_EQ(reread.size(), data.size());
+    for (const auto &kv : data)
+        for (int k = 0; k < 6; k++)
+            EXPECT_DOUBLE_EQ(reread[kv.first][k], kv.second[k]);
+    delete_file(dump_file);
+    delete_file(std::string(dump_file) + ".index");
+}
+
+TEST_F(DumpIndexedTest, indexed_header_no)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("dump id all indexed 1 dump_indexed_header.melt id type x y z");
+    command("dump_modify id header no");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Dump indexed requires dump_modify header yes.*", command("run 0"););
+    BEGIN_HIDE_OUTPUT();
+    command("undump id");
+    END_HIDE_OUTPUT();
+    delete_file("dump_indexed_header.melt");
+    delete_file("dump_indexed_header.melt.index");
+}
+
+TEST_F(DumpIndexedTest, mmap_read_dump)
+{
+    // binary native, indexed, and lossless lossy files read through a mapping
+    // must give the same atoms as the regular proc 0 reader
+
+    const std::vector<std::pair<std::string, std::string>> styles = {
+        {"custom", "native"}, {"indexed", "indexed"}, {"lossy", "lossy"}};
+    for (const auto &style : styles) {
+        auto dump_file = fmt::format("dump_mmap_read_dump_{}.bin", style.first);
+        BEGIN_HIDE_OUTPUT();
+        command(fmt::format("dump id all {} 1 {} id type x y z vx vy vz", style.first, dump_file));
+        command("run 0 post no");
+        command("undump id");
+        END_HIDE_OUTPUT();
+        auto data = snapshot();
+
+        std::map<tagint, std::vector<double>> reread[2];
+        for (int mmap = 0; mmap < 2; mmap++) {
+            BEGIN_HIDE_OUTPUT();
+            command("displace_atoms all random 0.5 0.5 0.5 4927 units box");
+            command("velocity all create 1.0 3571");
+            command(fmt::format("read_dump {} 0 x y z vx vy vz box no mmap {} format {}",
+                                dump_file, mmap ? "yes" : "no", style.second));
+            END_HIDE_OUTPUT();
+            reread[mmap] = snapshot();
+        }
+
+        ASSERT_EQ(reread[0].size(), data.size());
+        ASSERT_EQ(reread[1].size(), data.size());
+        for (const auto &kv : data)
+            for (int k = 0; k < 6; k++) {
+                EXPECT_DOUBLE_EQ(reread[0][kv.first][k], kv.second[k]);
+                EXPECT_EQ(reread[1][kv.first][k], reread[0][kv.first][k]);
+            }
+        delete_file(dump_file);
+        delete_file(dump_file + ".index");
+    }
+}
+
+TEST_F(DumpIndexedTest, mmap_rerun)
+{
+    // rerun a trajectory with and without mmap, skipping snapshots so
+    // that the mapped reader has to seek forward through the file
+
+    const std::vector<std::pair<std::string, std::string>> styles = {{"custom", "native"},
+                                                                     {"indexed", "indexed"}};
+    for (const auto &style : styles) {
+        auto dump_file = fmt::format("dump_mmap_rerun_{}.bin", style.first);
+        BEGIN_HIDE_OUTPUT();
+        command("reset_timestep 0");
+        command("fix nve all nve");
+        command(fmt::format("dump id all {} 2 {} id type x y z vx vy vz", style.first, dump_file));
+        command("run 10 post no");
+        command("undump id");
+        command("unfix nve");
+        END_HIDE_OUTPUT();
+        auto data = snapshot();
+
+        std::map<tagint, std::vector<double>> reread[2];
+        std::map<tagint, std::vector<double>> forces[2];
+        for (int mmap = 0; mmap < 2; mmap++) {
+            BEGIN_HIDE_OUTPUT();
+            command("displace_atoms all random 0.5 0.5 0.5 4927 units box");
+            command("velocity all create 1.0 3571");
+            command(fmt::format("rerun {} every 4 dump x y z vx vy vz box no mmap {} format {}",
+                                dump_file, mmap ? "yes" : "no", style.second));
+            END_HIDE_OUTPUT();
+            ASSERT_EQ(lmp->update->ntimestep, 8);
+            reread[mmap] = snapshot();
+            auto atom    = lmp->atom;
+            for (int i = 0; i < atom->nlocal; i++)
+                forces[mmap][atom->tag[i]] = {atom->f[i][0], atom->f[i][1], atom->f[i][2]};
+        }
+
+        ASSERT_EQ(reread[1].size(), reread[0].size());
+        bool moved = false;
+        for (const auto &kv : reread[0]) {
+            ASSERT_EQ(reread[1].count(kv.first), 1);
+            for (int k = 0; k < 6; k++) {
+                EXPECT_EQ(reread[1][kv.first][k], kv.second[k]);
+                if ((data.count(kv.first) == 0) || (data[kv.first][k] != kv.second[k]))
+                    moved = true;
+            }
+            // atoms may be stored in a different order, which changes the summation order
+            for (int k = 0; k < 3; k++)
+                EXPECT_NEAR(forces[1][kv.first][k], forces[0][kv.first][k],
+                            1.0e-10 * (1.0 + fabs(forces[0][kv.first][k])));
+        }
+        // the last snapshot read is step 8, not the final step 10
+        if (lmp->atom->nlocal > 0) ASSERT_TRUE(moved);
+        delete_file(dump_file);
+        delete_file(dump_file + ".index");
+    }
+}
+
+TEST_F(DumpIndexedTest, mmap_after_format)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("dump id all indexed 1 dump_mmap_after_format.bin id type x y z");
+    command("run 0 post no");
+    command("undump id");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Read_dump mmap keyword must be used before format keyword.*",
+                 command("read_dump dump_mmap_after_format.bin 0 x y z format indexed mmap yes"););
+    delete_file("dump_mmap_after_format.bin");
+    delete_file("dump_mmap_after_format.bin.index");
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -19,6 +19,7 @@
 #include "info.h"
 #include "input.h"
 #include "lammps.h"
+#include "lmprestart.h"
 #include "update.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -26,6 +27,7 @@
 #include <cstdio>
 #include <mpi.h>
 #include <string>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
@@ -390,6 +392,154 @@ TEST_F(FileOperationsTest, write_restart)
     delete_file("triclinic.restart");
 }
 
+TEST_F(FileOperationsTest, restart_delta)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("atom_modify map array");
+    command("lattice fcc 0.8442");
+    command("region box block 0 3 0 3 0 3");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("velocity all create 3.0 87287");
+    command("pair_style lj/cut 2.5");
+    command("pair_coeff 1 1 1.0 1.0");
+    command("fix 1 all nve");
+    END_HIDE_OUTPUT();
+
+    TEST_FAILURE(".*ERROR: Restart delta requires a file name with the '\\*' wildcard.*",
+                 command("restart 1 delta.restart delta 2"););
+    TEST_FAILURE(".*ERROR: Restart delta cannot be used with two restart file names.*",
+                 command("restart 1 delta.a delta.b delta 2"););
+    TEST_FAILURE(".*ERROR: Restart delta cannot be used with two restart file names.*",
+                 command("restart 1 delta.restart.* delta 2"););
+
+    // steps 1 and 3 are base files, 2 and 4 are delta files
+
+    BEGIN_HIDE_OUTPUT();
+    command("restart 0");
+    command("restart 1 delta.restart.* delta 2");
+    command("run 4 post no");
+    command("restart 0");
+    END_HIDE_OUTPUT();
+    ASSERT_FILE_EXISTS("delta.restart.3");
+    ASSERT_FILE_EXISTS("delta.restart.4");
+    auto file_size = [](const char *name) {
+        FILE *fp = fopen(name, "rb");
+        fseek(fp, 0, SEEK_END);
+        long size = ftell(fp);
+        fclose(fp);
+        return size;
+    };
+    ASSERT_LT(file_size("delta.restart.4"), file_size("delta.restart.3"));
+
+    auto atom        = lmp->atom;
+    const int natoms = atom->natoms;
+    std::vector<double> x(3 * natoms), v(3 * natoms);
+    for (int i = 0; i < atom->nlocal; i++) {
+        for (int k = 0; k < 3; k++) {
+            x[3 * (atom->tag[i] - 1) + k] = atom->x[i][k];
+            v[3 * (atom->tag[i] - 1) + k] = atom->v[i][k];
+        }
+    }
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart delta.restart.4");
+    END_HIDE_OUTPUT();
+    atom = lmp->atom;
+    ASSERT_EQ(atom->natoms, natoms);
+    ASSERT_EQ(lmp->update->ntimestep, 4);
+    for (int i = 0; i < atom->nlocal; i++) {
+        for (int k = 0; k < 3; k++) {
+            EXPECT_EQ(atom->x[i][k], x[3 * (atom->tag[i] - 1) + k]);
+            EXPECT_EQ(atom->v[i][k], v[3 * (atom->tag[i] - 1) + k]);
+        }
+    }
+
+    // clean up
+    for (int i = 1; i <= 4; ++i)
+        delete_file(fmt::format("delta.restart.{}", i));
+}
+
+TEST_F(FileOperationsTest, restart_mpiio)
+{
+#if defined(MPI_STUBS)
+    GTEST_SKIP();
+#endif
+    BEGIN_HIDE_OUTPUT();
+    command("atom_modify map array");
+    command("lattice fcc 0.8442");
+    command("region box block 0 3 0 3 0 3");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("velocity all create 3.0 87287");
+    command("pair_style lj/cut 2.5");
+    command("pair_coeff 1 1 1.0 1.0");
+    command("fix 1 all nve");
+    END_HIDE_OUTPUT();
+
+    TEST_FAILURE(".*ERROR: Write_restart aggregators and async require mpiio yes.*",
+                 command("write_restart mpiio.restart async yes"););
+    TEST_FAILURE(".*ERROR: Invalid write_restart aggregators value 0.*",
+                 command("write_restart mpiio.restart mpiio yes aggregators 0"););
+
+    auto snapshot = [this]() {
+        auto atom = lmp->atom;
+        std::vector<double> data(6 * atom->natoms);
+        for (int i = 0; i < atom->nlocal; i++) {
+            for (int k = 0; k < 3; k++) {
+                data[6 * (atom->tag[i] - 1) + k]     = atom->x[i][k];
+                data[6 * (atom->tag[i] - 1) + k + 3] = atom->v[i][k];
+            }
+        }
+        return data;
+    };
+
+    // the file of the last asynchronous write is complete when the run returns
+
+    BEGIN_HIDE_OUTPUT();
+    command("write_restart mpiio.restart.0 mpiio yes aggregators 1");
+    command("restart 2 mpiio.restart.* mpiio yes async yes");
+    command("run 4 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_FILE_EXISTS("mpiio.restart.4");
+    auto last = snapshot();
+
+    const std::string magic = MAGIC_STRING;
+    std::vector<char> tail(magic.size() + 1);
+    FILE *fp = fopen("mpiio.restart.4", "rb");
+    ASSERT_NE(fp, nullptr);
+    fseek(fp, -(long) tail.size(), SEEK_END);
+    ASSERT_EQ(fread(tail.data(), 1, tail.size(), fp), tail.size());
+    fclose(fp);
+    ASSERT_THAT(std::string(tail.data()), StrEq(magic));
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart mpiio.restart.4");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->update->ntimestep, 4);
+    ASSERT_EQ(lmp->atom->natoms, 108);
+    auto data = snapshot();
+    for (std::size_t i = 0; i < data.size(); i++)
+        EXPECT_EQ(data[i], last[i]);
+
+    // the synchronous file from before the run restores the initial state
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart mpiio.restart.0");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->update->ntimestep, 0);
+    ASSERT_EQ(lmp->atom->natoms, 108);
+
+    // clean up
+    for (int i = 0; i <= 4; i += 2)
+        delete_file(fmt::format("mpiio.restart.{}", i));
+}
+
 TEST_F(FileOperationsTest, write_data)
 {
     BEGIN_HIDE_OUTPUT();
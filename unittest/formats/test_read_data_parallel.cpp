@@ -0,0 +1,115 @@
+// unit tests for comparing read_data with and without parallel reading of the Atoms section
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "input.h"
+#include "lammps.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class ReadDataParallelTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // read data file and return type, image flags, and coords of all atoms ordered by ID
+
+    std::vector<double> read_system(const std::string &file, const std::string &options)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        command("atom_modify map array");
+        command("read_data " + file + " " + options);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        auto atom  = lmp->atom;
+        int natoms = (int) atom->natoms;
+        std::vector<double> mine(7 * natoms, 0.0), all(7 * natoms, 0.0);
+        for (int i = 0; i < atom->nlocal; i++) {
+            double *one = &mine[7 * (atom->tag[i] - 1)];
+            imageint image = atom->image[i];
+            one[0] = atom->type[i];
+            one[1] = (image & IMGMASK) - IMGMAX;
+            one[2] = (image >> IMGBITS & IMGMASK) - IMGMAX;
+            one[3] = (image >> IMG2BITS) - IMGMAX;
+            one[4] = atom->x[i][0];
+            one[5] = atom->x[i][1];
+            one[6] = atom->x[i][2];
+        }
+        MPI_Allreduce(mine.data(), all.data(), 7 * natoms, MPI_DOUBLE, MPI_SUM, lmp->world);
+
+        bigint nlocal = atom->nlocal, ntotal;
+        MPI_Allreduce(&nlocal, &ntotal, 1, MPI_LMP_BIGINT, MPI_SUM, lmp->world);
+        EXPECT_EQ(ntotal, atom->natoms);
+        return all;
+    }
+};
+
+TEST_F(ReadDataParallelTest, atoms)
+{
+    // Atoms section of ~10 MB: one round of the default 4 MiB blocks on 4 procs
+    // and many rounds of small blocks, whose boundaries fall inside lines
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("lattice fcc 0.8442");
+    command("region box block 0 32 0 32 0 32");
+    command("create_box 2 box");
+    command("create_atoms 1 box");
+    command("mass * 1.0");
+    command("set type 1 type/fraction 2 0.3 3829");
+    command("displace_atoms all random 0.2 0.2 0.2 2381");
+    command("velocity all create 1.0 4928");
+    command("run 0 post no");
+    command("displace_atoms all move 10.5 -7.3 3.1");
+    command("write_data read_data_parallel.data nocoeff");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    auto serial   = read_system("read_data_parallel.data", "");
+    auto parallel = read_system("read_data_parallel.data", "parallel yes");
+    ASSERT_EQ(lmp->atom->natoms, 131072);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (std::size_t i = 0; i < serial.size(); i++)
+        ASSERT_DOUBLE_EQ(serial[i], parallel[i]);
+
+    auto rounds = read_system("read_data_parallel.data", "parallel yes parallel/block 65537");
+    ASSERT_EQ(lmp->atom->natoms, 131072);
+    ASSERT_EQ(serial.size(), rounds.size());
+    for (std::size_t i = 0; i < serial.size(); i++)
+        ASSERT_DOUBLE_EQ(serial[i], rounds[i]);
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("clear");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    if (lmp->comm->me == 0) remove("read_data_parallel.data");
+}
+} // namespace LAMMPS_NS
@@ -0,0 +1,74 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/ Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+#ifndef TEST_SYSTEM_CHARGED__H
+#define TEST_SYSTEM_CHARGED__H
+
+#include "atom.h"
+#include "input.h"
+#include "lammps.h"
+
+#include "fmt/format.h"
+
+#include <string>
+#include <vector>
+
+namespace TestSystems {
+
+// salt-like mix of charges +q and -q on the atoms of a box with 2 atom types,
+// displaced randomly from their lattice sites
+
+inline void assign_charges(LAMMPS_NS::LAMMPS *lmp, double charge, double displace)
+{
+    auto input = lmp->input;
+    input->one("mass * 1.0");
+    input->one("set type 1 type/ratio 2 0.5 4817");
+    input->one(fmt::format("set type 1 charge {}", charge));
+    input->one(fmt::format("set type 2 charge {}", -charge));
+    input->one(fmt::format("displace_atoms all random {0} {0} {0} 2745", displace));
+    input->one("velocity all create 1.0 7142");
+}
+
+// salt-like system of unit charges on a simple cubic lattice in a region,
+// with a charged LJ pair style and PPPM of the given accuracy
+
+inline void charged_system(LAMMPS_NS::LAMMPS *lmp, const std::string &region, double accuracy)
+{
+    auto input = lmp->input;
+    input->one("atom_style charge");
+    input->one("atom_modify map array");
+    input->one("lattice sc 1.0");
+    input->one("region box " + region);
+    input->one("create_box 2 box");
+    input->one("create_atoms 1 box");
+    assign_charges(lmp, 1.0, 0.1);
+    input->one("pair_style lj/cut/coul/long 2.5");
+    input->one("pair_coeff * * 1.0 1.0");
+    input->one(fmt::format("kspace_style pppm {}", accuracy));
+}
+
+// per-atom array with ncol columns of the atoms of all procs, ordered by ID
+
+inline std::vector<double> by_id(LAMMPS_NS::LAMMPS *lmp, double **array, int ncol = 3)
+{
+    auto atom  = lmp->atom;
+    int natoms = (int) atom->natoms;
+    std::vector<double> mine(ncol * natoms, 0.0), all(ncol * natoms, 0.0);
+    for (int i = 0; i < atom->nlocal; i++)
+        for (int k = 0; k < ncol; k++)
+            mine[ncol * (atom->tag[i] - 1) + k] = array[i][k];
+    MPI_Allreduce(mine.data(), all.data(), ncol * natoms, MPI_DOUBLE, MPI_SUM, lmp->world);
+    return all;
+}
+} // namespace TestSystems
+
+#endif